@@ -3,6 +3,7 @@
 #include <v8.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <future>
@@ -258,7 +259,7 @@ class ConfigManager {
 public:
     static void initialize(v8::Isolate* isolate);
     static void loadConfig(const std::string& filename);
-    static v8::Local<v8::Value> get(v8::Isolate* isolate, const std::string& key);
+    static v8::Local<v8::Value> get(v8::Isolate* isolate, std::string_view key);
     static void set(const std::string& key, v8::Local<v8::Value> value);
     static void save(const std::string& filename);
     static void watch(const std::string& key, std::function<void(v8::Local<v8::Value>)> callback);
@@ -267,7 +268,7 @@ private:
     static void getCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void setCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void watchCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
-    static std::map<std::string, v8::Global<v8::Value>> config_;
+    static std::map<std::string, v8::Global<v8::Value>, std::less<>> config_;
     static std::map<std::string, std::vector<std::function<void(v8::Local<v8::Value>)>>> watchers_;
 };
 
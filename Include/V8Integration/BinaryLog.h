@@ -0,0 +1,202 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <variant>
+#include <chrono>
+#include <mutex>
+#include <fstream>
+#include <istream>
+#include <format>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace v8_integration {
+
+// Compact binary log format. A file is a header followed by entries:
+//   'F' id, format string                       - format definition
+//   'L' id, line, file, function                - source location definition
+//   'R' timestamp, level, format id, location id, args - log record
+// Definitions are written the first time an id appears in each file, so
+// every rotated file can be decoded on its own. Integers are host order.
+namespace binlog {
+    constexpr char kMagic[6] = {'V', '8', 'B', 'L', 'O', 'G'};
+    constexpr uint16_t kVersion = 1;
+    constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    enum class EntryType : uint8_t {
+        Format = 'F',
+        Location = 'L',
+        Record = 'R'
+    };
+
+    enum class ArgType : uint8_t {
+        Int = 1,
+        UInt = 2,
+        Double = 3,
+        Bool = 4,
+        String = 5
+    };
+
+    template <typename T>
+    void appendRaw(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    inline void appendString(std::string& out, std::string_view value) {
+        appendRaw<uint32_t>(out, static_cast<uint32_t>(value.size()));
+        out.append(value.data(), value.size());
+    }
+
+    // Arguments are stored raw; types without a native encoding are
+    // rendered with std::format at the call site
+    template <typename T>
+    void encodeArg(std::string& out, const T& value) {
+        using V = std::decay_t<T>;
+        if constexpr (std::is_same_v<V, bool>) {
+            out.push_back(static_cast<char>(ArgType::Bool));
+            out.push_back(value ? 1 : 0);
+        } else if constexpr (std::is_same_v<V, char>) {
+            out.push_back(static_cast<char>(ArgType::String));
+            appendString(out, std::string_view(&value, 1));
+        } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+            out.push_back(static_cast<char>(ArgType::Int));
+            appendRaw<int64_t>(out, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<V>) {
+            out.push_back(static_cast<char>(ArgType::UInt));
+            appendRaw<uint64_t>(out, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<V>) {
+            out.push_back(static_cast<char>(ArgType::Double));
+            appendRaw<double>(out, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            out.push_back(static_cast<char>(ArgType::String));
+            appendString(out, std::string_view(value));
+        } else {
+            out.push_back(static_cast<char>(ArgType::String));
+            appendString(out, std::format("{}", value));
+        }
+    }
+}
+
+class BinaryLogWriter {
+public:
+    struct Config {
+        std::string path;
+        size_t max_file_size = 64 * 1024 * 1024;  // rotate once a file exceeds this
+        size_t max_files = 5;                     // path, path.1 ... path.(max_files - 1)
+    };
+
+    explicit BinaryLogWriter(const Config& config);
+    ~BinaryLogWriter();
+
+    bool isOpen() const;
+    void flush();
+
+    // `literal` means format/file/function point at string literals, which
+    // lets interning key on the pointer instead of hashing the contents
+    template <typename... Args>
+    void write(uint8_t level, std::string_view format, std::string_view file, int line,
+               std::string_view function, bool literal, const Args&... args) {
+        std::string& payload = argBuffer();
+        payload.clear();
+        (binlog::encodeArg(payload, args), ...);
+        writeRecord(level, format, file, line, function, literal,
+                    static_cast<uint8_t>(sizeof...(Args)), payload);
+    }
+
+private:
+    struct LocationKey {
+        const char* file;
+        int line;
+        bool operator==(const LocationKey& other) const {
+            return file == other.file && line == other.line;
+        }
+    };
+
+    struct LocationKeyHash {
+        size_t operator()(const LocationKey& key) const {
+            return std::hash<const void*>()(key.file) ^ (static_cast<size_t>(key.line) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    struct Location {
+        std::string file;
+        int line;
+        std::string function;
+    };
+
+    static std::string& argBuffer();
+
+    void writeRecord(uint8_t level, std::string_view format, std::string_view file, int line,
+                     std::string_view function, bool literal, uint8_t arg_count,
+                     const std::string& payload);
+    uint32_t internFormat(std::string_view format, bool literal);
+    uint32_t internLocation(std::string_view file, int line, std::string_view function, bool literal);
+    void openFile();
+    void rotate();
+
+    Config config_;
+    std::mutex mutex_;
+    std::ofstream stream_;
+    size_t file_size_ = 0;
+    std::string entry_;
+
+    std::deque<std::string> formats_;
+    std::unordered_map<std::string_view, uint32_t> format_ids_;
+    std::unordered_map<const char*, uint32_t> literal_format_ids_;
+    std::vector<bool> format_emitted_;
+
+    std::deque<Location> locations_;
+    std::unordered_map<std::string, uint32_t> location_ids_;
+    std::unordered_map<LocationKey, uint32_t, LocationKeyHash> literal_location_ids_;
+    std::vector<bool> location_emitted_;
+};
+
+class BinaryLogReader {
+public:
+    using Value = std::variant<int64_t, uint64_t, double, bool, std::string>;
+
+    struct Record {
+        std::chrono::system_clock::time_point timestamp;
+        uint8_t level = 0;
+        std::string format;
+        std::string file;
+        int line = 0;
+        std::string function;
+        std::vector<Value> args;
+    };
+
+    explicit BinaryLogReader(std::istream& input);
+
+    // False at end of input or on a malformed entry; error() tells which
+    bool next(Record& record);
+    const std::string& error() const { return error_; }
+
+    // Substitutes args into a std::format-style string, honouring per-field specs
+    static std::string render(const std::string& format, const std::vector<Value>& args);
+    static std::string valueToString(const Value& value);
+    static const char* levelName(uint8_t level);
+
+private:
+    template <typename T>
+    bool readRaw(T& value) {
+        return static_cast<bool>(input_.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+    bool readString(std::string& value);
+    bool readHeader();
+    bool fail(const std::string& message);
+
+    std::istream& input_;
+    bool header_read_ = false;
+    std::string error_;
+    std::unordered_map<uint32_t, std::string> formats_;
+    std::unordered_map<uint32_t, std::tuple<std::string, int, std::string>> locations_;
+};
+
+} // namespace v8_integration
@@ -8,7 +8,22 @@
 #include <mutex>
 #include <fstream>
 #include <map>
+#include <atomic>
+#include <format>
+#include <iterator>
+#include <string_view>
 #include <v8.h>
+#include "V8Integration/BinaryLog.h"
+
+// Compile-time floor for the V8_LOG_* macros (0 = TRACE ... 5 = FATAL).
+// Statements below it are removed entirely; release builds drop TRACE/DEBUG.
+#ifndef V8_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define V8_LOG_MIN_LEVEL 2
+#else
+#define V8_LOG_MIN_LEVEL 0
+#endif
+#endif
 
 namespace v8_integration {
 
@@ -33,6 +48,7 @@ enum class ErrorCode {
     MEMORY_ERROR = 2000,
     SECURITY_ERROR = 3000,
     TIMEOUT_ERROR = 4000,
+    CPU_QUOTA_EXCEEDED = 4001,
     FATAL_ERROR = 5000,
     UNKNOWN_ERROR = 9999
 };
@@ -52,9 +68,63 @@ struct ErrorInfo {
 
 class Logger {
 public:
+    // What a producer does when the async ring buffer is full
+    enum class OverflowPolicy {
+        BLOCK,  // wait for the writer thread to make room
+        DROP,   // discard the record silently
+        COUNT   // discard the record and have the writer report how many were lost
+    };
+    
+    struct AsyncConfig {
+        size_t buffer_capacity = 8192;  // records, rounded up to a power of two
+        size_t batch_size = 256;        // records written per batch
+        std::chrono::milliseconds flush_interval{100};
+        OverflowPolicy overflow_policy = OverflowPolicy::BLOCK;
+    };
+    
     static Logger& getInstance();
+    ~Logger();
+    
+    // Async mode formats on the calling thread and hands records to a
+    // background writer; handlers are invoked from the writer thread.
+    // FATAL messages and disableAsyncLogging() flush synchronously.
+    void enableAsyncLogging();
+    void enableAsyncLogging(const AsyncConfig& config);
+    void disableAsyncLogging();
+    bool isAsyncLogging() const;
+    void flush();
+    uint64_t getDroppedCount() const;
+    
+    // Binary mode sends records to a BinaryLogWriter instead of the text
+    // outputs: logf() arguments are stored raw and never formatted here.
+    // Decode the files with v8logdecode.
+    bool enableBinaryLogging(const BinaryLogWriter::Config& config);
+    void disableBinaryLogging();
+    bool isBinaryLogging() const;
     
     void setLevel(LogLevel level);
+    
+    // Runtime level check: a single relaxed atomic load, no locking
+    static bool isEnabled(LogLevel level) {
+        return level >= current_level_.load(std::memory_order_relaxed);
+    }
+    
+    // Format-string logging. The level is checked before anything is
+    // formatted, and formatting reuses a per-thread buffer.
+    template <typename... Args>
+    void logf(LogLevel level, const char* file, int line, const char* function,
+              std::format_string<Args...> fmt, Args&&... args) {
+        if (!isEnabled(level)) return;
+        if (binary_writer_.load(std::memory_order_relaxed) &&
+            writeBinary(level, fmt.get(), file, line, function, args...)) {
+            return;
+        }
+        std::string& buffer = formatBuffer();
+        buffer.clear();
+        std::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+        write(level, buffer, file, line, function);
+    }
+    
     void addHandler(std::function<void(LogLevel, const std::string&)> handler);
     void enableFileLogging(const std::string& filename);
     void enableConsoleLogging(bool enable = true);
@@ -78,15 +148,50 @@ public:
 
 private:
     Logger() = default;
-    LogLevel current_level_ = LogLevel::INFO;
+    class AsyncWriter;
+    
+    static inline std::atomic<LogLevel> current_level_{LogLevel::INFO};
     std::vector<std::function<void(LogLevel, const std::string&)>> handlers_;
     std::mutex mutex_;
     std::unique_ptr<std::ofstream> file_stream_;
     bool console_logging_ = true;
     
-    std::string formatMessage(LogLevel level, const std::string& message,
-                             const std::string& file, int line,
-                             const std::string& function);
+    // Producers use async_writer_ and binary_writer_ without locking;
+    // sink_users_ lets the disable calls wait for in-flight producers
+    // before destroying a sink
+    std::unique_ptr<AsyncWriter> async_owner_;
+    std::atomic<AsyncWriter*> async_writer_{nullptr};
+    std::unique_ptr<BinaryLogWriter> binary_owner_;
+    std::atomic<BinaryLogWriter*> binary_writer_{nullptr};
+    std::atomic<int> sink_users_{0};
+    std::atomic<uint64_t> dropped_count_{0};
+    std::mutex async_mutex_;
+    
+    template <typename... Args>
+    bool writeBinary(LogLevel level, std::string_view format, const char* file, int line,
+                     const char* function, const Args&... args) {
+        sink_users_.fetch_add(1);
+        BinaryLogWriter* writer = binary_writer_.load();
+        if (writer) {
+            writer->write(static_cast<uint8_t>(level), format, file, line, function, true, args...);
+            if (level == LogLevel::FATAL) {
+                writer->flush();
+            }
+        }
+        sink_users_.fetch_sub(1);
+        return writer != nullptr;
+    }
+    void waitForSinkUsers();
+    
+    void writeRecords(const std::vector<std::pair<LogLevel, std::string>>& records, bool flush_streams);
+    
+    void write(LogLevel level, std::string_view message, std::string_view file,
+               int line, std::string_view function);
+    static std::string& formatBuffer();
+    
+    std::string formatMessage(LogLevel level, std::string_view message,
+                             std::string_view file, int line,
+                             std::string_view function);
     std::string levelToString(LogLevel level);
 };
 
@@ -149,13 +254,42 @@ private:
 
 } // namespace v8_integration
 
-// Convenience macros
-#define V8_LOG_TRACE(msg) v8_integration::Logger::getInstance().trace(msg, __FILE__, __LINE__, __FUNCTION__)
-#define V8_LOG_DEBUG(msg) v8_integration::Logger::getInstance().debug(msg, __FILE__, __LINE__, __FUNCTION__)
-#define V8_LOG_INFO(msg) v8_integration::Logger::getInstance().info(msg, __FILE__, __LINE__, __FUNCTION__)
-#define V8_LOG_WARN(msg) v8_integration::Logger::getInstance().warn(msg, __FILE__, __LINE__, __FUNCTION__)
-#define V8_LOG_ERROR(msg) v8_integration::Logger::getInstance().error(msg, __FILE__, __LINE__, __FUNCTION__)
-#define V8_LOG_FATAL(msg) v8_integration::Logger::getInstance().fatal(msg, __FILE__, __LINE__, __FUNCTION__)
+// Convenience macros. The level is checked before the message expression is
+// evaluated, so a disabled statement costs one branch; levels below
+// V8_LOG_MIN_LEVEL compile away.
+#define V8_LOG_IS_ENABLED(level) \
+    (static_cast<int>(v8_integration::LogLevel::level) >= V8_LOG_MIN_LEVEL && \
+     v8_integration::Logger::isEnabled(v8_integration::LogLevel::level))
+
+#define V8_LOG_AT(level, method, msg) \
+    do { \
+        if (V8_LOG_IS_ENABLED(level)) { \
+            v8_integration::Logger::getInstance().method(msg, __FILE__, __LINE__, __FUNCTION__); \
+        } \
+    } while (0)
+
+#define V8_LOG_TRACE(msg) V8_LOG_AT(TRACE, trace, msg)
+#define V8_LOG_DEBUG(msg) V8_LOG_AT(DEBUG, debug, msg)
+#define V8_LOG_INFO(msg) V8_LOG_AT(INFO, info, msg)
+#define V8_LOG_WARN(msg) V8_LOG_AT(WARN, warn, msg)
+#define V8_LOG_ERROR(msg) V8_LOG_AT(ERROR, error, msg)
+#define V8_LOG_FATAL(msg) V8_LOG_AT(FATAL, fatal, msg)
+
+// Format-string variants: V8_LOGF_INFO("loaded {} in {}ms", name, ms)
+#define V8_LOGF(level, fmt, ...) \
+    do { \
+        if (V8_LOG_IS_ENABLED(level)) { \
+            v8_integration::Logger::getInstance().logf(v8_integration::LogLevel::level, \
+                __FILE__, __LINE__, __FUNCTION__, fmt __VA_OPT__(,) __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define V8_LOGF_TRACE(fmt, ...) V8_LOGF(TRACE, fmt __VA_OPT__(,) __VA_ARGS__)
+#define V8_LOGF_DEBUG(fmt, ...) V8_LOGF(DEBUG, fmt __VA_OPT__(,) __VA_ARGS__)
+#define V8_LOGF_INFO(fmt, ...) V8_LOGF(INFO, fmt __VA_OPT__(,) __VA_ARGS__)
+#define V8_LOGF_WARN(fmt, ...) V8_LOGF(WARN, fmt __VA_OPT__(,) __VA_ARGS__)
+#define V8_LOGF_ERROR(fmt, ...) V8_LOGF(ERROR, fmt __VA_OPT__(,) __VA_ARGS__)
+#define V8_LOGF_FATAL(fmt, ...) V8_LOGF(FATAL, fmt __VA_OPT__(,) __VA_ARGS__)
 
 #define V8_PERF_START(op) v8_integration::PerformanceMonitor::startTiming(op)
 #define V8_PERF_END(op) v8_integration::PerformanceMonitor::endTiming(op)
@@ -117,9 +117,36 @@ public:
         std::map<std::string, std::string> tags;
         std::vector<std::string> logs;
     };
-    
+
+    // Head sampling is decided once in startTrace. Traces that lose the head
+    // draw are still buffered when tail sampling is enabled and are kept on
+    // finishTrace only if they were slow or recorded an error.
+    struct SamplingConfig {
+        double head_sample_rate = 1.0;                   // 0.0 - 1.0
+        std::chrono::milliseconds latency_threshold{0};  // 0 = tail latency sampling off
+        bool keep_error_traces = true;                   // keep traces tagged "error"
+        std::chrono::seconds retention{300};             // 0 = never evict
+    };
+
+    struct SamplingStats {
+        uint64_t started = 0;
+        uint64_t head_sampled = 0;
+        uint64_t tail_kept = 0;
+        uint64_t dropped = 0;
+        uint64_t evicted = 0;
+    };
+
     static TracingManager& getInstance();
-    
+
+    void setSamplingConfig(const SamplingConfig& config);
+    SamplingConfig getSamplingConfig() const;
+    SamplingStats getSamplingStats() const;
+
+    // Drops traces whose retention window has passed; also runs lazily from startTrace
+    size_t evictExpiredTraces();
+    size_t getTraceCount() const;
+    void clearTraces();
+
     std::string startTrace(const std::string& operation_name,
                           const std::string& parent_trace_id = "");
     void finishTrace(const std::string& trace_id);
@@ -139,10 +166,30 @@ public:
     
 private:
     TracingManager() = default;
+
+    struct TraceRecord {
+        std::vector<Span> spans;
+        bool head_sampled = false;
+        bool has_error = false;
+        bool finished = false;
+        bool expiry_scheduled = false;
+        std::multimap<std::chrono::steady_clock::time_point, std::string>::iterator expiry;
+    };
+
     mutable std::mutex spans_mutex_;
-    std::map<std::string, std::vector<Span>> traces_;
-    
+    std::map<std::string, TraceRecord> traces_;
+    std::multimap<std::chrono::steady_clock::time_point, std::string> expiry_index_;
+    std::chrono::steady_clock::time_point last_eviction_{};
+    SamplingConfig sampling_config_;
+    SamplingStats sampling_stats_;
+
     std::string generateId();
+    bool shouldHeadSample();
+    bool tailSamplingEnabled() const;
+    void scheduleExpiry(TraceRecord& record, const std::string& trace_id,
+                        std::chrono::steady_clock::time_point now);
+    size_t evictExpiredLocked(std::chrono::steady_clock::time_point now);
+    Span* findSpan(const std::string& trace_id, const std::string& span_id);
 };
 
 // Performance profiler
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <set>
+#include <functional>
+
+namespace v8_integration {
+
+// Structural metrics gathered by a single tokenizer pass over JavaScript
+// source. Strings, template literals, regular expressions and comments are
+// skipped properly, so brackets or keywords inside them are not counted.
+struct ScriptMetrics {
+    struct Reference {
+        std::string name;
+        int line;
+    };
+
+    size_t token_count = 0;
+    size_t max_nesting_depth = 0;   // deepest (), [] and {} combined
+    size_t loop_count = 0;          // for, while, do ... while
+    size_t function_count = 0;      // function keywords and arrow functions
+    std::vector<Reference> banned_references;
+
+    // First lexical error (unterminated literal, unbalanced bracket);
+    // analysis stops there
+    std::string syntax_error;
+    int syntax_error_line = 0;
+};
+
+class ScriptAnalyzer {
+public:
+    using IdentifierSet = std::set<std::string, std::less<>>;
+
+    // Banned names are matched where they reference a binding: free
+    // identifiers (`eval(x)`), properties of the global object
+    // (`globalThis.eval(x)`) and `arguments.callee`. Other property names
+    // (`job.process()`) and object literal keys (`{ exports: 1 }`) are not
+    // references.
+    static ScriptMetrics analyze(std::string_view code, const IdentifierSet& banned_identifiers = {});
+};
+
+} // namespace v8_integration
@@ -14,6 +14,16 @@
 #include <random>
 #include <regex>
 #include <iomanip>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <future>
+#include <cstdint>
+#include <unordered_map>
+#include "V8Integration/ScriptAnalyzer.h"
+#include "V8Integration/ErrorHandler.h"
+#include <array>
+#include <string_view>
 
 namespace v8_integration {
 
@@ -22,12 +32,89 @@ struct SandboxConfig {
     bool remove_dangerous_globals = true;
     bool disable_code_generation = true;
     bool disable_wasm = true;
-    size_t memory_limit = 0; // 0 = no limit
+    size_t memory_limit = 0; // 0 = no limit; heap limits are per isolate, see ResourceLimiter::createIsolate
     std::chrono::milliseconds execution_timeout{0}; // 0 = no timeout
+    double cpu_weight = 1.0; // share of CPU relative to other sandboxes
+    std::chrono::microseconds cpu_quota{0}; // CPU time per cpu_window; 0 = no quota
+    std::chrono::milliseconds cpu_window{1000};
     std::map<std::string, std::string> allowed_globals;
     std::set<std::string> allowed_modules;
 };
 
+// Per-tenant CPU accounting and weighted fair queueing. CPU time is
+// measured with the calling thread's CPU clock and kept in a bucketed
+// sliding window for quotas. runPending() always runs the queued task of
+// the tenant with the lowest virtual time (CPU used / weight) and skips
+// tenants whose window usage is over quota.
+class SandboxScheduler {
+public:
+    using Task = std::function<void()>;
+    
+    struct TenantConfig {
+        double weight = 1.0;
+        std::chrono::nanoseconds quota{0}; // per window; 0 = no quota
+        std::chrono::milliseconds window{1000};
+    };
+    
+    struct Usage {
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds window{0};
+        uint64_t executions = 0;
+        uint64_t throttled = 0;
+        size_t queued = 0;
+    };
+    
+    static constexpr size_t kWindowBuckets = 10;
+    
+    static std::chrono::nanoseconds threadCpuTime();
+    
+    void configure(const std::string& tenant, const TenantConfig& config);
+    void remove(const std::string& tenant);
+    
+    // Tenants exist only through configure(); charges to unknown names are
+    // dropped and tasks for them are refused (enqueue returns false)
+    void charge(const std::string& tenant, std::chrono::nanoseconds cpu_time);
+    // Over quota for the current window; counts a throttle event when true
+    bool throttle(const std::string& tenant);
+    
+    bool enqueue(const std::string& tenant, Task task);
+    // Runs up to max_tasks queued tasks on the calling thread, charging each
+    // one's CPU time; returns how many ran. Throttled tenants keep their
+    // queue until their window frees up.
+    size_t runPending(size_t max_tasks = SIZE_MAX);
+    size_t pendingCount() const;
+    
+    Usage getUsage(const std::string& tenant) const;
+    std::map<std::string, Usage> getAllUsage() const;
+    // Publishes v8_sandbox_cpu_* series, labelled by sandbox, to MetricsCollector
+    void publishMetrics() const;
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Tenant {
+        TenantConfig config;
+        std::array<int64_t, kWindowBuckets> bucket_ns{};
+        std::array<int64_t, kWindowBuckets> bucket_ids{};
+        int64_t total_ns = 0;
+        uint64_t executions = 0;
+        uint64_t throttled = 0;
+        double virtual_time = 0.0;
+        std::deque<Task> queue;
+        
+        Tenant() { bucket_ids.fill(-1); }
+    };
+    
+    mutable std::mutex mutex_;
+    std::map<std::string, Tenant> tenants_;
+    double virtual_clock_ = 0.0;
+    size_t pending_ = 0;
+    
+    static int64_t bucketWidthNs(const Tenant& tenant);
+    static int64_t windowUsageNs(const Tenant& tenant, Clock::time_point now);
+    void chargeLocked(Tenant& tenant, int64_t cpu_ns, Clock::time_point now);
+};
+
 // Sandbox manager for isolating JavaScript execution
 class SandboxManager {
 public:
@@ -35,9 +122,58 @@ public:
     
     bool createSandbox(v8::Isolate* isolate, const std::string& sandbox_name,
                       const SandboxConfig& config);
+    
+    // Restrictions and allowed globals are baked into a global ObjectTemplate
+    // once per isolate and template; each sandbox after that is a single
+    // Context::New. createSandbox shares templates between equal configs.
+    void registerTemplate(const std::string& template_name, const SandboxConfig& config);
+    bool createSandboxFromTemplate(v8::Isolate* isolate, const std::string& sandbox_name,
+                                   const std::string& template_name);
+    bool hasTemplate(const std::string& template_name) const;
+    // Drops the templates and compiled scripts cached for `isolate`. They
+    // outlive removeSandbox, so call this before disposing the isolate.
+    void releaseTemplates(v8::Isolate* isolate);
+    
+    // executeSandboxed keeps compiled UnboundScripts per isolate and source,
+    // and binds them to the sandbox context on use, so a repeated script is
+    // not parsed again. CodeValidator::validateScript in PARSE mode adds the
+    // script it compiled. Entry size is estimated from the source length;
+    // least recently used entries go first once over budget. Entries
+    // outlive their sandboxes until evicted or releaseTemplates().
+    struct ScriptCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t budget = 0;
+    };
+    
+    void setScriptCacheBudget(size_t bytes);
+    ScriptCacheStats getScriptCacheStats() const;
+    void clearScriptCache();
+    void cacheScript(v8::Isolate* isolate, const std::string& code, v8::Local<v8::UnboundScript> script);
     v8::Local<v8::Context> getSandboxContext(v8::Isolate* isolate, const std::string& sandbox_name);
+    // Runs under SandboxConfig::execution_timeout (or the ResourceLimiter
+    // default); a script past its deadline is terminated and reported as
+    // ErrorCode::TIMEOUT_ERROR, and the isolate stays usable afterwards
     bool executeSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
-                         const std::string& code, v8::Local<v8::Value>& result);
+                         const std::string& code, v8::Local<v8::Value>& result,
+                         ErrorInfo* error = nullptr);
+    
+    // executeSandboxed charges the sandbox's CPU time and refuses to run
+    // it with ErrorCode::CPU_QUOTA_EXCEEDED while it is over quota. Queued
+    // runs are instead held back until the quota window frees up, and
+    // runQueued() interleaves sandboxes by weight. `on_complete` is called
+    // from runQueued() inside a HandleScope. Returns false, without calling
+    // `on_complete`, if the sandbox does not exist.
+    using Completion = std::function<void(bool ok, v8::Local<v8::Value> result, const ErrorInfo& error)>;
+    bool enqueueSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
+                          std::string code, Completion on_complete);
+    size_t runQueued(size_t max_runs = SIZE_MAX);
+    
+    SandboxScheduler& getScheduler() { return scheduler_; }
+    SandboxScheduler::Usage getCpuUsage(const std::string& sandbox_name) const;
     
     bool hasSandbox(const std::string& sandbox_name) const;
     void removeSandbox(const std::string& sandbox_name);
@@ -53,11 +189,75 @@ private:
         std::chrono::system_clock::time_point created_at;
     };
     
+    struct CachedScript {
+        v8::Isolate* isolate = nullptr;
+        std::string source;
+        size_t hash = 0;
+        size_t bytes = 0;
+        v8::Global<v8::UnboundScript> script;
+    };
+    
+    // Compiled code and metadata run to a few times the source size
+    static constexpr size_t kCompiledSizeFactor = 4;
+    
     mutable std::mutex sandboxes_mutex_;
     std::map<std::string, SandboxInfo> sandboxes_;
+    SandboxScheduler scheduler_;
+    
+    struct SandboxTemplate {
+        SandboxConfig config;
+        std::string key;
+    };
+    
+    mutable std::mutex templates_mutex_;
+    std::map<std::string, SandboxTemplate> named_templates_;
+    std::map<std::pair<v8::Isolate*, std::string>, v8::Global<v8::ObjectTemplate>> global_templates_;
+    
+    mutable std::mutex script_cache_mutex_;
+    std::list<CachedScript> script_lru_;
+    std::unordered_multimap<size_t, std::list<CachedScript>::iterator> script_index_;
+    size_t script_cache_bytes_ = 0;
+    size_t script_cache_budget_ = 32 * 1024 * 1024;
+    uint64_t script_cache_hits_ = 0;
+    uint64_t script_cache_misses_ = 0;
+    uint64_t script_cache_evictions_ = 0;
     
-    void applySandboxRestrictions(v8::Isolate* isolate, v8::Local<v8::Context> context,
-                                 const SandboxConfig& config);
+    bool runSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
+                      const std::string& code, v8::Local<v8::Value>& result, ErrorInfo* error);
+    bool instantiateSandbox(v8::Isolate* isolate, const std::string& sandbox_name,
+                            const SandboxConfig& config, const std::string& template_key);
+    v8::Local<v8::ObjectTemplate> getGlobalTemplate(v8::Isolate* isolate, const std::string& template_key,
+                                                    const SandboxConfig& config);
+    static std::string templateKey(const SandboxConfig& config);
+    v8::MaybeLocal<v8::Script> compileCached(v8::Isolate* isolate, const std::string& code);
+    static size_t scriptHash(v8::Isolate* isolate, const std::string& code);
+    std::list<CachedScript>::iterator findScriptLocked(v8::Isolate* isolate, const std::string& code, size_t hash);
+    void evictScripts(const std::function<bool(const CachedScript&)>& predicate);
+    void eraseScriptLocked(std::list<CachedScript>::iterator entry);
+    static v8::Local<v8::ObjectTemplate> buildGlobalTemplate(v8::Isolate* isolate, const SandboxConfig& config);
+};
+
+// ArrayBuffer allocator that accounts every backing store and refuses
+// allocations past its limit (V8 then throws a RangeError in the script)
+class AccountingArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+public:
+    explicit AccountingArrayBufferAllocator(size_t limit_bytes = 0);
+    
+    void* Allocate(size_t length) override;
+    void* AllocateUninitialized(size_t length) override;
+    void Free(void* data, size_t length) override;
+    
+    size_t getAllocated() const { return allocated_.load(std::memory_order_relaxed); }
+    size_t getRejected() const { return rejected_.load(std::memory_order_relaxed); }
+    size_t getLimit() const { return limit_.load(std::memory_order_relaxed); }
+    void setLimit(size_t limit_bytes) { limit_.store(limit_bytes, std::memory_order_relaxed); }
+    
+private:
+    bool reserve(size_t length);
+    
+    std::atomic<size_t> allocated_{0};
+    std::atomic<size_t> rejected_{0};
+    std::atomic<size_t> limit_;
 };
 
 // Resource limiter for controlling V8 resource usage
@@ -68,6 +268,7 @@ public:
     void setMemoryLimit(v8::Isolate* isolate, size_t limit_bytes);
     void setExecutionTimeout(std::chrono::milliseconds timeout);
     void setCallStackLimit(size_t limit);
+    std::chrono::milliseconds getExecutionTimeout() const;
     
     bool checkMemoryUsage(v8::Isolate* isolate);
     bool checkExecutionTime(const std::chrono::steady_clock::time_point& start_time);
@@ -78,51 +279,464 @@ public:
         size_t memory_total = 0;
         size_t memory_limit = 0;
         size_t heap_size_limit = 0;
+        size_t array_buffer_used = 0;
     };
     
     ResourceUsage getCurrentUsage(v8::Isolate* isolate);
+    
+    // Installs (or removes) a TERMINATE memory policy; kept for existing callers
     void enableResourceMonitoring(v8::Isolate* isolate, bool enable);
     
+    // What happens when an isolate reaches its heap limit
+    enum class MemoryLimitAction {
+        GROW_ONCE,              // raise the limit once, terminate on the next hit
+        TERMINATE,
+        SNAPSHOT_AND_TERMINATE  // write a .heapsnapshot, then terminate
+    };
+    
+    struct MemoryEvent {
+        size_t current_heap_limit = 0;
+        size_t initial_heap_limit = 0;
+        MemoryLimitAction action_taken = MemoryLimitAction::TERMINATE;
+        std::string snapshot_path;
+    };
+    
+    struct MemoryPolicy {
+        size_t heap_limit = 0;          // bytes; 0 = V8 default
+        size_t array_buffer_limit = 0;  // bytes of ArrayBuffer backing stores; 0 = no limit
+        MemoryLimitAction action = MemoryLimitAction::TERMINATE;
+        size_t grow_bytes = 0;          // headroom granted on a hit; 0 = half the initial limit
+        std::string snapshot_directory = ".";
+        // Runs on the isolate's thread inside the GC; must not allocate on the V8 heap
+        std::function<void(v8::Isolate*, const MemoryEvent&)> on_limit;
+    };
+    
+    struct MemoryStats {
+        size_t near_limit_events = 0;
+        size_t terminations = 0;
+        size_t array_buffer_used = 0;
+        size_t array_buffer_rejected = 0;
+    };
+    
+    // Heap constraints and the accounting allocator can only be set before
+    // the isolate exists; configureCreateParams fills them in, createIsolate
+    // also installs the policy
+    void configureCreateParams(v8::Isolate::CreateParams& params, const MemoryPolicy& policy);
+    v8::Isolate* createIsolate(const MemoryPolicy& policy);
+    
+    // Registers the near-heap-limit callback. Call removeMemoryPolicy before
+    // disposing the isolate.
+    void installMemoryPolicy(v8::Isolate* isolate, const MemoryPolicy& policy);
+    void removeMemoryPolicy(v8::Isolate* isolate);
+    MemoryStats getMemoryStats(v8::Isolate* isolate) const;
+    
+    // Clears a termination raised by the memory policy so the isolate can run
+    // again; false if the policy did not terminate it
+    bool recoverFromMemoryTermination(v8::Isolate* isolate);
+    
 private:
     ResourceLimiter() = default;
     
+    struct IsolateMemoryState {
+        v8::Isolate* isolate = nullptr;
+        MemoryPolicy policy;
+        bool grown = false;
+        std::atomic<bool> terminated{false};
+        std::atomic<size_t> near_limit_events{0};
+        std::atomic<size_t> terminations{0};
+    };
+    
     mutable std::mutex limits_mutex_;
     size_t memory_limit_ = 0;
     std::chrono::milliseconds execution_timeout_{0};
     size_t call_stack_limit_ = 0;
+    std::map<v8::Isolate*, std::unique_ptr<IsolateMemoryState>> memory_states_;
+    
+    static size_t nearHeapLimit(void* data, size_t current_heap_limit, size_t initial_heap_limit);
+    static std::string writeHeapSnapshot(v8::Isolate* isolate, const std::string& directory);
+};
+
+// Isolate-per-tenant sandboxing: each tenant gets its own isolate (own
+// heap, GC and memory policy) running on its own thread, and execute()
+// routes work to it. Isolates outlive requests; one idle for idle_timeout
+// is parked (moved to background and its heap trimmed), and past
+// max_isolates the least recently used idle tenant is reclaimed. Inside
+// each isolate the tenant is an ordinary SandboxManager sandbox.
+class TenantIsolatePool {
+public:
+    struct Config {
+        size_t max_isolates = 16;
+        std::chrono::milliseconds idle_timeout{30000};
+    };
+    
+    struct TenantConfig {
+        SandboxConfig sandbox;
+        ResourceLimiter::MemoryPolicy memory;
+    };
+    
+    // Values cannot cross isolates, so results come back as strings
+    // (JSON for objects and arrays)
+    struct ExecutionResult {
+        bool ok = false;
+        std::string value;
+        ErrorInfo error{ErrorCode::SUCCESS, ""};
+    };
     
-    std::atomic<bool> monitoring_enabled_{false};
-    std::unique_ptr<std::thread> monitoring_thread_;
+    using Completion = std::function<void(const ExecutionResult&)>;
     
-    void monitorResources(v8::Isolate* isolate);
+    struct Stats {
+        size_t live = 0;
+        size_t parked = 0;
+        uint64_t created = 0;
+        uint64_t reclaimed = 0;
+        uint64_t executions = 0;
+    };
+    
+    static TenantIsolatePool& getInstance();
+    ~TenantIsolatePool();
+    
+    void configure(const Config& config);
+    void registerTenant(const std::string& tenant, const TenantConfig& config);
+    void removeTenant(const std::string& tenant);
+    bool hasTenant(const std::string& tenant) const;
+    
+    // `on_complete` runs on the tenant's isolate thread, or on the caller's
+    // (with no pool lock held) for an unknown tenant
+    void execute(const std::string& tenant, std::string code, Completion on_complete);
+    std::future<ExecutionResult> execute(const std::string& tenant, std::string code);
+    
+    Stats getStats() const;
+    // Stops every tenant thread and disposes its isolate; call before V8::Dispose
+    void shutdown();
+    
+private:
+    TenantIsolatePool() = default;
+    
+    struct Job {
+        std::string code;
+        Completion on_complete;
+    };
+    
+    struct Worker {
+        std::string tenant;
+        TenantConfig config;
+        std::chrono::milliseconds idle_timeout{0};
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Job> queue;
+        bool busy = false;
+        bool parked = false;
+        bool stopping = false;
+        bool failed = false;  // no isolate; jobs are answered with errors until replaced
+        std::chrono::steady_clock::time_point last_used;
+    };
+    
+    mutable std::mutex mutex_;
+    Config config_;
+    std::map<std::string, TenantConfig> tenants_;
+    std::map<std::string, std::shared_ptr<Worker>> workers_;
+    uint64_t created_ = 0;
+    uint64_t reclaimed_ = 0;
+    std::atomic<uint64_t> executions_{0};
+    
+    std::vector<std::shared_ptr<Worker>> takeIdleWorkersLocked(const std::string& keep);
+    static void stopWorker(const std::shared_ptr<Worker>& worker);
+    void runWorker(Worker& worker);
+    static void failJobs(Worker& worker);
+};
+
+// Single watchdog thread enforcing execution deadlines for every isolate.
+// Deadlines live in a hashed timer wheel with kTickResolution ticks, so
+// arming and disarming are O(1) and the thread only wakes while something
+// is armed. An expired entry calls TerminateExecution on its isolate; the
+// owner sees that from disarm() and calls CancelTerminateExecution.
+class ExecutionWatchdog {
+public:
+    using Handle = uint64_t;
+    
+    static constexpr std::chrono::milliseconds kTickResolution{1};
+    static constexpr size_t kWheelSlots = 1024;
+    
+    struct Stats {
+        size_t armed = 0;
+        uint64_t expired = 0;
+    };
+    
+    static ExecutionWatchdog& getInstance();
+    ~ExecutionWatchdog();
+    
+    // Terminates `isolate` once `timeout` passes unless disarmed first
+    Handle arm(v8::Isolate* isolate, std::chrono::milliseconds timeout);
+    // Runs `on_expire` on the watchdog thread instead, without the watchdog
+    // lock held (it may arm and disarm, but should not block)
+    Handle arm(std::chrono::milliseconds timeout, std::function<void()> on_expire);
+    
+    // Returns true if the deadline had already passed. Once this returns the
+    // entry can no longer fire, and an on_expire it started has finished
+    // (except when called from that callback).
+    bool disarm(Handle handle);
+    
+    Stats getStats() const;
+    
+    // Arms on construction, disarms on destruction and clears a termination
+    // this scope caused so the isolate can run again
+    class Scope {
+    public:
+        Scope(v8::Isolate* isolate, std::chrono::milliseconds timeout);
+        ~Scope();
+        
+        bool timedOut();
+        
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        
+    private:
+        v8::Isolate* isolate_;
+        Handle handle_ = 0;
+        bool finished_ = false;
+        bool timed_out_ = false;
+    };
+    
+private:
+    ExecutionWatchdog();
+    
+    struct Entry {
+        v8::Isolate* isolate = nullptr;
+        std::function<void()> on_expire;
+        uint64_t deadline_tick = 0;
+        bool expired = false;
+    };
+    
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable callbacks_done_;
+    bool running_callbacks_ = false;
+    std::unordered_map<Handle, Entry> entries_;
+    std::vector<std::vector<Handle>> wheel_;
+    const std::chrono::steady_clock::time_point epoch_;
+    uint64_t processed_tick_ = 0;
+    size_t armed_count_ = 0;
+    uint64_t expired_count_ = 0;
+    Handle next_handle_ = 1;
+    bool stopping_ = false;
+    std::thread thread_;
+    
+    Handle insert(Entry entry, std::chrono::milliseconds timeout);
+    uint64_t currentTick() const;
+    void run();
+    // Expires entries due by `tick`; returns their callbacks for run() to
+    // call once the lock is released
+    std::vector<std::function<void()>> advanceTo(uint64_t tick);
+};
+
+// Multi-pattern matcher compiled once from a pattern list. Each pattern's
+// leading literal goes into an Aho-Corasick automaton; the rest (literals,
+// \s, \s*, \s+) is checked by a small deterministic matcher at the hit.
+// Patterns outside that subset fall back to std::regex.
+class PatternScanner {
+public:
+    explicit PatternScanner(const std::vector<std::string>& patterns);
+    
+    size_t patternCount() const { return patterns_.size(); }
+    const std::string& pattern(size_t index) const { return patterns_[index].source; }
+    
+    // Indices of the patterns found in text, in pattern order. on_byte is
+    // called for every byte so callers can fold their own checks into the
+    // same pass.
+    template <typename ByteHook>
+    std::vector<size_t> scan(std::string_view text, ByteHook&& on_byte) const {
+        std::vector<bool> found(patterns_.size(), false);
+        size_t remaining = automaton_patterns_;
+        int32_t state = 0;
+        
+        for (size_t i = 0; i < text.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            on_byte(c);
+            state = transitions_[static_cast<size_t>(state) * 256 + c];
+            if (remaining == 0 || outputs_[state].empty()) continue;
+            
+            for (uint32_t index : outputs_[state]) {
+                if (!found[index] && matchTail(patterns_[index], text, i + 1)) {
+                    found[index] = true;
+                    --remaining;
+                }
+            }
+        }
+        
+        return collectMatches(text, found);
+    }
+    
+    std::vector<size_t> findAll(std::string_view text) const {
+        return scan(text, [](unsigned char) {});
+    }
+    
+private:
+    enum class StepType : uint8_t { Literal, Space, SpaceStar, SpacePlus };
+    
+    struct Step {
+        StepType type;
+        char literal;
+    };
+    
+    struct Pattern {
+        std::string source;
+        std::string prefix;        // matched by the automaton
+        std::vector<Step> tail;    // matched at the automaton hit
+        std::unique_ptr<std::regex> fallback;
+    };
+    
+    static bool compile(const std::string& source, Pattern& pattern);
+    static bool matchTail(const Pattern& pattern, std::string_view text, size_t pos);
+    std::vector<size_t> collectMatches(std::string_view text, const std::vector<bool>& found) const;
+    
+    std::vector<Pattern> patterns_;
+    std::vector<int32_t> transitions_;              // state * 256 + byte -> state
+    std::vector<std::vector<uint32_t>> outputs_;    // patterns whose prefix ends here
+    size_t automaton_patterns_ = 0;
 };
 
-// Code validator for checking JavaScript code for security issues
+// Code validator for checking JavaScript code for security issues.
+// Validation reads an immutable rule set without taking the validator's
+// mutex; rule changes build a new set and publish it atomically. The
+// shared_ptr atomics themselves are not lock-free.
 class CodeValidator {
 public:
+    enum class ValidationMode {
+        PATTERN,  // dangerous-pattern scan plus bracket and size heuristics
+        PARSE     // tokenizer metrics plus one V8 compile that is kept for execution
+    };
+    
+    struct ValidationResult {
+        bool valid = true;
+        std::vector<std::string> violations;
+    };
+    
+    // Limits applied to ScriptAnalyzer metrics in PARSE mode
+    struct ScriptLimits {
+        size_t max_nesting_depth = 64;  // 0 = unlimited
+        size_t max_loops = 0;           // 0 = unlimited
+        size_t max_functions = 0;       // 0 = unlimited
+        ScriptAnalyzer::IdentifierSet banned_identifiers = {
+            "eval", "Function", "setTimeout", "setInterval", "require", "process",
+            "__dirname", "__filename", "Buffer", "global", "module", "exports",
+            "with", "callee"
+        };
+    };
+    
+    // Result of analyzeScript(). The compiled script is kept so execution
+    // in the same isolate skips parsing; other isolates use code_cache.
+    // validateScript hands it to SandboxManager's script cache.
+    struct ScriptAnalysis {
+        bool valid = false;
+        std::vector<std::string> violations;
+        ScriptMetrics metrics;
+        v8::Isolate* isolate = nullptr;
+        v8::Global<v8::UnboundScript> script;
+        std::vector<uint8_t> code_cache;
+    };
+    
+    struct CacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    
     static CodeValidator& getInstance();
     
     bool validateCode(const std::string& code);
+    ValidationResult validate(std::string_view code);
     bool validateScript(v8::Isolate* isolate, v8::Local<v8::Context> context,
                        const std::string& code);
     
+    // PARSE mode pieces: validateStructure is the V8-free tokenizer check,
+    // analyzeScript adds the compile, compileAnalyzed reuses it
+    ValidationResult validateStructure(std::string_view code, ScriptMetrics* metrics = nullptr);
+    ScriptAnalysis analyzeScript(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                 const std::string& code);
+    v8::MaybeLocal<v8::Script> compileAnalyzed(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                               const std::string& code, const ScriptAnalysis& analysis);
+    
+    void setValidationMode(ValidationMode mode);
+    ValidationMode getValidationMode() const;
+    void setScriptLimits(const ScriptLimits& limits);
+    ScriptLimits getScriptLimits() const;
+    
     void addDangerousPattern(const std::string& pattern);
     void removeDangerousPattern(const std::string& pattern);
     void setComplexityLimit(size_t limit);
     
+    // Violations from the calling thread's most recent validateCode()
     std::vector<std::string> getViolations() const;
     
+    CacheStats getCacheStats() const;
+    void clearCache();
+    
 private:
-    CodeValidator() = default;
+    CodeValidator();
+    
+    struct Rules {
+        PatternScanner scanner;
+        size_t default_pattern_count;
+        size_t complexity_limit;
+        ScriptLimits script_limits;
+        uint64_t generation;
+    };
+    
+    // Results are cached by source hash in a fixed, direct-mapped table;
+    // two independent hashes plus the length guard against collisions
+    struct CacheEntry {
+        uint64_t hash;
+        uint64_t check;
+        size_t length;
+        uint64_t generation;
+        ValidationResult result;
+    };
+    static constexpr size_t kCacheSlots = 256;
     
-    mutable std::mutex validation_mutex_;
-    std::vector<std::regex> dangerous_patterns_;
+    std::mutex validation_mutex_;  // serialises rule changes only
+    std::vector<std::string> custom_patterns_;
     size_t complexity_limit_ = 10000;
-    mutable std::vector<std::string> violations_;
+    ScriptLimits script_limits_;
+    uint64_t generation_ = 0;
+    std::atomic<ValidationMode> mode_{ValidationMode::PATTERN};
+    
+    // std::atomic<std::shared_ptr> where the standard library has it;
+    // libc++ does not, so there it falls back to the (C++20-deprecated)
+    // std::atomic_load / std::atomic_store overloads
+    template <typename T>
+    class AtomicShared {
+    public:
+        std::shared_ptr<T> load() const {
+#ifdef __cpp_lib_atomic_shared_ptr
+            return ptr_.load();
+#else
+            return std::atomic_load(&ptr_);
+#endif
+        }
+        
+        void store(std::shared_ptr<T> value) {
+#ifdef __cpp_lib_atomic_shared_ptr
+            ptr_.store(std::move(value));
+#else
+            std::atomic_store(&ptr_, std::move(value));
+#endif
+        }
+        
+    private:
+#ifdef __cpp_lib_atomic_shared_ptr
+        std::atomic<std::shared_ptr<T>> ptr_;
+#else
+        std::shared_ptr<T> ptr_;
+#endif
+    };
+    
+    AtomicShared<const Rules> rules_;
+    std::array<AtomicShared<const CacheEntry>, kCacheSlots> cache_;
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> cache_misses_{0};
     
-    bool checkDangerousPatterns(const std::string& code);
-    bool checkSyntax(const std::string& code);
-    bool checkComplexity(const std::string& code);
+    void rebuildRules();
+    ValidationResult runChecks(const Rules& rules, std::string_view code) const;
 };
 
 // Cryptographic operations for security
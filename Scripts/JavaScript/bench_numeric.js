@@ -0,0 +1,68 @@
+// Times the Numeric DLL's SIMD kernels against the equivalent pure-JS loops.
+// Run from the project root: ./Bin/v8console Scripts/JavaScript/bench_numeric.js
+
+loadDll('./Bin/Numeric.so');
+print('SIMD level:', simdLevel());
+
+const n = 1 << 20;
+const rounds = 50;
+
+function fill(Kind, f) {
+  const a = new Kind(n);
+  for (let i = 0; i < n; i++) a[i] = f(i);
+  return a;
+}
+
+function time(f) {
+  for (let r = 0; r < 5; r++) f();  // let the JS side get optimized first
+  const start = Date.now();
+  for (let r = 0; r < rounds; r++) f();
+  return (Date.now() - start) / rounds;
+}
+
+const js = {
+  sum(a) { let s = 0; for (let i = 0; i < a.length; i++) s += a[i]; return s; },
+  dot(a, b) { let s = 0; for (let i = 0; i < a.length; i++) s += a[i] * b[i]; return s; },
+  minMax(a) {
+    let min = Infinity, max = -Infinity;
+    for (let i = 0; i < a.length; i++) { if (a[i] < min) min = a[i]; if (a[i] > max) max = a[i]; }
+    return {min, max};
+  },
+  prefixSum(a) {
+    const out = new a.constructor(a.length);
+    let s = 0;
+    for (let i = 0; i < a.length; i++) { s += a[i]; out[i] = s; }
+    return out;
+  },
+  histogram(a, bins, lo, hi) {
+    const counts = new Uint32Array(bins), scale = bins / (hi - lo);
+    for (let i = 0; i < a.length; i++) {
+      const v = a[i];
+      if (v >= lo && v <= hi) counts[Math.min(bins - 1, Math.floor((v - lo) * scale))]++;
+    }
+    return counts;
+  },
+  mul(a, b, out) { for (let i = 0; i < a.length; i++) out[i] = a[i] * b[i]; return out; },
+};
+
+for (const Kind of [Float64Array, Float32Array, Int32Array]) {
+  const a = fill(Kind, i => (i * 7919) % 2001 - 1000);
+  const b = fill(Kind, i => (i % 13) - 6);
+  const out = new Kind(n);
+
+  print(`\n${Kind.name}, ${n} elements (ms per call)`);
+  const rows = [
+    ['sum', () => js.sum(a), () => simdSum(a)],
+    ['dot', () => js.dot(a, b), () => simdDot(a, b)],
+    ['minMax', () => js.minMax(a), () => simdMinMax(a)],
+    ['prefixSum', () => js.prefixSum(a), () => simdPrefixSum(a)],
+    ['histogram', () => js.histogram(a, 64, -1000, 1000), () => simdHistogram(a, 64, -1000, 1000)],
+    ['mul', () => js.mul(a, b, out), () => simdMul(a, b, out)],
+    ['sort', () => a.slice().sort(), () => simdSort(a.slice())],
+  ];
+  for (const [name, jsLoop, native] of rows) {
+    const jsMs = time(jsLoop), nativeMs = time(native);
+    print(`  ${name.padEnd(10)} js ${jsMs.toFixed(3).padStart(8)}  native ${nativeMs.toFixed(3).padStart(8)}  ` +
+          `x${(jsMs / Math.max(nativeMs, 0.001)).toFixed(1)}`);
+  }
+}
@@ -9,7 +9,33 @@ try {
   print('fib(5) =', fib(5));
   print('fib(10) =', fib(10));
   
+  // Past fib(77) the sum is no longer exact as a Number; fibBig returns a BigInt
+  print('fib(77) =', fib(77));
+  print('fibBig(100) =', fibBig(100));
+  print('fibBatch([1..5]) =', fibBatch(new Int32Array([1, 2, 3, 4, 5])).join(', '));
+  
+  // Throughput: one call per element against a single batch call
+  const count = 1 << 20;
+  const ns = new Int32Array(count);
+  for (let i = 0; i < count; i++) ns[i] = i % 78;
+  
+  let start = Date.now();
+  let total = 0;
+  for (let i = 0; i < count; i++) total += fib(ns[i]);
+  print(count, 'fib calls:', Date.now() - start, 'ms');
+  
+  start = Date.now();
+  fibBatch(ns);
+  print('fibBatch over', count, 'elements:', Date.now() - start, 'ms');
+  
+  // The first large fibBig is computed by fast doubling, repeats are cached
+  start = Date.now();
+  const digits = fibBig(1 << 20).toString().length;
+  print('fibBig(2^20):', digits, 'digits in', Date.now() - start, 'ms');
+  start = Date.now();
+  fibBig(1 << 20);
+  print('fibBig(2^20) again:', Date.now() - start, 'ms');
+  
 } catch (e) {
   print('Error:', e);
 }
-EOF < /dev/null
\ No newline at end of file
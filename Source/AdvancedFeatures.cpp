@@ -1,5 +1,6 @@
 #include "V8Integration/AdvancedFeatures.h"
 #include "V8Compat.h"
+#include "V8Binding.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -15,7 +16,7 @@ std::map<std::string, HttpServer::RequestHandler> HttpServer::get_handlers_;
 std::map<std::string, HttpServer::RequestHandler> HttpServer::post_handlers_;
 std::string HttpServer::static_directory_;
 std::map<std::string, std::function<std::unique_ptr<DatabaseManager::Connection>()>> DatabaseManager::drivers_;
-std::map<std::string, v8::Global<v8::Value>> ConfigManager::config_;
+std::map<std::string, v8::Global<v8::Value>, std::less<>> ConfigManager::config_;
 std::map<std::string, std::vector<std::function<void(v8::Local<v8::Value>)>>> ConfigManager::watchers_;
 
 // WebAssemblyManager Implementation
@@ -969,24 +970,24 @@ void ConfigManager::initialize(v8::Isolate* isolate) {
     
     // Add get method
     config->Set(context,
-        v8::String::NewFromUtf8(isolate, "get").ToLocalChecked(),
+        v8integration::binding::Intern<"get">(isolate),
         v8::Function::New(context, getCallback).ToLocalChecked()
     ).Check();
     
     // Add set method
     config->Set(context,
-        v8::String::NewFromUtf8(isolate, "set").ToLocalChecked(),
+        v8integration::binding::Intern<"set">(isolate),
         v8::Function::New(context, setCallback).ToLocalChecked()
     ).Check();
     
     // Add watch method
     config->Set(context,
-        v8::String::NewFromUtf8(isolate, "watch").ToLocalChecked(),
+        v8integration::binding::Intern<"watch">(isolate),
         v8::Function::New(context, watchCallback).ToLocalChecked()
     ).Check();
     
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "config").ToLocalChecked(),
+        v8integration::binding::Intern<"config">(isolate),
         config
     ).Check();
 }
@@ -1000,7 +1001,7 @@ void ConfigManager::loadConfig(const std::string& filename) {
     }
 }
 
-v8::Local<v8::Value> ConfigManager::get(v8::Isolate* isolate, const std::string& key) {
+v8::Local<v8::Value> ConfigManager::get(v8::Isolate* isolate, std::string_view key) {
     auto it = config_.find(key);
     if (it != config_.end()) {
         return it->second.Get(isolate);
@@ -1035,7 +1036,7 @@ void ConfigManager::getCallback(const v8::FunctionCallbackInfo<v8::Value>& args)
     }
     
     v8::String::Utf8Value key(isolate, args[0]);
-    args.GetReturnValue().Set(get(isolate, *key));
+    args.GetReturnValue().Set(get(isolate, std::string_view(*key, key.length())));
 }
 
 void ConfigManager::setCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -1,14 +1,262 @@
 #include "DllLoader.h"
 #include <iostream>
 #include <algorithm>
+#include <filesystem>
+#include <thread>
 #include <rang/rang.hpp>
 
 #ifdef _WIN32
     #include <windows.h>
 #else
     #include <dlfcn.h>
+    #include <unistd.h>
 #endif
 
+namespace fs = std::filesystem;
+
+namespace {
+    std::string CanonicalPath(const std::string& path) {
+        std::error_code ec;
+        fs::path canonical = fs::weakly_canonical(path, ec);
+        return ec || canonical.empty() ? path : canonical.string();
+    }
+    
+    unsigned long ProcessId() {
+#ifdef _WIN32
+        return GetCurrentProcessId();
+#else
+        return static_cast<unsigned long>(getpid());
+#endif
+    }
+    
+    void RemoveCopy(const std::string& copyPath) {
+        if (copyPath.empty()) return;
+        std::error_code ec;
+        fs::remove(copyPath, ec);
+    }
+}
+
+// Process-wide state behind every DllLoader. One mutex guards the maps and
+// each SharedDll; trampolines never take it. Libraries, targets and slots
+// are only ever added: a trampoline may still read a retired Target while
+// it re-checks its slot, and JS may hold a slot's trampoline indefinitely.
+class DllLoader::Registry {
+public:
+    // Never destroyed, so isolates that outlive static destruction still
+    // find their slots
+    static Registry& Instance() {
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+    
+    // Map the library (first user) or share it; nullptr if it cannot be loaded
+    SharedDll* Acquire(const std::string& canonical) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseIdleRetiredLocked();
+    
+        auto& dll = dlls_[canonical];
+        if (!dll) {
+            dll = std::make_unique<SharedDll>();
+            dll->path = canonical;
+        }
+        if (dll->refs == 0) {
+            void* handle = LoadLibrary(canonical);
+            if (!handle) return nullptr;
+            dll->library = NewLibraryLocked(handle, "");
+            dll->swappable = GetSymbol(handle, "V8Manifest") || GetSymbol(handle, "V8NativeFunctions");
+            // Functions JS kept from an earlier load work again
+            RetargetLocked(*dll, dll->library);
+        }
+        ++dll->refs;
+        return dll.get();
+    }
+    
+    // The last release detaches every slot and retires the library
+    void Release(SharedDll* dll) {
+        Library* old = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--dll->refs > 0) return;
+            RetargetLocked(*dll, nullptr);
+            old = dll->library;
+            dll->library = nullptr;
+            retired_.push_back(old);
+        }
+        Drain(old);
+    }
+    
+    // Load the current file from a private copy (dlopen of the same path
+    // would return the mapping that is still loaded) and swap every bound
+    // slot to it
+    bool Swap(SharedDll* dll) {
+        Library* old = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!dll->library) return false;
+    
+            // <stem>.reload<pid>-<n><ext>: the pid keeps processes reloading the
+            // same library apart, and copying without overwrite fails instead
+            // of replacing a file some other process has mapped
+            fs::path source(dll->path);
+            fs::path copy;
+            std::error_code ec;
+            fs::path temp = fs::temp_directory_path(ec);
+            for (int attempt = 0; !ec && attempt < 16; ++attempt) {
+                copy = temp / (source.stem().string() + ".reload" + std::to_string(ProcessId()) + "-" +
+                               std::to_string(++reloadCount_) + source.extension().string());
+                if (fs::copy_file(source, copy, fs::copy_options::none, ec) || ec != std::errc::file_exists) {
+                    break;
+                }
+            }
+            if (ec) {
+                std::cerr << rang::fg::red << "Failed to copy DLL for reload: " << dll->path << " ("
+                          << ec.message() << ")" << rang::style::reset << std::endl;
+                return false;
+            }
+    
+            void* handle = LoadLibrary(copy.string());
+            if (!handle) {
+                std::cerr << rang::fg::red << "Failed to load DLL: " << dll->path << rang::style::reset << std::endl;
+                RemoveCopy(copy.string());
+                return false;
+            }
+            if (!GetSymbol(handle, "V8Manifest") && !GetSymbol(handle, "V8NativeFunctions")) {
+                std::cerr << rang::fg::red << "Reloaded DLL no longer exports V8Manifest or V8NativeFunctions: "
+                          << dll->path << rang::style::reset << std::endl;
+                FreeLibrary(handle);
+                RemoveCopy(copy.string());
+                return false;
+            }
+    
+            old = dll->library;
+            dll->library = NewLibraryLocked(handle, copy.string());
+            RetargetLocked(*dll, dll->library);
+            retired_.push_back(old);
+        }
+        Drain(old);
+        return true;
+    }
+    
+    // Keep the current build mapped while its tables are read
+    Library* Pin(SharedDll* dll) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dll->library) {
+            dll->library->calls.fetch_add(1);
+        }
+        return dll->library;
+    }
+    
+    static void Unpin(Library* library) {
+        if (library) {
+            library->calls.fetch_sub(1);
+        }
+    }
+    
+    FunctionSlot& Slot(SharedDll* dll, const std::string& name, const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = slots_[dll->path + '\0' + name];
+        if (!slot) {
+            slot = std::make_unique<FunctionSlot>();
+            slot->dll = dll;
+            slot->name = name;
+            dll->slots.push_back(slot.get());
+        }
+        slot->symbol = symbol;
+        return *slot;
+    }
+    
+    // Resolve the slot against the current build and keep it following
+    // reloads from now on. nullptr if the library is not loaded (`loaded`
+    // false) or lacks the function.
+    const Target* Bind(FunctionSlot& slot, bool* loaded = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot.bound = true;
+        if (loaded) *loaded = slot.dll->library != nullptr;
+        if (!slot.target.load() && slot.dll->library) {
+            slot.target.store(ResolveLocked(slot, slot.dll->library));
+        }
+        return slot.target.load();
+    }
+    
+    uint32_t RefCount(const std::string& canonical) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = dlls_.find(canonical);
+        return it == dlls_.end() ? 0 : it->second->refs;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<SharedDll>> dlls_;
+    std::unordered_map<std::string, std::unique_ptr<FunctionSlot>> slots_;
+    std::vector<std::unique_ptr<Library>> libraries_;
+    std::vector<std::unique_ptr<Target>> targets_;
+    std::vector<Library*> retired_;  // swapped out, waiting for calls to drain
+    uint32_t reloadCount_ = 0;
+    
+    Library* NewLibraryLocked(void* handle, const std::string& copyPath) {
+        libraries_.push_back(std::make_unique<Library>());
+        Library* library = libraries_.back().get();
+        library->handle = handle;
+        library->copyPath = copyPath;
+        return library;
+    }
+    
+    const Target* ResolveLocked(const FunctionSlot& slot, Library* library) {
+        const v8integration::binding::NativeFunction* function = nullptr;
+        if (!slot.symbol.empty()) {
+            auto resolve = reinterpret_cast<v8integration::binding::NativeResolver>(
+                GetSymbol(library->handle, slot.symbol));
+            function = resolve ? resolve() : nullptr;
+        } else {
+            typedef const v8integration::binding::NativeFunction* (*NativeTableFunc)();
+            auto table = reinterpret_cast<NativeTableFunc>(GetSymbol(library->handle, "V8NativeFunctions"));
+            for (const auto* entry = table ? table() : nullptr; entry && entry->name; ++entry) {
+                if (slot.name == entry->name) {
+                    function = entry;
+                    break;
+                }
+            }
+        }
+        if (!function) return nullptr;
+    
+        targets_.push_back(std::make_unique<Target>(Target{function, library}));
+        return targets_.back().get();
+    }
+    
+    // Point every bound slot of `dll` at `library` (nullptr to detach)
+    void RetargetLocked(SharedDll& dll, Library* library) {
+        for (FunctionSlot* slot : dll.slots) {
+            if (!slot->bound) continue;
+            slot->target.store(library ? ResolveLocked(*slot, library) : nullptr);
+        }
+    }
+    
+    // Wait up to kDrainTimeout for a swapped-out library to go idle, then
+    // close it. A call into it from the thread doing the reload (a native
+    // function calling back into JS that reloads) cannot finish while we
+    // wait; such libraries stay retired and are closed on a later load.
+    void Drain(Library* library) {
+        auto deadline = std::chrono::steady_clock::now() + kDrainTimeout;
+        while (library->calls.load() != 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        CloseIdleRetiredLocked();
+    }
+    
+    void CloseIdleRetiredLocked() {
+        auto idle = std::stable_partition(retired_.begin(), retired_.end(),
+                                          [](Library* library) { return library->calls.load() != 0; });
+        for (auto it = idle; it != retired_.end(); ++it) {
+            Library* library = *it;
+            FreeLibrary(library->handle);
+            library->handle = nullptr;
+            RemoveCopy(library->copyPath);
+        }
+        retired_.erase(idle, retired_.end());
+    }
+};
+
 DllLoader::DllLoader() {}
 
 DllLoader::~DllLoader() {
@@ -16,27 +264,36 @@ DllLoader::~DllLoader() {
 }
 
 bool DllLoader::LoadDll(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return LoadLocked(path, isolate, context);
+}
+
+bool DllLoader::LoadLocked(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context) {
     // Check if already loaded
     if (loadedDlls_.find(path) != loadedDlls_.end()) {
         std::cerr << rang::fg::yellow << "DLL already loaded: " << path << rang::style::reset << std::endl;
         return false;
     }
     
-    // Load the library
-    void* handle = LoadLibrary(path);
-    if (!handle) {
+    // Load the library, or share the mapping another loader already holds
+    Registry& registry = Registry::Instance();
+    SharedDll* shared = registry.Acquire(CanonicalPath(path));
+    if (!shared) {
         std::cerr << rang::fg::red << "Failed to load DLL: " << path << rang::style::reset << std::endl;
         return false;
     }
     
     // Create DLL handle
     auto dllHandle = std::make_unique<DllHandle>();
-    dllHandle->handle = handle;
+    dllHandle->shared = shared;
     dllHandle->path = path;
     
-    // Register functions with V8
-    if (!RegisterDllFunctions(handle, path, isolate, context)) {
-        FreeLibrary(handle);
+    // Register functions with this isolate
+    Library* library = registry.Pin(shared);
+    bool registered = library && RegisterDllFunctions(*dllHandle, library, isolate, context);
+    Registry::Unpin(library);
+    if (!registered) {
+        registry.Release(shared);
         return false;
     }
     
@@ -47,30 +304,70 @@ bool DllLoader::LoadDll(const std::string& path, v8::Isolate* isolate, v8::Local
 }
 
 bool DllLoader::UnloadDll(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!UnloadLocked(path)) {
+        return false;
+    }
+    std::cout << "Unloaded DLL: " << path << std::endl;
+    return true;
+}
+
+bool DllLoader::UnloadLocked(const std::string& path) {
     auto it = loadedDlls_.find(path);
     if (it == loadedDlls_.end()) {
         return false;
     }
     
-    FreeLibrary(it->second->handle);
+    SharedDll* shared = it->second->shared;
     loadedDlls_.erase(it);
-    std::cout << "Unloaded DLL: " << path << std::endl;
+    Registry::Instance().Release(shared);
     return true;
 }
 
 void DllLoader::UnloadAll() {
-    for (auto& pair : loadedDlls_) {
-        FreeLibrary(pair.second->handle);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!loadedDlls_.empty()) {
+        UnloadLocked(loadedDlls_.begin()->first);
     }
-    loadedDlls_.clear();
 }
 
 bool DllLoader::ReloadDll(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context) {
-    UnloadDll(path);
-    return LoadDll(path, isolate, context);
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    auto it = loadedDlls_.find(path);
+    if (it == loadedDlls_.end()) {
+        return LoadLocked(path, isolate, context);
+    }
+    
+    Registry& registry = Registry::Instance();
+    SharedDll* shared = it->second->shared;
+    if (!shared->swappable) {
+        if (registry.RefCount(shared->path) > 1) {
+            std::cerr << rang::fg::red << "Cannot reload " << path << " while other isolates use it; "
+                      << "export V8Manifest or V8NativeFunctions to reload in place" << rang::style::reset << std::endl;
+            return false;
+        }
+        UnloadLocked(path);
+        return LoadLocked(path, isolate, context);
+    }
+    
+    // Swap every function in place, for all isolates, then install any
+    // names the new build added on this one
+    if (!registry.Swap(shared)) {
+        return false;
+    }
+    DllHandle& dll = *it->second;
+    dll.exportedFunctions.clear();
+    Library* library = registry.Pin(shared);
+    bool registered = library && RegisterDllFunctions(dll, library, isolate, context);
+    Registry::Unpin(library);
+    
+    std::cout << rang::fg::green << "Reloaded DLL: " << path << rang::style::reset << std::endl;
+    return registered;
 }
 
 std::vector<std::string> DllLoader::GetLoadedDlls() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<std::string> result;
     for (const auto& pair : loadedDlls_) {
         result.push_back(pair.first);
@@ -78,6 +375,10 @@ std::vector<std::string> DllLoader::GetLoadedDlls() const {
     return result;
 }
 
+uint32_t DllLoader::GetRefCount(const std::string& path) {
+    return Registry::Instance().RefCount(CanonicalPath(path));
+}
+
 void* DllLoader::LoadLibrary(const std::string& path) {
 #ifdef _WIN32
     return ::LoadLibraryA(path.c_str());
@@ -88,7 +389,7 @@ void* DllLoader::LoadLibrary(const std::string& path) {
 
 void DllLoader::FreeLibrary(void* handle) {
     if (!handle) return;
-    
+
 #ifdef _WIN32
     ::FreeLibrary(static_cast<HMODULE>(handle));
 #else
@@ -98,7 +399,7 @@ void DllLoader::FreeLibrary(void* handle) {
 
 void* DllLoader::GetSymbol(void* handle, const std::string& name) {
     if (!handle) return nullptr;
-    
+
 #ifdef _WIN32
     return ::GetProcAddress(static_cast<HMODULE>(handle), name.c_str());
 #else
@@ -106,24 +407,141 @@ void* DllLoader::GetSymbol(void* handle, const std::string& name) {
 #endif
 }
 
-bool DllLoader::RegisterDllFunctions(void* handle, const std::string& dllName, 
-                                   v8::Isolate* isolate, v8::Local<v8::Context> context) {
-    // Look for the exported V8 registration function
-    // Convention: DLLs should export "RegisterV8Functions" function
+bool DllLoader::RegisterDllFunctions(DllHandle& dll, Library* library, v8::Isolate* isolate,
+                                     v8::Local<v8::Context> context) {
+    // Look for the exported V8 registration functions, in order of preference:
+    // - V8Manifest: names, signatures and flags only; each function is
+    //   resolved on first use (see RegisterManifest)
+    // - V8NativeFunctions: a table of callbacks, all bound at load
+    // - RegisterV8Functions: the DLL registers everything itself and cannot
+    //   be swapped on reload
     typedef void (*RegisterFunc)(v8::Isolate*, v8::Local<v8::Context>);
+    typedef const v8integration::binding::NativeFunction* (*NativeTableFunc)();
+    typedef const v8integration::binding::ManifestEntry* (*ManifestFunc)();
     
+    void* handle = library->handle;
     RegisterFunc registerFunc = reinterpret_cast<RegisterFunc>(GetSymbol(handle, "RegisterV8Functions"));
-    if (!registerFunc) {
-        std::cerr << rang::fg::red << "DLL does not export RegisterV8Functions: " << dllName << rang::style::reset << std::endl;
+    NativeTableFunc nativeTableFunc = reinterpret_cast<NativeTableFunc>(GetSymbol(handle, "V8NativeFunctions"));
+    ManifestFunc manifestFunc = reinterpret_cast<ManifestFunc>(GetSymbol(handle, "V8Manifest"));
+    if (!registerFunc && !nativeTableFunc && !manifestFunc) {
+        std::cerr << rang::fg::red << "DLL does not export RegisterV8Functions: " << dll.path << rang::style::reset << std::endl;
         return false;
     }
     
     // Call the registration function
     try {
-        registerFunc(isolate, context);
+        if (manifestFunc) {
+            return RegisterManifest(manifestFunc(), dll, isolate, context);
+        } else if (nativeTableFunc) {
+            return RegisterNativeFunctions(nativeTableFunc(), dll, isolate, context);
+        } else {
+            registerFunc(isolate, context);
+        }
         return true;
     } catch (...) {
-        std::cerr << "Exception thrown while registering functions from: " << dllName << std::endl;
+        std::cerr << "Exception thrown while registering functions from: " << dll.path << std::endl;
         return false;
     }
-}
\ No newline at end of file
+}
+
+bool DllLoader::RegisterNativeFunctions(const v8integration::binding::NativeFunction* table, DllHandle& dll,
+                                        v8::Isolate* isolate, v8::Local<v8::Context> context) {
+    if (!table) return false;
+    
+    Registry& registry = Registry::Instance();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Object> global = context->Global();
+    for (const auto* entry = table; entry->name; ++entry) {
+        dll.exportedFunctions.push_back(entry->name);
+        if (!dll.installed.insert(entry->name).second) continue;  // reload: already swapped
+    
+        FunctionSlot& slot = registry.Slot(dll.shared, entry->name, "");
+        registry.Bind(slot);
+        global->Set(context, v8integration::binding::Intern(isolate, entry->name),
+                    NewTrampoline(slot, isolate, context)).Check();
+    }
+    return true;
+}
+
+bool DllLoader::RegisterManifest(const v8integration::binding::ManifestEntry* manifest, DllHandle& dll,
+                                 v8::Isolate* isolate, v8::Local<v8::Context> context) {
+    if (!manifest) return false;
+    
+    Registry& registry = Registry::Instance();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Object> global = context->Global();
+    for (const auto* entry = manifest; entry->name; ++entry) {
+        dll.exportedFunctions.push_back(entry->name);
+        if (!dll.installed.insert(entry->name).second) continue;  // reload: already swapped
+    
+        FunctionSlot& slot = registry.Slot(dll.shared, entry->name, entry->symbol);
+        v8::Local<v8::String> name = v8integration::binding::Intern(isolate, entry->name);
+        if (entry->flags & v8integration::binding::kManifestEager) {
+            if (!registry.Bind(slot)) {
+                std::cerr << rang::fg::red << "Missing symbol " << entry->symbol << " in " << dll.path
+                          << rang::style::reset << std::endl;
+                return false;
+            }
+            global->Set(context, name, NewTrampoline(slot, isolate, context)).Check();
+            continue;
+        }
+    
+        global->SetLazyDataProperty(context, name, ResolveLazyFunction,
+                                    v8::External::New(isolate, &slot)).Check();
+    }
+    return true;
+}
+
+v8::Local<v8::Function> DllLoader::NewTrampoline(FunctionSlot& slot, v8::Isolate* isolate,
+                                                 v8::Local<v8::Context> context) {
+    // No Fast API path: optimized code would call the CFunction address of
+    // the build that was loaded when it was compiled
+    return v8::FunctionTemplate::New(isolate, CallThroughSlot, v8::External::New(isolate, &slot))
+        ->GetFunction(context).ToLocalChecked();
+}
+
+void DllLoader::CallThroughSlot(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto* slot = static_cast<FunctionSlot*>(args.Data().As<v8::External>()->Value());
+    
+    // Count the call against the library before using it, then check the
+    // slot was not swapped in between: a library whose count reads zero
+    // after the swap can no longer be entered
+    const Target* target = slot->target.load();
+    while (target) {
+        target->library->calls.fetch_add(1);
+        if (slot->target.load() == target) break;
+        target->library->calls.fetch_sub(1);
+        target = slot->target.load();
+    }
+    
+    if (!target) {
+        v8::Isolate* isolate = args.GetIsolate();
+        std::string message = slot->name + " is not available: DLL not loaded: " + slot->dll->path;
+        isolate->ThrowException(v8::Exception::Error(
+            v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+        return;
+    }
+    
+    target->function->callback(args);
+    target->library->calls.fetch_sub(1);
+}
+
+void DllLoader::ResolveLazyFunction(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info) {
+    v8::Isolate* isolate = info.GetIsolate();
+    auto* slot = static_cast<FunctionSlot*>(info.Data().As<v8::External>()->Value());
+    
+    bool loaded = false;
+    if (!Registry::Instance().Bind(*slot, &loaded)) {
+        std::string message = loaded ? "Missing symbol " + slot->symbol + " in " + slot->dll->path
+                                     : "DLL not loaded: " + slot->dll->path;
+        isolate->ThrowException(loaded ? v8::Exception::ReferenceError(
+                                             v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked())
+                                       : v8::Exception::Error(
+                                             v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+        return;
+    }
+    
+    // V8 replaces the lazy property with this trampoline, so later reads
+    // and calls never come back here
+    info.GetReturnValue().Set(NewTrampoline(*slot, isolate, isolate->GetCurrentContext()));
+}
@@ -1,45 +1,126 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <v8.h>
+#include "V8Binding.h"
 
+// Each DllLoader is one isolate's view of a process-wide library cache.
+// Libraries are keyed by canonical path and refcounted across loaders: the
+// first LoadDll of a path maps it, later ones (from any thread or isolate)
+// only register its functions on their own context, and the last UnloadDll
+// unmaps it. All methods are thread-safe.
 class DllLoader {
 public:
     DllLoader();
     ~DllLoader();
-
+    
     // Load a DLL and expose its functions to V8
     bool LoadDll(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context);
     
-    // Unload a specific DLL
+    // Unload a specific DLL. Functions already handed to this isolate keep
+    // working until no loader holds the library any more.
     bool UnloadDll(const std::string& path);
     
     // Unload all DLLs
     void UnloadAll();
     
-    // Hot reload - unload and reload a DLL
+    // Hot reload. For DLLs exporting V8Manifest or V8NativeFunctions the new
+    // build is loaded next to the old one and every function is swapped in
+    // place, in every isolate, so JS references taken before the reload call
+    // the new code. DLLs that only export RegisterV8Functions are unloaded
+    // and loaded again, which needs this loader to be their only user.
     bool ReloadDll(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context);
     
     // Get loaded DLL names
     std::vector<std::string> GetLoadedDlls() const;
+    
+    // Number of loaders holding the library at `path` (0 if not loaded)
+    static uint32_t GetRefCount(const std::string& path);
+    
+    // How long unload/reload waits for calls into the old library to return
+    // before deferring its dlclose
+    static constexpr std::chrono::milliseconds kDrainTimeout{1000};
 
 private:
+    // One mapped copy of a DLL. `calls` counts native calls in flight
+    // through its functions (and registrations reading its tables); it is
+    // only closed once that drops to zero.
+    struct Library {
+        void* handle = nullptr;
+        std::string copyPath;  // temporary copy made for a reload, removed on close
+        std::atomic<uint32_t> calls{0};
+    };
+    
+    // What a trampoline currently dispatches to
+    struct Target {
+        const v8integration::binding::NativeFunction* function;
+        Library* library;
+    };
+    
+    struct FunctionSlot;
+    
+    // A library shared by every loader that loaded its canonical path
+    struct SharedDll {
+        std::string path;
+        Library* library = nullptr;  // current build, nullptr once unloaded
+        uint32_t refs = 0;
+        bool swappable = false;      // exports V8Manifest or V8NativeFunctions
+        std::vector<FunctionSlot*> slots;
+    };
+    
+    // The indirection JS functions hold on to: one per library and function
+    // name, shared by all isolates and never freed, so trampolines never
+    // dangle. `bound` slots follow every load, reload and unload.
+    struct FunctionSlot {
+        SharedDll* dll;
+        std::string name;
+        std::string symbol;  // NativeResolver from the manifest; empty for V8NativeFunctions
+        std::atomic<const Target*> target{nullptr};
+        bool bound = false;
+    };
+    
+    // This loader's registrations
     struct DllHandle {
-        void* handle;
+        SharedDll* shared = nullptr;
         std::string path;
         std::vector<std::string> exportedFunctions;
+        std::unordered_set<std::string> installed;  // names already on this context's global
     };
     
+    class Registry;
+    
+    mutable std::mutex mutex_;
     std::unordered_map<std::string, std::unique_ptr<DllHandle>> loadedDlls_;
     
     // Platform-specific DLL loading
-    void* LoadLibrary(const std::string& path);
-    void FreeLibrary(void* handle);
-    void* GetSymbol(void* handle, const std::string& name);
+    static void* LoadLibrary(const std::string& path);
+    static void FreeLibrary(void* handle);
+    static void* GetSymbol(void* handle, const std::string& name);
+    
+    bool LoadLocked(const std::string& path, v8::Isolate* isolate, v8::Local<v8::Context> context);
+    bool UnloadLocked(const std::string& path);
     
     // Register DLL functions with V8
-    bool RegisterDllFunctions(void* handle, const std::string& dllName, 
-                            v8::Isolate* isolate, v8::Local<v8::Context> context);
-};
\ No newline at end of file
+    bool RegisterDllFunctions(DllHandle& dll, Library* library, v8::Isolate* isolate, v8::Local<v8::Context> context);
+    
+    // Install a null-terminated V8NativeFunctions table on the global object
+    bool RegisterNativeFunctions(const v8integration::binding::NativeFunction* table, DllHandle& dll,
+                                 v8::Isolate* isolate, v8::Local<v8::Context> context);
+    
+    // Install a lazy global per V8Manifest entry; the function is resolved
+    // and bound the first time its property is read
+    bool RegisterManifest(const v8integration::binding::ManifestEntry* manifest, DllHandle& dll,
+                          v8::Isolate* isolate, v8::Local<v8::Context> context);
+    
+    static v8::Local<v8::Function> NewTrampoline(FunctionSlot& slot, v8::Isolate* isolate,
+                                                 v8::Local<v8::Context> context);
+    static void CallThroughSlot(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void ResolveLazyFunction(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info);
+};
@@ -133,6 +133,7 @@ void V8Console::Shutdown() {
     
     // Clean up
     context_.Reset();
+    v8integration::binding::ReleaseIsolate(isolate_);
     isolate_->Dispose();
     isolate_ = nullptr;
     v8::V8::Dispose();
@@ -2253,7 +2254,7 @@ std::vector<std::string> V8Console::GetObjectProperties(const std::string& objec
         
         // Traverse the object hierarchy
         for (const auto& part : parts) {
-            v8::Local<v8::String> key = v8::String::NewFromUtf8(isolate_, part.c_str()).ToLocalChecked();
+            v8::Local<v8::String> key = v8integration::binding::Intern(isolate_, part);
             v8::Local<v8::Value> value;
             
             if (!obj->Get(context, key).ToLocal(&value) || !value->IsObject()) {
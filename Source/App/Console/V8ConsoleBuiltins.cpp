@@ -1,4 +1,5 @@
 #include "V8Console.h"
+#include "V8Binding.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -10,6 +11,8 @@
 #include <unistd.h>
 #include <rang/rang.hpp>
 
+namespace binding = v8integration::binding;
+
 // Static member function definitions for built-in functions
 
 void V8Console::Print(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -296,18 +299,18 @@ void V8Console::SystemInfo(const v8::FunctionCallbackInfo<v8::Value>& args) {
     // Get system information
     struct utsname sysinfo;
     if (uname(&sysinfo) == 0) {
-        info->Set(context, v8::String::NewFromUtf8(isolate, "system").ToLocalChecked(),
+        info->Set(context, binding::Intern<"system">(isolate),
                  v8::String::NewFromUtf8(isolate, sysinfo.sysname).ToLocalChecked()).Check();
-        info->Set(context, v8::String::NewFromUtf8(isolate, "hostname").ToLocalChecked(),
+        info->Set(context, binding::Intern<"hostname">(isolate),
                  v8::String::NewFromUtf8(isolate, sysinfo.nodename).ToLocalChecked()).Check();
-        info->Set(context, v8::String::NewFromUtf8(isolate, "release").ToLocalChecked(),
+        info->Set(context, binding::Intern<"release">(isolate),
                  v8::String::NewFromUtf8(isolate, sysinfo.release).ToLocalChecked()).Check();
-        info->Set(context, v8::String::NewFromUtf8(isolate, "machine").ToLocalChecked(),
+        info->Set(context, binding::Intern<"machine">(isolate),
                  v8::String::NewFromUtf8(isolate, sysinfo.machine).ToLocalChecked()).Check();
     }
     
     // Add process ID
-    info->Set(context, v8::String::NewFromUtf8(isolate, "pid").ToLocalChecked(),
+    info->Set(context, binding::Intern<"pid">(isolate),
              v8::Integer::New(isolate, getpid())).Check();
     
     args.GetReturnValue().Set(info);
@@ -337,84 +340,84 @@ void V8Console::RegisterBuiltins(v8::Local<v8::Context> context) {
     
     // Register global functions
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "print").ToLocalChecked(),
+        binding::Intern<"print">(isolate),
         v8::Function::New(context, Print, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "load").ToLocalChecked(),
+        binding::Intern<"load">(isolate),
         v8::Function::New(context, Load, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "loadDll").ToLocalChecked(),
+        binding::Intern<"loadDll">(isolate),
         v8::Function::New(context, LoadDll, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "unloadDll").ToLocalChecked(),
+        binding::Intern<"unloadDll">(isolate),
         v8::Function::New(context, UnloadDll, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "reloadDll").ToLocalChecked(),
+        binding::Intern<"reloadDll">(isolate),
         v8::Function::New(context, ReloadDll, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "listDlls").ToLocalChecked(),
+        binding::Intern<"listDlls">(isolate),
         v8::Function::New(context, ListDlls, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "quit").ToLocalChecked(),
+        binding::Intern<"quit">(isolate),
         v8::Function::New(context, Quit, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "help").ToLocalChecked(),
+        binding::Intern<"help">(isolate),
         v8::Function::New(context, Help, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "getDate").ToLocalChecked(),
+        binding::Intern<"getDate">(isolate),
         v8::Function::New(context, GetDate, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "fetch").ToLocalChecked(),
+        binding::Intern<"fetch">(isolate),
         v8::Function::New(context, Fetch, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "uuid").ToLocalChecked(),
+        binding::Intern<"uuid">(isolate),
         v8::Function::New(context, GenerateUUID, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "hash").ToLocalChecked(),
+        binding::Intern<"hash">(isolate),
         v8::Function::New(context, Hash, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "readFile").ToLocalChecked(),
+        binding::Intern<"readFile">(isolate),
         v8::Function::New(context, ReadFile, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "writeFile").ToLocalChecked(),
+        binding::Intern<"writeFile">(isolate),
         v8::Function::New(context, WriteFile, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "systemInfo").ToLocalChecked(),
+        binding::Intern<"systemInfo">(isolate),
         v8::Function::New(context, SystemInfo, external).ToLocalChecked()).Check();
         
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "sleep").ToLocalChecked(),
+        binding::Intern<"sleep">(isolate),
         v8::Function::New(context, Sleep, external).ToLocalChecked()).Check();
     
     // Create console object
     v8::Local<v8::Object> console = v8::Object::New(isolate);
     global->Set(context,
-        v8::String::NewFromUtf8(isolate, "console").ToLocalChecked(),
+        binding::Intern<"console">(isolate),
         console).Check();
         
     console->Set(context,
-        v8::String::NewFromUtf8(isolate, "log").ToLocalChecked(),
+        binding::Intern<"log">(isolate),
         v8::Function::New(context, ConsoleLog, external).ToLocalChecked()).Check();
         
     console->Set(context,
-        v8::String::NewFromUtf8(isolate, "error").ToLocalChecked(),
+        binding::Intern<"error">(isolate),
         v8::Function::New(context, ConsoleError, external).ToLocalChecked()).Check();
         
     console->Set(context,
-        v8::String::NewFromUtf8(isolate, "warn").ToLocalChecked(),
+        binding::Intern<"warn">(isolate),
         v8::Function::New(context, ConsoleWarn, external).ToLocalChecked()).Check();
 }
\ No newline at end of file
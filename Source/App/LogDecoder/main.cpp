@@ -0,0 +1,155 @@
+#include "V8Integration/BinaryLog.h"
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using v8_integration::BinaryLogReader;
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--json] <file> [file...]\n"
+              << "Decodes binary logs written by Logger::enableBinaryLogging().\n"
+              << "Rotated files (log.1, log.2, ...) can be passed oldest first.\n"
+              << "\n"
+              << "  --json    emit one JSON object per line instead of text\n"
+              << "  --help    show this message\n";
+}
+
+std::string formatTimestamp(std::chrono::system_clock::time_point timestamp) {
+    auto time_t = std::chrono::system_clock::to_time_t(timestamp);
+    std::tm local_tm{};
+    localtime_r(&time_t, &local_tm);
+
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local_tm);
+
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        timestamp.time_since_epoch()).count() % 1000000;
+    char fraction[8];
+    std::snprintf(fraction, sizeof(fraction), ".%06lld", static_cast<long long>(micros));
+    return std::string(buffer) + fraction;
+}
+
+std::string jsonEscape(const std::string& value) {
+    std::string result;
+    result.reserve(value.size() + 2);
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    result += escaped;
+                } else {
+                    result += static_cast<char>(c);
+                }
+        }
+    }
+    return result;
+}
+
+std::string jsonValue(const BinaryLogReader::Value& value) {
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        return "\"" + jsonEscape(*text) + "\"";
+    }
+    if (const auto* number = std::get_if<double>(&value)) {
+        if (!std::isfinite(*number)) {
+            return "null";  // NaN and infinity have no JSON representation
+        }
+    }
+    return BinaryLogReader::valueToString(value);
+}
+
+void printText(const BinaryLogReader::Record& record) {
+    std::cout << formatTimestamp(record.timestamp)
+              << " [" << BinaryLogReader::levelName(record.level) << "] ";
+    if (!record.file.empty()) {
+        std::cout << "(" << record.file << ":" << record.line;
+        if (!record.function.empty()) {
+            std::cout << " in " << record.function;
+        }
+        std::cout << ") ";
+    }
+    std::cout << BinaryLogReader::render(record.format, record.args) << "\n";
+}
+
+void printJson(const BinaryLogReader::Record& record) {
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        record.timestamp.time_since_epoch()).count();
+
+    std::cout << "{\"timestamp\":\"" << formatTimestamp(record.timestamp) << "\""
+              << ",\"timestamp_ns\":" << nanos
+              << ",\"level\":\"" << BinaryLogReader::levelName(record.level) << "\""
+              << ",\"file\":\"" << jsonEscape(record.file) << "\""
+              << ",\"line\":" << record.line
+              << ",\"function\":\"" << jsonEscape(record.function) << "\""
+              << ",\"format\":\"" << jsonEscape(record.format) << "\""
+              << ",\"args\":[";
+    for (size_t i = 0; i < record.args.size(); ++i) {
+        if (i > 0) std::cout << ",";
+        std::cout << jsonValue(record.args[i]);
+    }
+    std::cout << "],\"message\":\""
+              << jsonEscape(BinaryLogReader::render(record.format, record.args)) << "\"}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int status = 0;
+    for (const auto& path : files) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            std::cerr << path << ": cannot open file\n";
+            status = 1;
+            continue;
+        }
+
+        BinaryLogReader reader(input);
+        BinaryLogReader::Record record;
+        while (reader.next(record)) {
+            if (json) {
+                printJson(record);
+            } else {
+                printText(record);
+            }
+        }
+
+        if (!reader.error().empty()) {
+            std::cerr << path << ": " << reader.error() << "\n";
+            status = 1;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,354 @@
+#include "V8Integration/BinaryLog.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace v8_integration {
+
+// BinaryLogWriter implementation
+BinaryLogWriter::BinaryLogWriter(const Config& config) : config_(config) {
+    if (config_.max_files == 0) {
+        config_.max_files = 1;
+    }
+    openFile();
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stream_.is_open()) {
+        stream_.flush();
+    }
+}
+
+bool BinaryLogWriter::isOpen() const {
+    return stream_.is_open();
+}
+
+void BinaryLogWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stream_.is_open()) {
+        stream_.flush();
+    }
+}
+
+std::string& BinaryLogWriter::argBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+void BinaryLogWriter::writeRecord(uint8_t level, std::string_view format, std::string_view file,
+                                  int line, std::string_view function, bool literal,
+                                  uint8_t arg_count, const std::string& payload) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stream_.is_open()) return;
+
+    size_t record_size = 1 + sizeof(int64_t) + 1 + 2 * sizeof(uint32_t) + 1 + payload.size();
+    if (file_size_ + record_size > config_.max_file_size && file_size_ > 0) {
+        rotate();
+        if (!stream_.is_open()) return;
+    }
+
+    // Definitions for ids not yet seen in this file go out ahead of the record
+    entry_.clear();
+    uint32_t format_id = internFormat(format, literal);
+    uint32_t location_id = internLocation(file, line, function, literal);
+
+    entry_.push_back(static_cast<char>(binlog::EntryType::Record));
+    binlog::appendRaw<int64_t>(entry_, static_cast<int64_t>(timestamp));
+    entry_.push_back(static_cast<char>(level));
+    binlog::appendRaw<uint32_t>(entry_, format_id);
+    binlog::appendRaw<uint32_t>(entry_, location_id);
+    entry_.push_back(static_cast<char>(arg_count));
+    entry_ += payload;
+
+    stream_.write(entry_.data(), static_cast<std::streamsize>(entry_.size()));
+    file_size_ += entry_.size();
+}
+
+uint32_t BinaryLogWriter::internFormat(std::string_view format, bool literal) {
+    uint32_t id;
+    auto literal_it = literal ? literal_format_ids_.find(format.data()) : literal_format_ids_.end();
+    if (literal_it != literal_format_ids_.end()) {
+        id = literal_it->second;
+    } else {
+        auto it = format_ids_.find(format);
+        if (it != format_ids_.end()) {
+            id = it->second;
+        } else {
+            id = static_cast<uint32_t>(formats_.size());
+            formats_.emplace_back(format);
+            format_ids_.emplace(formats_.back(), id);
+            format_emitted_.push_back(false);
+        }
+        if (literal) {
+            literal_format_ids_.emplace(format.data(), id);
+        }
+    }
+
+    if (!format_emitted_[id]) {
+        entry_.push_back(static_cast<char>(binlog::EntryType::Format));
+        binlog::appendRaw<uint32_t>(entry_, id);
+        binlog::appendString(entry_, formats_[id]);
+        format_emitted_[id] = true;
+    }
+    return id;
+}
+
+uint32_t BinaryLogWriter::internLocation(std::string_view file, int line, std::string_view function,
+                                         bool literal) {
+    uint32_t id;
+    LocationKey literal_key{file.data(), line};
+    auto literal_it = literal ? literal_location_ids_.find(literal_key) : literal_location_ids_.end();
+    if (literal_it != literal_location_ids_.end()) {
+        id = literal_it->second;
+    } else {
+        std::string key;
+        key.reserve(file.size() + function.size() + 16);
+        key.append(file).append(1, '\0').append(std::to_string(line)).append(1, '\0').append(function);
+
+        auto it = location_ids_.find(key);
+        if (it != location_ids_.end()) {
+            id = it->second;
+        } else {
+            id = static_cast<uint32_t>(locations_.size());
+            locations_.push_back({std::string(file), line, std::string(function)});
+            location_ids_.emplace(std::move(key), id);
+            location_emitted_.push_back(false);
+        }
+        if (literal) {
+            literal_location_ids_.emplace(literal_key, id);
+        }
+    }
+
+    if (!location_emitted_[id]) {
+        const Location& location = locations_[id];
+        entry_.push_back(static_cast<char>(binlog::EntryType::Location));
+        binlog::appendRaw<uint32_t>(entry_, id);
+        binlog::appendRaw<int32_t>(entry_, location.line);
+        binlog::appendString(entry_, location.file);
+        binlog::appendString(entry_, location.function);
+        location_emitted_[id] = true;
+    }
+    return id;
+}
+
+void BinaryLogWriter::openFile() {
+    stream_.open(config_.path, std::ios::binary | std::ios::trunc);
+    file_size_ = 0;
+    if (!stream_.is_open()) return;
+
+    std::string header(binlog::kMagic, sizeof(binlog::kMagic));
+    binlog::appendRaw<uint16_t>(header, binlog::kVersion);
+    binlog::appendRaw<uint32_t>(header, binlog::kByteOrderMark);
+    stream_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file_size_ = header.size();
+}
+
+void BinaryLogWriter::rotate() {
+    stream_.close();
+
+    // path.(n-2) -> path.(n-1), ..., path -> path.1; the oldest is overwritten
+    for (size_t i = config_.max_files - 1; i > 0; --i) {
+        std::string from = i == 1 ? config_.path : config_.path + "." + std::to_string(i - 1);
+        std::string to = config_.path + "." + std::to_string(i);
+        std::rename(from.c_str(), to.c_str());
+    }
+
+    // Each file carries its own definitions
+    format_emitted_.assign(format_emitted_.size(), false);
+    location_emitted_.assign(location_emitted_.size(), false);
+    openFile();
+}
+
+// BinaryLogReader implementation
+BinaryLogReader::BinaryLogReader(std::istream& input) : input_(input) {
+}
+
+bool BinaryLogReader::fail(const std::string& message) {
+    error_ = message;
+    return false;
+}
+
+bool BinaryLogReader::readString(std::string& value) {
+    uint32_t size;
+    if (!readRaw(size)) return false;
+
+    // Grown as bytes arrive instead of sized from the prefix up front, so a
+    // corrupt length reads as a truncated entry rather than a huge allocation
+    constexpr size_t kChunk = 64 * 1024;
+    value.clear();
+    while (value.size() < size) {
+        size_t offset = value.size();
+        size_t chunk = std::min<size_t>(kChunk, size - offset);
+        value.resize(offset + chunk);
+        if (!input_.read(value.data() + offset, static_cast<std::streamsize>(chunk))) return false;
+    }
+    return true;
+}
+
+bool BinaryLogReader::readHeader() {
+    char magic[sizeof(binlog::kMagic)];
+    uint16_t version;
+    uint32_t byte_order;
+    if (!input_.read(magic, sizeof(magic)) || std::memcmp(magic, binlog::kMagic, sizeof(magic)) != 0) {
+        return fail("not a binary log file");
+    }
+    if (!readRaw(version) || !readRaw(byte_order)) {
+        return fail("truncated header");
+    }
+    if (byte_order != binlog::kByteOrderMark) {
+        return fail("log was written on a host with a different byte order");
+    }
+    if (version != binlog::kVersion) {
+        return fail("unsupported format version " + std::to_string(version));
+    }
+    header_read_ = true;
+    return true;
+}
+
+bool BinaryLogReader::next(Record& record) {
+    if (!error_.empty()) return false;
+    if (!header_read_ && !readHeader()) return false;
+
+    for (;;) {
+        char type;
+        if (!input_.get(type)) {
+            return false;  // clean end of input
+        }
+
+        switch (static_cast<binlog::EntryType>(type)) {
+            case binlog::EntryType::Format: {
+                uint32_t id;
+                std::string format;
+                if (!readRaw(id) || !readString(format)) return fail("truncated format entry");
+                formats_[id] = std::move(format);
+                break;
+            }
+            case binlog::EntryType::Location: {
+                uint32_t id;
+                int32_t line;
+                std::string file, function;
+                if (!readRaw(id) || !readRaw(line) || !readString(file) || !readString(function)) {
+                    return fail("truncated location entry");
+                }
+                locations_[id] = {std::move(file), line, std::move(function)};
+                break;
+            }
+            case binlog::EntryType::Record: {
+                int64_t timestamp;
+                uint8_t level, arg_count;
+                uint32_t format_id, location_id;
+                if (!readRaw(timestamp) || !readRaw(level) || !readRaw(format_id) ||
+                    !readRaw(location_id) || !readRaw(arg_count)) {
+                    return fail("truncated record");
+                }
+
+                auto format_it = formats_.find(format_id);
+                auto location_it = locations_.find(location_id);
+                if (format_it == formats_.end() || location_it == locations_.end()) {
+                    return fail("record references an undefined format or location");
+                }
+
+                record.timestamp = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::nanoseconds(timestamp)));
+                record.level = level;
+                record.format = format_it->second;
+                std::tie(record.file, record.line, record.function) = location_it->second;
+                record.args.clear();
+
+                for (uint8_t i = 0; i < arg_count; ++i) {
+                    uint8_t arg_type;
+                    if (!readRaw(arg_type)) return fail("truncated argument");
+                    bool ok = false;
+                    switch (static_cast<binlog::ArgType>(arg_type)) {
+                        case binlog::ArgType::Int: { int64_t v; ok = readRaw(v); record.args.emplace_back(v); break; }
+                        case binlog::ArgType::UInt: { uint64_t v; ok = readRaw(v); record.args.emplace_back(v); break; }
+                        case binlog::ArgType::Double: { double v; ok = readRaw(v); record.args.emplace_back(v); break; }
+                        case binlog::ArgType::Bool: { uint8_t v; ok = readRaw(v); record.args.emplace_back(v != 0); break; }
+                        case binlog::ArgType::String: { std::string v; ok = readString(v); record.args.emplace_back(std::move(v)); break; }
+                        default: return fail("unknown argument type " + std::to_string(arg_type));
+                    }
+                    if (!ok) return fail("truncated argument");
+                }
+                return true;
+            }
+            default:
+                return fail("unknown entry type");
+        }
+    }
+}
+
+std::string BinaryLogReader::valueToString(const Value& value) {
+    return std::visit([](const auto& v) -> std::string {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::string>) {
+            return v;
+        } else if constexpr (std::is_same_v<V, bool>) {
+            return v ? "true" : "false";
+        } else {
+            return std::format("{}", v);
+        }
+    }, value);
+}
+
+std::string BinaryLogReader::render(const std::string& format, const std::vector<Value>& args) {
+    std::string result;
+    result.reserve(format.size() + args.size() * 8);
+    size_t next_arg = 0;
+
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            result += c;
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            result += c;
+            continue;
+        }
+
+        size_t close = format.find('}', i);
+        if (close == std::string::npos) {
+            result.append(format, i, std::string::npos);
+            break;
+        }
+
+        // "{}", "{N}", "{:spec}" or "{N:spec}"
+        std::string field = format.substr(i + 1, close - i - 1);
+        size_t colon = field.find(':');
+        std::string index = field.substr(0, colon);
+        std::string spec = colon == std::string::npos ? "" : field.substr(colon);
+        size_t arg_index = index.empty() ? next_arg++ : std::strtoul(index.c_str(), nullptr, 10);
+
+        if (arg_index < args.size()) {
+            if (spec.empty()) {
+                result += valueToString(args[arg_index]);
+            } else {
+                try {
+                    std::string field_format = "{" + spec + "}";
+                    result += std::visit([&](const auto& v) {
+                        return std::vformat(field_format, std::make_format_args(v));
+                    }, args[arg_index]);
+                } catch (const std::format_error&) {
+                    result += valueToString(args[arg_index]);
+                }
+            }
+        } else {
+            result.append(format, i, close - i + 1);
+        }
+        i = close;
+    }
+    return result;
+}
+
+const char* BinaryLogReader::levelName(uint8_t level) {
+    static const char* names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    return level < 6 ? names[level] : "UNKNOWN";
+}
+
+} // namespace v8_integration
@@ -1,78 +1,261 @@
 #include <v8.h>
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
+#include "V8Binding.h"
 
 using namespace v8;
 
-// Calculate the sum of the first N Fibonacci numbers
+namespace binding = v8integration::binding;
+
+// Every function here returns the sum of the first N Fibonacci numbers
 // fib(0) = 0, fib(1) = 1, fib(2) = 1, fib(3) = 2, ...
-// Returns the sum: fib(0) + fib(1) + ... + fib(N-1)
-long long calculateFibSum(int n) {
-    if (n <= 0) return 0;
-    if (n == 1) return 0;  // Only fib(0) = 0
-    if (n == 2) return 1;  // fib(0) + fib(1) = 0 + 1 = 1
-    
-    long long prev2 = 0;  // fib(0)
-    long long prev1 = 1;  // fib(1)
-    long long sum = 1;    // sum of fib(0) + fib(1)
-    
-    for (int i = 2; i < n; i++) {
-        long long current = prev1 + prev2;
-        sum += current;
-        prev2 = prev1;
-        prev1 = current;
+// i.e. fib(0) + fib(1) + ... + fib(N-1), which is fib(N+1) - 1.
+
+// Largest N whose sum fits in a long long
+constexpr uint32_t kMaxFibSumIndex = 91;
+
+// Largest N whose sum is exact as a JS Number (at most 2^53 - 1)
+constexpr uint32_t kMaxSafeFibSumIndex = 77;
+
+// Largest N fibBig accepts; the result has about 0.69 * N bits
+constexpr uint32_t kMaxBigFibIndex = 1u << 20;
+
+// fib(0) .. fib(kMaxFibSumIndex + 1), computed at compile time
+constexpr auto kFibTable = [] {
+    std::array<uint64_t, kMaxFibSumIndex + 2> table{};
+    table[1] = 1;
+    for (size_t i = 2; i < table.size(); ++i) {
+        table[i] = table[i - 1] + table[i - 2];
     }
-    
-    return sum;
+    return table;
+}();
+
+// Bound directly; the binding layer rejects missing, non-numeric, negative
+// and too large arguments (past kMaxSafeFibSumIndex the Number would be
+// rounded; fibBig and fibBatch give exact results)
+long long calculateFibSum(binding::InRange<uint32_t, 0, kMaxSafeFibSumIndex> n) {
+    return static_cast<long long>(kFibTable[n + 1] - 1);
 }
 
-// V8 wrapper function that can be called from JavaScript
-void Fib(const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    
-    // Check if we have the right number of arguments
-    if (args.Length() < 1) {
-        isolate->ThrowException(Exception::TypeError(
-            String::NewFromUtf8(isolate, "Wrong number of arguments. Expected 1 argument.").ToLocalChecked()));
-        return;
+// Unsigned arbitrary-precision integer, just enough for fast doubling:
+// little-endian 64-bit words without leading zeros
+struct BigNat {
+    __extension__ typedef unsigned __int128 Wide;
+
+    std::vector<uint64_t> words;
+
+    static BigNat From(uint64_t value) {
+        BigNat result;
+        if (value) result.words.push_back(value);
+        return result;
+    }
+
+    friend BigNat operator+(const BigNat& a, const BigNat& b) {
+        const BigNat& longer = a.words.size() >= b.words.size() ? a : b;
+        const BigNat& shorter = &longer == &a ? b : a;
+        BigNat result;
+        result.words.resize(longer.words.size() + 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.words.size(); ++i) {
+            Wide sum = static_cast<Wide>(longer.words[i]) + carry +
+                       (i < shorter.words.size() ? shorter.words[i] : 0);
+            result.words[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        result.words.back() = carry;
+        result.Trim();
+        return result;
+    }
+
+    // Requires a >= b
+    friend BigNat operator-(const BigNat& a, const BigNat& b) {
+        BigNat result;
+        result.words.resize(a.words.size());
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < a.words.size(); ++i) {
+            uint64_t subtrahend = i < b.words.size() ? b.words[i] : 0;
+            uint64_t difference = a.words[i] - subtrahend - borrow;
+            borrow = (a.words[i] < subtrahend || (a.words[i] == subtrahend && borrow)) ? 1 : 0;
+            result.words[i] = difference;
+        }
+        result.Trim();
+        return result;
+    }
+
+    friend BigNat operator*(const BigNat& a, const BigNat& b) {
+        BigNat result;
+        if (a.words.empty() || b.words.empty()) return result;
+        result.words.assign(a.words.size() + b.words.size(), 0);
+        for (size_t i = 0; i < a.words.size(); ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.words.size(); ++j) {
+                Wide product = static_cast<Wide>(a.words[i]) * b.words[j] + result.words[i + j] + carry;
+                result.words[i + j] = static_cast<uint64_t>(product);
+                carry = static_cast<uint64_t>(product >> 64);
+            }
+            result.words[i + b.words.size()] = carry;
+        }
+        result.Trim();
+        return result;
+    }
+
+private:
+    void Trim() {
+        while (!words.empty() && words.back() == 0) {
+            words.pop_back();
+        }
+    }
+};
+
+// (fib(n), fib(n+1)) by fast doubling, O(log n) big multiplications:
+//   fib(2k)   = fib(k) * (2 fib(k+1) - fib(k))
+//   fib(2k+1) = fib(k)^2 + fib(k+1)^2
+// starting from the table once the remaining prefix of n fits in it
+std::pair<BigNat, BigNat> FibPair(uint32_t n) {
+    int bit = 31;
+    while (bit >= 0 && (n >> bit) == 0) --bit;
+    while (bit >= 0 && (n >> bit) + 1 < kFibTable.size()) --bit;
+
+    uint32_t k = n >> (bit + 1);
+    BigNat a = BigNat::From(kFibTable[k]);
+    BigNat b = BigNat::From(kFibTable[k + 1]);
+    for (; bit >= 0; --bit) {
+        BigNat even = a * (b + b - a);
+        BigNat odd = a * a + b * b;
+        if ((n >> bit) & 1) {
+            a = odd;
+            b = even + odd;
+        } else {
+            a = std::move(even);
+            b = std::move(odd);
+        }
     }
-    
-    // Check if the argument is a number
-    if (!args[0]->IsNumber()) {
+    return {std::move(a), std::move(b)};
+}
+
+// Results of recent fibBig calls. Shared by every isolate using the DLL,
+// so it is locked; cleared rather than evicted entry by entry when full.
+class BigFibCache {
+public:
+    static constexpr size_t kMaxEntries = 256;
+
+    std::shared_ptr<const BigNat> Get(uint32_t n) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(n);
+            if (it != entries_.end()) return it->second;
+        }
+
+        // Computed outside the lock; racing callers just compute it twice
+        auto sum = std::make_shared<const BigNat>(FibPair(n).second - BigNat::From(1));
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.size() >= kMaxEntries) {
+            entries_.clear();
+        }
+        entries_.emplace(n, sum);
+        return sum;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<const BigNat>> entries_;
+};
+
+BigFibCache& Cache() {
+    static BigFibCache* cache = new BigFibCache();
+    return *cache;
+}
+
+// Results become BigInts
+template <>
+struct v8integration::binding::Converter<std::shared_ptr<const BigNat>> {
+    static Local<Value> ToV8(Isolate* isolate, const std::shared_ptr<const BigNat>& value) {
+        if (value->words.empty()) return BigInt::New(isolate, 0);
+        return BigInt::NewFromWords(isolate->GetCurrentContext(), 0, static_cast<int>(value->words.size()),
+                                    value->words.data()).ToLocalChecked();
+    }
+};
+
+// fibBig(n): the exact sum as a BigInt, for any n up to kMaxBigFibIndex
+std::shared_ptr<const BigNat> calculateBigFibSum(binding::InRange<uint32_t, 0, kMaxBigFibIndex> n) {
+    if (n <= kMaxFibSumIndex) {
+        return std::make_shared<const BigNat>(BigNat::From(kFibTable[n + 1] - 1));
+    }
+    return Cache().Get(n);
+}
+
+// fibBatch(Int32Array) -> BigInt64Array of fib(n) for every element, in
+// one call
+void FibBatch(const FunctionCallbackInfo<Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    if (!args[0]->IsInt32Array()) {
         isolate->ThrowException(Exception::TypeError(
-            String::NewFromUtf8(isolate, "Argument must be a number").ToLocalChecked()));
+            String::NewFromUtf8Literal(isolate, "Argument 1 must be an Int32Array")));
         return;
     }
-    
-    // Get the number value
-    int n = args[0]->Int32Value(isolate->GetCurrentContext()).FromMaybe(0);
-    
-    // Validate input
-    if (n < 0) {
-        isolate->ThrowException(Exception::RangeError(
-            String::NewFromUtf8(isolate, "Argument must be non-negative").ToLocalChecked()));
-        return;
+
+    std::span<const int32_t> ns = binding::ViewTypedArray<const int32_t>(args[0]);
+    binding::TypedArrayBuilder<int64_t> result(isolate, ns.size());
+    std::span<int64_t> sums = result.span();
+    for (size_t i = 0; i < ns.size(); ++i) {
+        int32_t n = ns[i];
+        if (n < 0 || static_cast<uint32_t>(n) > kMaxFibSumIndex) {
+            std::string message = "Element " + std::to_string(i) + " (" + std::to_string(n) +
+                                  ") is out of range 0.." + std::to_string(kMaxFibSumIndex);
+            isolate->ThrowException(Exception::RangeError(
+                String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked()));
+            return;
+        }
+        sums[i] = static_cast<int64_t>(kFibTable[n + 1] - 1);
     }
-    
-    // Calculate the sum
-    long long result = calculateFibSum(n);
-    
-    // Return the result
-    args.GetReturnValue().Set(Number::New(isolate, static_cast<double>(result)));
+    args.GetReturnValue().Set(result.Finish());
 }
 
-// Export the initialization function that v8console expects
+// Exported functions: (JS name, C++ function). Generates one v8native_<name>
+// resolver per function plus the V8Manifest that DllLoader reads on load
+#define FIB_FUNCTIONS(X)              \
+    X(fib, calculateFibSum)           \
+    X(fibBig, calculateBigFibSum)     \
+    X(fibBatch, FibBatch)
+
+FIB_FUNCTIONS(V8_NATIVE_EXPORT)
+V8_MANIFEST(FIB_FUNCTIONS)
+
+// Native function table for hosts that predate the manifest
+static const v8integration::binding::NativeFunction kNativeFunctions[] = {
+    v8integration::binding::Native<&calculateFibSum>("fib"),
+    v8integration::binding::Native<&calculateBigFibSum>("fibBig"),
+    v8integration::binding::Native<&FibBatch>("fibBatch"),
+    {nullptr, nullptr, nullptr}
+};
+
 extern "C" {
+    const v8integration::binding::NativeFunction* V8NativeFunctions() {
+        return kNativeFunctions;
+    }
+
+    // Export the initialization function that v8console expects
     void RegisterV8Functions(Isolate* isolate, Local<Context> context) {
         // Get the global object
         Local<Object> global = context->Global();
-        
-        // Add the fib function to the global object
-        global->Set(context,
-            String::NewFromUtf8(isolate, "fib").ToLocalChecked(),
-            Function::New(context, Fib).ToLocalChecked()
-        ).FromJust();
-        
-        std::cout << "Fibonacci module loaded. Use fib(n) to calculate sum of first n Fibonacci numbers." << std::endl;
+
+        // Add the functions to the global object, with their fast paths
+        for (const auto* entry = kNativeFunctions; entry->name; ++entry) {
+            global->Set(context,
+                String::NewFromUtf8(isolate, entry->name).ToLocalChecked(),
+                v8integration::binding::NewFunctionTemplate(isolate, entry->callback, entry->fast)
+                    ->GetFunction(context).ToLocalChecked()
+            ).FromJust();
+        }
+
+        std::cout << "Fibonacci module loaded. Use fib(n) to calculate sum of first n Fibonacci numbers "
+                  << "(fibBig(n) for a BigInt, fibBatch(Int32Array) for many at once)." << std::endl;
     }
-}
\ No newline at end of file
+}
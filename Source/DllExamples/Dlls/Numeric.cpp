@@ -0,0 +1,602 @@
+#include <v8.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include "V8Binding.h"
+
+// Numeric kernels over Float64Array, Float32Array and Int32Array. Each call
+// crosses into native code once per array instead of once per element, and
+// runs AVX-512, AVX2 or scalar code depending on the CPU (NUMERIC_SIMD=avx2
+// or =scalar in the environment caps the level, for comparisons).
+//
+// Reductions (simdSum, simdDot) accumulate in double (int64 for Int32Array)
+// in several lanes at once, so floating-point results can differ from a
+// sequential JS loop in the last bits. Int32Array arithmetic wraps like
+// Math.imul; division truncates and x / 0 is 0, as when JS stores the
+// quotient into an Int32Array.
+
+namespace binding = v8integration::binding;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_X86_SIMD 1
+#else
+#define NUMERIC_X86_SIMD 0
+#endif
+
+namespace {
+
+enum class Op { kAdd, kSub, kMul, kDiv };
+
+// Reductions accumulate in a wider type than the elements
+template <typename T>
+using Acc = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+// Integer arithmetic is done unsigned so overflow wraps instead of being UB
+template <typename T, typename = void>
+struct WrappingOf {
+    using Type = T;
+};
+
+template <typename T>
+struct WrappingOf<T, std::enable_if_t<std::is_integral_v<T>>> {
+    using Type = std::make_unsigned_t<T>;
+};
+
+template <typename T>
+using Wrapping = typename WrappingOf<T>::Type;
+
+#if NUMERIC_X86_SIMD
+// Vectors are passed by value only between always-inlined helpers compiled
+// into the same per-target function, so GCC's note that this changes the
+// ABI without AVX enabled does not apply
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template <typename T, size_t Lanes>
+using Vec [[gnu::vector_size(Lanes * sizeof(T))]] = T;
+
+template <typename V, typename T>
+[[gnu::always_inline]] inline V Load(const T* data) {
+    V value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+template <typename V, typename T>
+[[gnu::always_inline]] inline void Store(T* data, const V& value) {
+    std::memcpy(data, &value, sizeof(value));
+}
+#endif
+
+template <Op op, typename V>
+[[gnu::always_inline]] inline V Apply(V a, V b) {
+    if constexpr (op == Op::kAdd) return a + b;
+    if constexpr (op == Op::kSub) return a - b;
+    if constexpr (op == Op::kMul) return a * b;
+    if constexpr (op == Op::kDiv) return a / b;
+}
+
+template <Op op, typename T>
+[[gnu::always_inline]] inline T ApplyOne(T a, T b) {
+    if constexpr (std::is_integral_v<T> && op == Op::kDiv) {
+        if (b == 0) return 0;
+        if (b == -1) return static_cast<T>(Wrapping<T>(0) - static_cast<Wrapping<T>>(a));
+        return a / b;
+    } else {
+        return static_cast<T>(Apply<op>(static_cast<Wrapping<T>>(a), static_cast<Wrapping<T>>(b)));
+    }
+}
+
+// Kernel bodies, written once against a lane count: Lanes == 1 is plain
+// scalar code, otherwise the main loop works on Lanes elements at a time
+// and a scalar loop handles the tail. They are force-inlined into the
+// per-ISA entry points below so each copy is compiled for its target.
+
+template <typename T, size_t Lanes>
+[[gnu::always_inline]] inline Acc<T> SumImpl(const T* data, size_t n) {
+    size_t i = 0;
+    Acc<T> total = 0;
+#if NUMERIC_X86_SIMD
+    if constexpr (Lanes > 1) {
+        using In = Vec<T, Lanes>;
+        using Out = Vec<Acc<T>, Lanes>;
+        // Two accumulators hide the latency of the adds
+        Out acc0 = {};
+        Out acc1 = {};
+        for (; i + 2 * Lanes <= n; i += 2 * Lanes) {
+            acc0 += __builtin_convertvector(Load<In>(data + i), Out);
+            acc1 += __builtin_convertvector(Load<In>(data + i + Lanes), Out);
+        }
+        acc0 += acc1;
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            total += acc0[lane];
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        total += data[i];
+    }
+    return total;
+}
+
+template <typename T, size_t Lanes>
+[[gnu::always_inline]] inline Acc<T> DotImpl(const T* a, const T* b, size_t n) {
+    size_t i = 0;
+    Acc<T> total = 0;
+#if NUMERIC_X86_SIMD
+    if constexpr (Lanes > 1) {
+        using In = Vec<T, Lanes>;
+        using Out = Vec<Acc<T>, Lanes>;
+        Out acc0 = {};
+        Out acc1 = {};
+        for (; i + 2 * Lanes <= n; i += 2 * Lanes) {
+            acc0 += __builtin_convertvector(Load<In>(a + i), Out) * __builtin_convertvector(Load<In>(b + i), Out);
+            acc1 += __builtin_convertvector(Load<In>(a + i + Lanes), Out) *
+                    __builtin_convertvector(Load<In>(b + i + Lanes), Out);
+        }
+        acc0 += acc1;
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            total += acc0[lane];
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        total += static_cast<Acc<T>>(a[i]) * static_cast<Acc<T>>(b[i]);
+    }
+    return total;
+}
+
+// n must be non-zero. `nan` reports whether any element was NaN, in which
+// case lo and hi are meaningless
+template <typename T, size_t Lanes>
+[[gnu::always_inline]] inline void MinMaxImpl(const T* data, size_t n, T& lo, T& hi, bool& nan) {
+    size_t i = 0;
+    lo = hi = data[0];
+    nan = false;
+#if NUMERIC_X86_SIMD
+    if constexpr (Lanes > 1) {
+        using V = Vec<T, Lanes>;
+        if (n >= Lanes) {
+            V vlo = Load<V>(data);
+            V vhi = vlo;
+            auto bad = vlo != vlo;
+            for (i = Lanes; i + Lanes <= n; i += Lanes) {
+                V value = Load<V>(data + i);
+                vlo = value < vlo ? value : vlo;
+                vhi = value > vhi ? value : vhi;
+                if constexpr (std::is_floating_point_v<T>) {
+                    bad |= value != value;
+                }
+            }
+            for (size_t lane = 0; lane < Lanes; ++lane) {
+                lo = vlo[lane] < lo ? vlo[lane] : lo;
+                hi = vhi[lane] > hi ? vhi[lane] : hi;
+                nan |= bad[lane] != 0;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        lo = data[i] < lo ? data[i] : lo;
+        hi = data[i] > hi ? data[i] : hi;
+        if constexpr (std::is_floating_point_v<T>) {
+            nan |= data[i] != data[i];
+        }
+    }
+}
+
+// b[0] is used for every element when kBroadcast. `out` may be `a` or `b`.
+template <typename T, size_t Lanes, Op op, bool kBroadcast>
+[[gnu::always_inline]] inline void ArithImpl(const T* a, const T* b, T* out, size_t n) {
+    size_t i = 0;
+#if NUMERIC_X86_SIMD
+    // x86 has no vector integer division
+    if constexpr (Lanes > 1 && !(std::is_integral_v<T> && op == Op::kDiv)) {
+        using W = Wrapping<T>;
+        using V = Vec<W, Lanes>;
+        V vb = {};
+        if constexpr (kBroadcast) {
+            vb += static_cast<W>(b[0]);
+        }
+        for (; i + Lanes <= n; i += Lanes) {
+            if constexpr (!kBroadcast) {
+                vb = Load<V>(b + i);
+            }
+            Store(out + i, Apply<op>(Load<V>(a + i), vb));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = ApplyOne<op>(a[i], b[kBroadcast ? 0 : i]);
+    }
+}
+
+// A sequential dependency, so no lanes; compiled per target all the same
+template <typename T>
+[[gnu::always_inline]] inline void PrefixSumImpl(const T* data, T* out, size_t n) {
+    Acc<T> total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += data[i];
+        out[i] = static_cast<T>(total);
+    }
+}
+
+// Uniform bins over [lo, hi]; hi itself falls in the last bin, values
+// outside the range and NaNs are not counted
+template <typename T>
+[[gnu::always_inline]] inline void HistogramImpl(const T* data, size_t n, double lo, double hi, uint32_t* counts,
+                                                 size_t bins) {
+    double scale = hi > lo ? static_cast<double>(bins) / (hi - lo) : 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double value = static_cast<double>(data[i]);
+        if (!(value >= lo && value <= hi)) continue;
+        size_t bin = static_cast<size_t>((value - lo) * scale);
+        counts[bin < bins ? bin : bins - 1]++;
+    }
+}
+
+// One set of entry points per instruction set. Attributes is the target
+// attribute the copy is compiled with; VectorBytes the register width
+// (0 for scalar code).
+#define NUMERIC_KERNELS(Name, Attributes, VectorBytes)                                              \
+    struct Name {                                                                                   \
+        template <typename T>                                                                       \
+        static constexpr size_t kLanes = VectorBytes ? VectorBytes / sizeof(T) : 1;                 \
+                                                                                                    \
+        template <typename T>                                                                       \
+        Attributes static Acc<T> Sum(const T* data, size_t n) {                                     \
+            return SumImpl<T, kLanes<T>>(data, n);                                                  \
+        }                                                                                           \
+        template <typename T>                                                                       \
+        Attributes static Acc<T> Dot(const T* a, const T* b, size_t n) {                            \
+            return DotImpl<T, kLanes<T>>(a, b, n);                                                  \
+        }                                                                                           \
+        template <typename T>                                                                       \
+        Attributes static void MinMax(const T* data, size_t n, T& lo, T& hi, bool& nan) {           \
+            MinMaxImpl<T, kLanes<T>>(data, n, lo, hi, nan);                                         \
+        }                                                                                           \
+        template <typename T, Op op, bool kBroadcast>                                               \
+        Attributes static void Arith(const T* a, const T* b, T* out, size_t n) {                    \
+            ArithImpl<T, kLanes<T>, op, kBroadcast>(a, b, out, n);                                  \
+        }                                                                                           \
+        template <typename T>                                                                       \
+        Attributes static void PrefixSum(const T* data, T* out, size_t n) {                         \
+            PrefixSumImpl(data, out, n);                                                            \
+        }                                                                                           \
+        template <typename T>                                                                       \
+        Attributes static void Histogram(const T* data, size_t n, double lo, double hi,             \
+                                         uint32_t* counts, size_t bins) {                           \
+            HistogramImpl(data, n, lo, hi, counts, bins);                                           \
+        }                                                                                           \
+    };
+
+NUMERIC_KERNELS(Scalar, , 0)
+#if NUMERIC_X86_SIMD
+NUMERIC_KERNELS(Avx2, [[gnu::target("avx2")]], 32)
+NUMERIC_KERNELS(Avx512, [[gnu::target("avx512f")]], 64)
+#endif
+
+#undef NUMERIC_KERNELS
+
+template <typename T>
+struct Kernels {
+    using Binary = void (*)(const T*, const T*, T*, size_t);
+
+    Acc<T> (*sum)(const T*, size_t);
+    Acc<T> (*dot)(const T*, const T*, size_t);
+    void (*minMax)(const T*, size_t, T&, T&, bool&);
+    void (*prefixSum)(const T*, T*, size_t);
+    void (*histogram)(const T*, size_t, double, double, uint32_t*, size_t);
+    Binary arith[4];      // by Op, b an array
+    Binary broadcast[4];  // by Op, b a single value
+};
+
+template <typename Isa, typename T>
+constexpr Kernels<T> MakeKernels() {
+    return {&Isa::template Sum<T>,
+            &Isa::template Dot<T>,
+            &Isa::template MinMax<T>,
+            &Isa::template PrefixSum<T>,
+            &Isa::template Histogram<T>,
+            {&Isa::template Arith<T, Op::kAdd, false>, &Isa::template Arith<T, Op::kSub, false>,
+             &Isa::template Arith<T, Op::kMul, false>, &Isa::template Arith<T, Op::kDiv, false>},
+            {&Isa::template Arith<T, Op::kAdd, true>, &Isa::template Arith<T, Op::kSub, true>,
+             &Isa::template Arith<T, Op::kMul, true>, &Isa::template Arith<T, Op::kDiv, true>}};
+}
+
+enum class Level { kScalar, kAvx2, kAvx512 };
+
+Level DetectLevel() {
+    Level level = Level::kScalar;
+#if NUMERIC_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        level = Level::kAvx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        level = Level::kAvx2;
+    }
+#endif
+    if (const char* cap = std::getenv("NUMERIC_SIMD")) {
+        if (std::strcmp(cap, "scalar") == 0) {
+            level = Level::kScalar;
+        } else if (std::strcmp(cap, "avx2") == 0 && level > Level::kAvx2) {
+            level = Level::kAvx2;
+        }
+    }
+    return level;
+}
+
+Level CurrentLevel() {
+    static const Level level = DetectLevel();
+    return level;
+}
+
+template <typename T>
+const Kernels<T>& KernelsFor() {
+    static const Kernels<T> kernels = [] {
+        switch (CurrentLevel()) {
+#if NUMERIC_X86_SIMD
+            case Level::kAvx512:
+                return MakeKernels<Avx512, T>();
+            case Level::kAvx2:
+                return MakeKernels<Avx2, T>();
+#endif
+            default:
+                return MakeKernels<Scalar, T>();
+        }
+    }();
+    return kernels;
+}
+
+// JavaScript entry points. Each one takes the element type from its first
+// argument, so they are raw callbacks rather than bound C++ functions.
+
+constexpr const char* kExpectedArray = "a Float64Array, Float32Array or Int32Array";
+
+void ThrowError(v8::Isolate* isolate, bool range_error, const std::string& message) {
+    v8::Local<v8::String> text = v8::String::NewFromUtf8(isolate, message.c_str()).ToLocalChecked();
+    isolate->ThrowException(range_error ? v8::Exception::RangeError(text) : v8::Exception::TypeError(text));
+}
+
+// Calls fn(std::span<T>) with the elements of a Float64Array, Float32Array
+// or Int32Array; throws a TypeError for anything else
+template <typename Fn>
+void WithArray(const v8::FunctionCallbackInfo<v8::Value>& args, Fn&& fn) {
+    v8::Local<v8::Value> value = args[0];
+    if (value->IsFloat64Array()) {
+        fn(binding::ViewTypedArray<double>(value));
+    } else if (value->IsFloat32Array()) {
+        fn(binding::ViewTypedArray<float>(value));
+    } else if (value->IsInt32Array()) {
+        fn(binding::ViewTypedArray<int32_t>(value));
+    } else {
+        ThrowError(args.GetIsolate(), false, std::string("Argument 1 must be ") + kExpectedArray);
+    }
+}
+
+// Argument `index` as an array of the same kind and length as the first
+bool SameShape(const v8::FunctionCallbackInfo<v8::Value>& args, int index, size_t length, auto& out) {
+    using T = typename std::remove_reference_t<decltype(out)>::element_type;
+    v8::Isolate* isolate = args.GetIsolate();
+    if (!binding::TypedArrayTraits<std::remove_const_t<T>>::Is(args[index])) {
+        ThrowError(isolate, false, "Argument " + std::to_string(index + 1) + " must be " +
+                                       binding::TypedArrayTraits<std::remove_const_t<T>>::kExpected + " like argument 1");
+        return false;
+    }
+    out = binding::ViewTypedArray<T>(args[index]);
+    if (out.size() != length) {
+        ThrowError(isolate, true, "Argument " + std::to_string(index + 1) + " must have the length of argument 1");
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+v8::Local<v8::TypedArray> NewArray(v8::Isolate* isolate, size_t length, std::span<T>& elements) {
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, length * sizeof(T));
+    elements = std::span<T>(static_cast<T*>(buffer->Data()), length);
+    return binding::TypedArrayTraits<T>::Array::New(buffer, 0, length);
+}
+
+// simdSum(array) -> number
+void Sum(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    WithArray(args, [&](auto data) {
+        using T = typename decltype(data)::element_type;
+        args.GetReturnValue().Set(static_cast<double>(KernelsFor<T>().sum(data.data(), data.size())));
+    });
+}
+
+// simdDot(a, b) -> number
+void Dot(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    WithArray(args, [&](auto a) {
+        using T = typename decltype(a)::element_type;
+        std::span<T> b;
+        if (!SameShape(args, 1, a.size(), b)) return;
+        args.GetReturnValue().Set(static_cast<double>(KernelsFor<T>().dot(a.data(), b.data(), a.size())));
+    });
+}
+
+// simdMinMax(array) -> {min, max}; Infinity / -Infinity when empty, NaN if
+// any element is NaN
+void MinMax(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    v8::Isolate* isolate = args.GetIsolate();
+    WithArray(args, [&](auto data) {
+        using T = typename decltype(data)::element_type;
+        double lo = std::numeric_limits<double>::infinity();
+        double hi = -lo;
+        if (!data.empty()) {
+            T min;
+            T max;
+            bool nan;
+            KernelsFor<T>().minMax(data.data(), data.size(), min, max, nan);
+            lo = nan ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(min);
+            hi = nan ? lo : static_cast<double>(max);
+        }
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Local<v8::Object> result = v8::Object::New(isolate);
+        // Not binding::Intern: a DLL's per-isolate caches are out of reach of
+        // the host's ReleaseIsolate (see V8Binding.h)
+        result->Set(context, v8::String::NewFromUtf8Literal(isolate, "min", v8::NewStringType::kInternalized),
+                    v8::Number::New(isolate, lo)).Check();
+        result->Set(context, v8::String::NewFromUtf8Literal(isolate, "max", v8::NewStringType::kInternalized),
+                    v8::Number::New(isolate, hi)).Check();
+        args.GetReturnValue().Set(result);
+    });
+}
+
+// simdPrefixSum(array) -> new array of the same kind with running totals
+void PrefixSum(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    v8::Isolate* isolate = args.GetIsolate();
+    WithArray(args, [&](auto data) {
+        using T = typename decltype(data)::element_type;
+        std::span<T> out;
+        v8::Local<v8::TypedArray> result = NewArray(isolate, data.size(), out);
+        KernelsFor<T>().prefixSum(data.data(), out.data(), data.size());
+        args.GetReturnValue().Set(result);
+    });
+}
+
+// simdHistogram(array, bins[, lo, hi]) -> Uint32Array of counts over
+// uniform bins; the range defaults to the array's min and max
+void Histogram(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    constexpr uint32_t kMaxBins = 1u << 24;
+    v8::Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    WithArray(args, [&](auto data) {
+        using T = typename decltype(data)::element_type;
+        uint32_t bins = 0;
+        if (binding::Converter<uint32_t>::FromV8(isolate, args[1], bins) != binding::Conversion::OK ||
+            bins == 0 || bins > kMaxBins) {
+            ThrowError(isolate, true, "Argument 2 must be a bin count between 1 and " + std::to_string(kMaxBins));
+            return;
+        }
+
+        double lo = 0;
+        double hi = 0;
+        if (args.Length() >= 4) {
+            if (!args[2]->IsNumber() || !args[3]->IsNumber()) {
+                ThrowError(isolate, false, "Arguments 3 and 4 must be numbers");
+                return;
+            }
+            lo = args[2]->NumberValue(context).FromJust();
+            hi = args[3]->NumberValue(context).FromJust();
+        } else if (!data.empty()) {
+            T min;
+            T max;
+            bool nan;
+            KernelsFor<T>().minMax(data.data(), data.size(), min, max, nan);
+            if (nan) {
+                ThrowError(isolate, true, "Array contains NaN; pass lo and hi explicitly");
+                return;
+            }
+            lo = static_cast<double>(min);
+            hi = static_cast<double>(max);
+        }
+
+        std::span<uint32_t> counts;
+        v8::Local<v8::TypedArray> result = NewArray(isolate, bins, counts);
+        KernelsFor<T>().histogram(data.data(), data.size(), lo, hi, counts.data(), bins);
+        args.GetReturnValue().Set(result);
+    });
+}
+
+// simdSort(array) -> array, sorted in place in TypedArray.prototype.sort
+// order (-0 before +0, NaN last)
+void Sort(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    WithArray(args, [&](auto data) {
+        using T = typename decltype(data)::element_type;
+        if constexpr (std::is_floating_point_v<T>) {
+            auto end = std::partition(data.begin(), data.end(), [](T value) { return value == value; });
+            std::sort(data.begin(), end, [](T a, T b) {
+                return a < b || (a == b && std::signbit(a) && !std::signbit(b));
+            });
+        } else {
+            std::sort(data.begin(), data.end());
+        }
+        args.GetReturnValue().Set(args[0]);
+    });
+}
+
+// simdAdd / simdSub / simdMul / simdDiv(a, b[, out]): b is an array of the
+// same kind and length or a number; the result goes to `out` (which may be
+// a or b) or a new array
+template <Op op>
+void Arith(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    v8::Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    WithArray(args, [&](auto a) {
+        using T = typename decltype(a)::element_type;
+        const Kernels<T>& kernels = KernelsFor<T>();
+
+        T scalar{};
+        std::span<T> b;
+        bool broadcast = args[1]->IsNumber();
+        if (broadcast) {
+            if constexpr (std::is_integral_v<T>) {
+                scalar = args[1]->Int32Value(context).FromJust();
+            } else {
+                scalar = static_cast<T>(args[1]->NumberValue(context).FromJust());
+            }
+        } else if (!SameShape(args, 1, a.size(), b)) {
+            return;
+        }
+
+        std::span<T> out;
+        v8::Local<v8::Value> result;
+        if (args.Length() >= 3 && !args[2]->IsUndefined()) {
+            if (!SameShape(args, 2, a.size(), out)) return;
+            result = args[2];
+        } else {
+            result = NewArray(isolate, a.size(), out);
+        }
+
+        if (broadcast) {
+            kernels.broadcast[static_cast<int>(op)](a.data(), &scalar, out.data(), a.size());
+        } else {
+            kernels.arith[static_cast<int>(op)](a.data(), b.data(), out.data(), a.size());
+        }
+        args.GetReturnValue().Set(result);
+    });
+}
+
+// simdLevel() -> "avx512", "avx2" or "scalar"
+const char* SimdLevel() {
+    switch (CurrentLevel()) {
+        case Level::kAvx512:
+            return "avx512";
+        case Level::kAvx2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+void Add(const v8::FunctionCallbackInfo<v8::Value>& args) { Arith<Op::kAdd>(args); }
+void Subtract(const v8::FunctionCallbackInfo<v8::Value>& args) { Arith<Op::kSub>(args); }
+void Multiply(const v8::FunctionCallbackInfo<v8::Value>& args) { Arith<Op::kMul>(args); }
+void Divide(const v8::FunctionCallbackInfo<v8::Value>& args) { Arith<Op::kDiv>(args); }
+
+} // namespace
+
+// Exported functions: (JS name, C++ function). The callbacks are resolved
+// lazily from the manifest like Fib's
+#define NUMERIC_FUNCTIONS(X)          \
+    X(simdSum, Sum)                   \
+    X(simdDot, Dot)                   \
+    X(simdMinMax, MinMax)             \
+    X(simdPrefixSum, PrefixSum)       \
+    X(simdHistogram, Histogram)       \
+    X(simdSort, Sort)                 \
+    X(simdAdd, Add)                   \
+    X(simdSub, Subtract)              \
+    X(simdMul, Multiply)              \
+    X(simdDiv, Divide)                \
+    X(simdLevel, SimdLevel)
+
+NUMERIC_FUNCTIONS(V8_NATIVE_EXPORT)
+V8_MANIFEST(NUMERIC_FUNCTIONS)
@@ -6,6 +6,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <thread>
+#include <condition_variable>
+#include <ctime>
 
 namespace v8_integration {
 
@@ -15,6 +18,11 @@ ErrorInfo::ErrorInfo(ErrorCode c, const std::string& msg, const std::string& f,
     : code(c), message(msg), file(f), line(l), function(func),
       timestamp(std::chrono::system_clock::now()) {
     
+    // Success placeholders are created per execution; skip the backtrace
+    if (c == ErrorCode::SUCCESS) {
+        return;
+    }
+    
     // Capture stack trace
     void* trace[16];
     int trace_size = backtrace(trace, 16);
@@ -29,15 +37,331 @@ ErrorInfo::ErrorInfo(ErrorCode c, const std::string& msg, const std::string& f,
     free(messages);
 }
 
+// Logger::AsyncWriter - bounded multi-producer/single-consumer ring buffer
+// (per-cell sequence numbers, Vyukov style) drained by one writer thread
+namespace {
+    thread_local bool t_on_writer_thread = false;
+
+    size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+class Logger::AsyncWriter {
+public:
+    AsyncWriter(Logger& logger, const AsyncConfig& config)
+        : logger_(logger),
+          config_(config),
+          capacity_(roundUpToPowerOfTwo(config.buffer_capacity)),
+          mask_(capacity_ - 1),
+          cells_(new Cell[capacity_]) {
+        if (config_.batch_size == 0) {
+            config_.batch_size = 1;
+        }
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        thread_ = std::thread(&AsyncWriter::run, this);
+    }
+    
+    ~AsyncWriter() {
+        stop();
+    }
+    
+    void push(LogLevel level, std::string&& text) {
+        // The writer thread must never wait on itself
+        bool block = config_.overflow_policy == OverflowPolicy::BLOCK && !t_on_writer_thread;
+        
+        while (!tryPush(level, text)) {
+            if (!block) {
+                logger_.dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (writer_idle_.load()) {
+                wake();
+            }
+            std::this_thread::yield();
+        }
+        
+        if (writer_idle_.load()) {
+            wake();
+        }
+    }
+    
+    // Returns once every record enqueued before the call has been written
+    // and the output streams have been flushed
+    void flush() {
+        if (t_on_writer_thread) return;
+        
+        size_t target = enqueue_pos_.load();
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        if (target > flush_target_) {
+            flush_target_ = target;
+        }
+        wake_cv_.notify_one();
+        flushed_cv_.wait(lock, [&] { return flushed_pos_ >= target || stopped_; });
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        wake_cv_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        std::string text;
+    };
+    
+    bool tryPush(LogLevel level, std::string& text) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.level = level;
+                    cell.text = std::move(text);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool tryPop(std::pair<LogLevel, std::string>& out) {
+        Cell& cell = cells_[dequeue_pos_ & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            return false;
+        }
+        out.first = cell.level;
+        out.second = std::move(cell.text);
+        cell.text.clear();
+        cell.sequence.store(dequeue_pos_ + capacity_, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+    
+    bool hasPending() {
+        const Cell& cell = cells_[dequeue_pos_ & mask_];
+        return cell.sequence.load(std::memory_order_acquire) == dequeue_pos_ + 1;
+    }
+    
+    void wake() {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+    
+    void run() {
+        t_on_writer_thread = true;
+        
+        std::vector<std::pair<LogLevel, std::string>> batch;
+        batch.reserve(config_.batch_size + 1);
+        auto last_flush = std::chrono::steady_clock::now();
+        
+        for (;;) {
+            size_t flush_target;
+            size_t flushed;
+            bool stopping;
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                flush_target = flush_target_;
+                flushed = flushed_pos_;
+                stopping = stopping_;
+            }
+            
+            batch.clear();
+            std::pair<LogLevel, std::string> record;
+            while (batch.size() < config_.batch_size && tryPop(record)) {
+                batch.push_back(std::move(record));
+            }
+            bool more = batch.size() == config_.batch_size;
+            
+            if (config_.overflow_policy == OverflowPolicy::COUNT) {
+                uint64_t dropped = logger_.dropped_count_.load(std::memory_order_relaxed);
+                if (dropped > reported_dropped_) {
+                    batch.emplace_back(LogLevel::WARN, logger_.formatMessage(LogLevel::WARN,
+                        std::to_string(dropped - reported_dropped_) + " log records dropped (async buffer full)",
+                        "", 0, ""));
+                    reported_dropped_ = dropped;
+                }
+            }
+            
+            auto now = std::chrono::steady_clock::now();
+            bool flush_requested = flush_target > flushed && dequeue_pos_ >= flush_target;
+            bool flush_due = flush_requested || (stopping && !more) ||
+                             now - last_flush >= config_.flush_interval;
+            
+            if (!batch.empty() || flush_due) {
+                logger_.writeRecords(batch, flush_due);
+            }
+            
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            if (flush_due) {
+                last_flush = now;
+                flushed_pos_ = dequeue_pos_;
+                flushed_cv_.notify_all();
+            }
+            
+            if (more) continue;
+            
+            if (stopping_) {
+                if (hasPending()) continue;
+                if (flush_due) break;
+                continue;
+            }
+            
+            // Advertise that producers need to wake us, then re-check for
+            // records published before they could have seen the flag
+            writer_idle_.store(true);
+            if (!hasPending() && flush_target_ <= flushed_pos_) {
+                auto deadline = last_flush + config_.flush_interval;
+                wake_cv_.wait_until(lock, deadline, [&] {
+                    return stopping_ || flush_target_ > flushed_pos_ || hasPending();
+                });
+            }
+            writer_idle_.store(false);
+        }
+        
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopped_ = true;
+        flushed_cv_.notify_all();
+    }
+    
+    Logger& logger_;
+    AsyncConfig config_;
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) size_t dequeue_pos_ = 0;  // writer thread only
+    uint64_t reported_dropped_ = 0;       // writer thread only
+    std::atomic<bool> writer_idle_{false};
+    
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    size_t flush_target_ = 0;
+    size_t flushed_pos_ = 0;
+    bool stopping_ = false;
+    bool stopped_ = false;
+    
+    std::thread thread_;
+};
+
 // Logger implementation
 Logger& Logger::getInstance() {
     static Logger instance;
     return instance;
 }
 
-void Logger::setLevel(LogLevel level) {
+Logger::~Logger() {
+    disableAsyncLogging();
+    disableBinaryLogging();
+}
+
+void Logger::enableAsyncLogging() {
+    enableAsyncLogging(AsyncConfig{});
+}
+
+void Logger::enableAsyncLogging(const AsyncConfig& config) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (async_owner_) return;
+    
+    async_owner_ = std::make_unique<AsyncWriter>(*this, config);
+    async_writer_.store(async_owner_.get());
+}
+
+void Logger::disableAsyncLogging() {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!async_owner_) return;
+    
+    // New producers fall back to the synchronous path; wait out the ones
+    // that already picked up the writer before draining it
+    async_writer_.store(nullptr);
+    waitForSinkUsers();
+    async_owner_->stop();
+    async_owner_.reset();
+}
+
+void Logger::waitForSinkUsers() {
+    while (sink_users_.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool Logger::enableBinaryLogging(const BinaryLogWriter::Config& config) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (binary_owner_) return false;
+    
+    auto writer = std::make_unique<BinaryLogWriter>(config);
+    if (!writer->isOpen()) return false;
+    
+    binary_owner_ = std::move(writer);
+    binary_writer_.store(binary_owner_.get());
+    return true;
+}
+
+void Logger::disableBinaryLogging() {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!binary_owner_) return;
+    
+    binary_writer_.store(nullptr);
+    waitForSinkUsers();
+    binary_owner_.reset();
+}
+
+bool Logger::isBinaryLogging() const {
+    return binary_writer_.load() != nullptr;
+}
+
+bool Logger::isAsyncLogging() const {
+    return async_writer_.load() != nullptr;
+}
+
+void Logger::flush() {
+    sink_users_.fetch_add(1);
+    if (AsyncWriter* writer = async_writer_.load()) {
+        writer->flush();
+    }
+    if (BinaryLogWriter* writer = binary_writer_.load()) {
+        writer->flush();
+    }
+    sink_users_.fetch_sub(1);
+    
     std::lock_guard<std::mutex> lock(mutex_);
-    current_level_ = level;
+    if (console_logging_) {
+        std::cout.flush();
+    }
+    if (file_stream_ && file_stream_->is_open()) {
+        file_stream_->flush();
+    }
+}
+
+uint64_t Logger::getDroppedCount() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+}
+
+void Logger::setLevel(LogLevel level) {
+    current_level_.store(level, std::memory_order_relaxed);
 }
 
 void Logger::addHandler(std::function<void(LogLevel, const std::string&)> handler) {
@@ -57,10 +381,46 @@ void Logger::enableConsoleLogging(bool enable) {
 
 void Logger::log(LogLevel level, const std::string& message, 
                 const std::string& file, int line, const std::string& function) {
-    if (level < current_level_) return;
+    if (!isEnabled(level)) return;
+    write(level, message, file, line, function);
+}
+
+std::string& Logger::formatBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+void Logger::write(LogLevel level, std::string_view message, std::string_view file,
+                   int line, std::string_view function) {
+    if (binary_writer_.load(std::memory_order_relaxed)) {
+        sink_users_.fetch_add(1);
+        if (BinaryLogWriter* writer = binary_writer_.load()) {
+            // Pre-rendered text from log(): store it as the single argument
+            writer->write(static_cast<uint8_t>(level), "{}", file, line, function, false, message);
+            if (level == LogLevel::FATAL) {
+                writer->flush();
+            }
+            sink_users_.fetch_sub(1);
+            return;
+        }
+        sink_users_.fetch_sub(1);
+    }
+    
+    if (async_writer_.load(std::memory_order_relaxed)) {
+        sink_users_.fetch_add(1);
+        if (AsyncWriter* writer = async_writer_.load()) {
+            writer->push(level, formatMessage(level, message, file, line, function));
+            if (level == LogLevel::FATAL) {
+                writer->flush();
+            }
+            sink_users_.fetch_sub(1);
+            return;
+        }
+        sink_users_.fetch_sub(1);
+    }
     
-    std::lock_guard<std::mutex> lock(mutex_);
     std::string formatted = formatMessage(level, message, file, line, function);
+    std::lock_guard<std::mutex> lock(mutex_);
     
     if (console_logging_) {
         std::cout << formatted << std::endl;
@@ -76,6 +436,41 @@ void Logger::log(LogLevel level, const std::string& message,
     }
 }
 
+void Logger::writeRecords(const std::vector<std::pair<LogLevel, std::string>>& records,
+                          bool flush_streams) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (!records.empty()) {
+        std::string block;
+        for (const auto& record : records) {
+            block += record.second;
+            block += '\n';
+        }
+        
+        if (console_logging_) {
+            std::cout.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+        if (file_stream_ && file_stream_->is_open()) {
+            file_stream_->write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+        
+        for (const auto& record : records) {
+            for (auto& handler : handlers_) {
+                handler(record.first, record.second);
+            }
+        }
+    }
+    
+    if (flush_streams) {
+        if (console_logging_) {
+            std::cout.flush();
+        }
+        if (file_stream_ && file_stream_->is_open()) {
+            file_stream_->flush();
+        }
+    }
+}
+
 void Logger::trace(const std::string& message, const std::string& file, 
                   int line, const std::string& function) {
     log(LogLevel::TRACE, message, file, line, function);
@@ -106,26 +501,39 @@ void Logger::fatal(const std::string& message, const std::string& file,
     log(LogLevel::FATAL, message, file, line, function);
 }
 
-std::string Logger::formatMessage(LogLevel level, const std::string& message,
-                                 const std::string& file, int line,
-                                 const std::string& function) {
+std::string Logger::formatMessage(LogLevel level, std::string_view message,
+                                 std::string_view file, int line,
+                                 std::string_view function) {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    oss << " [" << levelToString(level) << "] ";
+    // localtime_r: async producers format concurrently without holding mutex_
+    std::tm local_tm{};
+    localtime_r(&time_t, &local_tm);
+    char timestamp[32];
+    size_t timestamp_len = std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local_tm);
+    
+    std::string result;
+    result.reserve(timestamp_len + file.size() + function.size() + message.size() + 48);
+    result.append(timestamp, timestamp_len);
+    result += " [";
+    result += levelToString(level);
+    result += "] ";
     
     if (!file.empty()) {
-        oss << "(" << file << ":" << line;
+        result += '(';
+        result += file;
+        result += ':';
+        result += std::to_string(line);
         if (!function.empty()) {
-            oss << " in " << function;
+            result += " in ";
+            result += function;
         }
-        oss << ") ";
+        result += ") ";
     }
     
-    oss << message;
-    return oss.str();
+    result += message;
+    return result;
 }
 
 std::string Logger::levelToString(LogLevel level) {
@@ -446,7 +446,7 @@ void V8ConsoleCore::RegisterBuiltins() {
     // We're already in a scope, so don't need V8Scope
     v8_->GetGlobalObject()->Set(
         context,
-        v8integration::V8Integration::ToV8String(isolate, "console"),
+        v8integration::binding::Intern<"console">(isolate),
         builder.Build()
     ).Check();
     
@@ -0,0 +1,1083 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <v8.h>
+#include <v8-fast-api-calls.h>
+
+// Compile-time bindings from plain C++ functions to V8 callbacks.
+//
+//   long long calculateFibSum(uint32_t n);
+//   v8::Function::New(context, binding::Callback<&calculateFibSum>);
+//
+// Each signature gets its own v8::FunctionCallback that checks the argument
+// count, converts every argument with a Converter<T>, calls the function and
+// converts the result. Arguments live on the stack; there is no
+// std::function, no v8::External lookup and no heap allocation per call
+// (except for std::string arguments longer than the small-string buffer).
+namespace v8integration::binding {
+
+enum class Conversion { OK, WRONG_TYPE, NEGATIVE, OUT_OF_RANGE };
+
+// Converter<T> provides
+//   static constexpr const char* kExpected;  // used in "Argument N must be ..."
+//   static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value>, T& out);
+//   static v8::Local<v8::Value> ToV8(v8::Isolate*, const T& value);
+// Specialize it to bind further types.
+template <typename T, typename = void>
+struct Converter;
+
+// Converters of compound values (structs, arrays) also declare
+//   static constexpr bool kNested = true;
+// and report which element failed through detail::FailElement, so the
+// error names it: "Argument 1: items[0].quantity must be a number".
+namespace detail {
+
+struct FailedElement {
+    std::string path;  // ".field" and "[index]" segments, outermost first
+    const char* expected = "";
+};
+
+inline FailedElement& LastFailedElement() {
+    thread_local FailedElement element;
+    return element;
+}
+
+template <typename T>
+constexpr bool kNestedConverter = requires { requires Converter<T>::kNested; };
+
+// A compound value failed its own check (e.g. not an object); anything
+// recorded earlier is stale
+inline Conversion FailCompound(Conversion result) {
+    LastFailedElement().path.clear();
+    return result;
+}
+
+// Element `segment`, of type T, of a compound value failed with `result`
+template <typename T>
+Conversion FailElement(Conversion result, std::string_view segment) {
+    FailedElement& element = LastFailedElement();
+    if (kNestedConverter<T> && !element.path.empty()) {
+        element.path.insert(0, segment);
+    } else {
+        element.path.assign(segment);
+        element.expected = Converter<T>::kExpected;
+    }
+    return result;
+}
+
+} // namespace detail
+
+// Handles and other data cached per isolate (Eternal names, templates).
+// Lookups from the thread that last used an isolate skip the lock.
+//
+// Entries are tied to the isolate's identity, not just its address: a
+// random id kept in data slot V8_BINDING_ISOLATE_SLOT. An isolate created
+// later at a reused address starts with an empty slot, so it never sees
+// entries (Eternal indices, templates) left behind by a disposed one, even
+// if nobody called ReleaseIsolate(). ReleaseIsolate() just frees them
+// early. Define V8_BINDING_ISOLATE_SLOT if the embedder uses that slot.
+// Each shared object (host, DLL) has its own caches, and the host's
+// ReleaseIsolate() only reaches its own. DLLs must therefore not use
+// PerIsolate or Intern: a DLL stays mapped while any loader holds it, so
+// its entries would outlive every isolate that made them. Create names per
+// call instead (String::NewFromUtf8Literal with kInternalized).
+#ifndef V8_BINDING_ISOLATE_SLOT
+#define V8_BINDING_ISOLATE_SLOT 3
+#endif
+
+namespace detail {
+
+struct IsolateCaches {
+    std::mutex mutex;
+    std::vector<void (*)(v8::Isolate*)> releasers;
+    std::atomic<uint64_t> generation{0};
+
+    static IsolateCaches& Instance() {
+        static IsolateCaches instance;
+        return instance;
+    }
+};
+
+// The isolate's id, assigned on first use. Ids are random rather than
+// counted so that the separate caches of a host and its DLLs cannot hand
+// out the same id to different isolates.
+inline uintptr_t IsolateId(v8::Isolate* isolate) {
+    void* slot = isolate->GetData(V8_BINDING_ISOLATE_SLOT);
+    if (!slot) {
+        static std::mutex mutex;
+        static std::mt19937_64 random{std::random_device{}()};
+        uintptr_t id = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (id == 0) {
+                id = static_cast<uintptr_t>(random());
+            }
+        }
+        slot = reinterpret_cast<void*>(id);
+        isolate->SetData(V8_BINDING_ISOLATE_SLOT, slot);
+    }
+    return reinterpret_cast<uintptr_t>(slot);
+}
+
+} // namespace detail
+
+template <typename Data>
+class PerIsolate {
+public:
+    // `init(isolate, data)` runs once per isolate, under the cache lock and
+    // inside the caller's HandleScope
+    template <typename Init>
+    static Data& Get(v8::Isolate* isolate, Init&& init) {
+        thread_local Last last;
+        uintptr_t id = detail::IsolateId(isolate);
+        uint64_t generation = detail::IsolateCaches::Instance().generation.load(std::memory_order_acquire);
+        if (last.isolate == isolate && last.id == id && last.generation == generation) {
+            return *last.data;
+        }
+
+        static const bool registered = [] {
+            auto& caches = detail::IsolateCaches::Instance();
+            std::lock_guard<std::mutex> lock(caches.mutex);
+            caches.releasers.push_back(&Release);
+            return true;
+        }();
+        (void)registered;
+
+        std::lock_guard<std::mutex> lock(Mutex());
+        auto it = Entries().find(isolate);
+        if (it != Entries().end() && it->second.id != id) {
+            // Left by a disposed isolate at the same address
+            Entries().erase(it);
+            it = Entries().end();
+        }
+        if (it == Entries().end()) {
+            it = Entries().emplace(isolate, Entry{id, std::make_unique<Data>()}).first;
+            init(isolate, *it->second.data);
+        }
+        last = {isolate, id, generation, it->second.data.get()};
+        return *it->second.data;
+    }
+
+private:
+    struct Entry {
+        uintptr_t id;
+        std::unique_ptr<Data> data;
+    };
+
+    struct Last {
+        v8::Isolate* isolate = nullptr;
+        uintptr_t id = 0;
+        uint64_t generation = 0;
+        Data* data = nullptr;
+    };
+
+    static std::mutex& Mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::map<v8::Isolate*, Entry>& Entries() {
+        static std::map<v8::Isolate*, Entry> entries;
+        return entries;
+    }
+
+    static void Release(v8::Isolate* isolate) {
+        std::lock_guard<std::mutex> lock(Mutex());
+        Entries().erase(isolate);
+    }
+};
+
+// Frees everything cached for `isolate` in this shared object
+inline void ReleaseIsolate(v8::Isolate* isolate) {
+    auto& caches = detail::IsolateCaches::Instance();
+    std::lock_guard<std::mutex> lock(caches.mutex);
+    for (auto release : caches.releasers) {
+        release(isolate);
+    }
+    caches.generation.fetch_add(1, std::memory_order_release);
+}
+
+// Internalized strings for property and function names, created once per
+// isolate and held as Eternals:
+//
+//   object->Set(context, Intern<"length">(isolate), value);  // fixed names
+//   object->Set(context, Intern(isolate, name), value);      // runtime names
+//
+// The literal form gets its own slot per name and skips the hash lookup.
+// Runtime names are looked up by string_view without allocating; past
+// kMaxInternedStrings further names are internalized but not cached, so
+// dynamic keys cannot grow the cache without bound.
+template <size_t N>
+struct Literal {
+    char value[N];
+
+    constexpr Literal(const char (&str)[N]) {
+        for (size_t i = 0; i < N; ++i) value[i] = str[i];
+    }
+};
+
+constexpr size_t kMaxInternedStrings = 4096;
+
+namespace detail {
+
+struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+struct InternedStrings {
+    std::unordered_map<std::string, v8::Eternal<v8::String>, StringViewHash, std::equal_to<>> names;
+};
+
+template <Literal Name>
+struct InternedLiteral {
+    v8::Eternal<v8::String> name;
+};
+
+inline v8::Local<v8::String> NewInternalized(v8::Isolate* isolate, std::string_view str) {
+    return v8::String::NewFromUtf8(isolate, str.data(), v8::NewStringType::kInternalized,
+                                   static_cast<int>(str.size()))
+        .ToLocalChecked();
+}
+
+} // namespace detail
+
+inline v8::Local<v8::String> Intern(v8::Isolate* isolate, std::string_view str) {
+    auto& strings = PerIsolate<detail::InternedStrings>::Get(isolate, [](v8::Isolate*, detail::InternedStrings&) {});
+    auto it = strings.names.find(str);
+    if (it != strings.names.end()) {
+        return it->second.Get(isolate);
+    }
+    v8::Local<v8::String> name = detail::NewInternalized(isolate, str);
+    if (strings.names.size() < kMaxInternedStrings) {
+        strings.names.emplace(std::string(str), v8::Eternal<v8::String>(isolate, name));
+    }
+    return name;
+}
+
+template <Literal Name>
+v8::Local<v8::String> Intern(v8::Isolate* isolate) {
+    return PerIsolate<detail::InternedLiteral<Name>>::Get(isolate, [](v8::Isolate* isolate,
+                                                                      detail::InternedLiteral<Name>& slot) {
+        slot.name.Set(isolate, v8::String::NewFromUtf8Literal(isolate, Name.value, v8::NewStringType::kInternalized));
+    }).name.Get(isolate);
+}
+
+template <>
+struct Converter<bool> {
+    static constexpr const char* kExpected = "a boolean";
+
+    static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value> value, bool& out) {
+        if (!value->IsBoolean()) return Conversion::WRONG_TYPE;
+        out = value.As<v8::Boolean>()->Value();
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, bool value) {
+        return v8::Boolean::New(isolate, value);
+    }
+};
+
+// Integers accept Numbers (truncated toward zero, range-checked) and, for
+// 64-bit types, BigInts. Results that fit in 32 bits become Smis/Integers;
+// wider results become Numbers, matching what the hand-written DLL
+// wrappers returned.
+template <typename T>
+struct Converter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr const char* kExpected = "a number";
+
+    static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value> value, T& out) {
+        if constexpr (sizeof(T) == 8) {
+            if (value->IsBigInt()) {
+                bool lossless = true;
+                if constexpr (std::is_signed_v<T>) {
+                    out = static_cast<T>(value.As<v8::BigInt>()->Int64Value(&lossless));
+                } else {
+                    out = static_cast<T>(value.As<v8::BigInt>()->Uint64Value(&lossless));
+                }
+                return lossless ? Conversion::OK : Conversion::OUT_OF_RANGE;
+            }
+        }
+        if (!value->IsNumber()) return Conversion::WRONG_TYPE;
+        return FromNumber(value.As<v8::Number>()->Value(), out);
+    }
+
+    // Shared with the fast-call path, which receives integers as doubles
+    static Conversion FromNumber(double value, T& out) {
+        double number = std::trunc(value);
+        if (std::is_unsigned_v<T> && number < 0) return Conversion::NEGATIVE;
+        // 2^(bits) is exact as a double, so compare against it rather than max()
+        constexpr double kUpper = std::is_signed_v<T>
+            ? -static_cast<double>(std::numeric_limits<T>::min())
+            : static_cast<double>(std::numeric_limits<T>::max()) + 1.0;
+        constexpr double kLower = static_cast<double>(std::numeric_limits<T>::min());
+        if (!(number >= kLower && number < kUpper)) return Conversion::OUT_OF_RANGE;
+
+        out = static_cast<T>(number);
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, T value) {
+        if constexpr (sizeof(T) <= 4 && std::is_signed_v<T>) {
+            return v8::Integer::New(isolate, static_cast<int32_t>(value));
+        } else if constexpr (sizeof(T) <= 4) {
+            return v8::Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(value));
+        } else {
+            return v8::Number::New(isolate, static_cast<double>(value));
+        }
+    }
+};
+
+// An integer argument limited to [Min, Max]. Values outside are a
+// RangeError, so a function need not check (or silently overflow) past the
+// inputs it can handle; it keeps its Fast API path and manifest signature:
+//
+//   long long calculateFibSum(InRange<uint32_t, 0, 91> n);
+template <typename T, T Min, T Max>
+struct InRange {
+    T value{};
+    operator T() const { return value; }
+};
+
+template <typename T, T Min, T Max>
+struct Converter<InRange<T, Min, Max>> {
+    static constexpr const char* kExpected = Converter<T>::kExpected;
+
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, InRange<T, Min, Max>& out) {
+        Conversion result = Converter<T>::FromV8(isolate, value, out.value);
+        return result == Conversion::OK ? Check(out.value) : result;
+    }
+
+    static Conversion FromNumber(double value, InRange<T, Min, Max>& out) {
+        Conversion result = Converter<T>::FromNumber(value, out.value);
+        return result == Conversion::OK ? Check(out.value) : result;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, InRange<T, Min, Max> value) {
+        return Converter<T>::ToV8(isolate, value.value);
+    }
+
+private:
+    static Conversion Check(T value) {
+        // Skip comparisons that are always false (and warned about) at the type's limits
+        if constexpr (Min != std::numeric_limits<T>::min()) {
+            if (value < Min) return Conversion::OUT_OF_RANGE;
+        }
+        if constexpr (Max != std::numeric_limits<T>::max()) {
+            if (value > Max) return Conversion::OUT_OF_RANGE;
+        }
+        return Conversion::OK;
+    }
+};
+
+template <typename T>
+struct Converter<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr const char* kExpected = "a number";
+
+    static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value> value, T& out) {
+        if (!value->IsNumber()) return Conversion::WRONG_TYPE;
+        out = static_cast<T>(value.As<v8::Number>()->Value());
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, T value) {
+        return v8::Number::New(isolate, static_cast<double>(value));
+    }
+};
+
+template <>
+struct Converter<std::string> {
+    static constexpr const char* kExpected = "a string";
+
+    // Writes straight into the std::string instead of going through a
+    // String::Utf8Value temporary
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, std::string& out) {
+        if (!value->IsString()) return Conversion::WRONG_TYPE;
+        v8::Local<v8::String> str = value.As<v8::String>();
+        out.resize(static_cast<size_t>(str->Utf8Length(isolate)));
+        str->WriteUtf8(isolate, out.data(), static_cast<int>(out.size()), nullptr,
+                       v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const std::string& value) {
+        return v8::String::NewFromUtf8(isolate, value.data(), v8::NewStringType::kNormal,
+                                       static_cast<int>(value.size())).ToLocalChecked();
+    }
+};
+
+// Result-only: a const char* argument would not outlive the conversion
+template <>
+struct Converter<const char*> {
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const char* value) {
+        return v8::String::NewFromUtf8(isolate, value).ToLocalChecked();
+    }
+};
+
+template <>
+struct Converter<v8::Local<v8::Value>> {
+    static constexpr const char* kExpected = "a value";
+
+    static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value> value, v8::Local<v8::Value>& out) {
+        out = value;
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate*, v8::Local<v8::Value> value) {
+        return value;
+    }
+};
+
+// The typed array kind whose elements are exactly T
+template <typename T>
+struct TypedArrayTraits;
+
+#define V8_BINDING_TYPED_ARRAY(CppType, ArrayType, Name)                                      \
+    template <>                                                                               \
+    struct TypedArrayTraits<CppType> {                                                        \
+        using Array = v8::ArrayType;                                                          \
+        static constexpr const char* kExpected = Name;                                        \
+        static bool Is(v8::Local<v8::Value> value) { return value->Is##ArrayType(); }         \
+    };
+
+V8_BINDING_TYPED_ARRAY(int8_t, Int8Array, "an Int8Array")
+V8_BINDING_TYPED_ARRAY(uint8_t, Uint8Array, "a Uint8Array")
+V8_BINDING_TYPED_ARRAY(int16_t, Int16Array, "an Int16Array")
+V8_BINDING_TYPED_ARRAY(uint16_t, Uint16Array, "a Uint16Array")
+V8_BINDING_TYPED_ARRAY(int32_t, Int32Array, "an Int32Array")
+V8_BINDING_TYPED_ARRAY(uint32_t, Uint32Array, "a Uint32Array")
+V8_BINDING_TYPED_ARRAY(int64_t, BigInt64Array, "a BigInt64Array")
+V8_BINDING_TYPED_ARRAY(uint64_t, BigUint64Array, "a BigUint64Array")
+V8_BINDING_TYPED_ARRAY(float, Float32Array, "a Float32Array")
+V8_BINDING_TYPED_ARRAY(double, Float64Array, "a Float64Array")
+
+#undef V8_BINDING_TYPED_ARRAY
+
+// Spans view a typed array's backing store in place. They are only valid
+// for the duration of the call, and a span<T> (non-const) writes through
+// to the JavaScript array.
+template <typename T>
+struct Converter<std::span<T>, std::void_t<typename TypedArrayTraits<std::remove_const_t<T>>::Array>> {
+    using Traits = TypedArrayTraits<std::remove_const_t<T>>;
+    static constexpr const char* kExpected = Traits::kExpected;
+
+    static Conversion FromV8(v8::Isolate*, v8::Local<v8::Value> value, std::span<T>& out) {
+        if (!Traits::Is(value)) return Conversion::WRONG_TYPE;
+        v8::Local<v8::TypedArray> array = value.As<v8::TypedArray>();
+        auto* base = static_cast<char*>(array->Buffer()->Data());
+        if (!base) {
+            out = {};  // detached
+            return Conversion::OK;
+        }
+        out = std::span<T>(reinterpret_cast<T*>(base + array->ByteOffset()), array->Length());
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, std::span<T> value) {
+        size_t bytes = value.size() * sizeof(T);
+        v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, bytes);
+        if (bytes) {
+            std::memcpy(buffer->Data(), value.data(), bytes);
+        }
+        return Traits::Array::New(buffer, 0, value.size());
+    }
+};
+
+// Hands a vector's storage to V8 as the backing store of a typed array of
+// matching element type, in O(1): the vector is moved to the heap and freed
+// by the backing store's deleter once the array is garbage collected. With
+// the V8 sandbox enabled, off-heap memory cannot back an ArrayBuffer, so the
+// elements are copied instead; producers that know the length up front can
+// write into a TypedArrayBuilder and skip the copy in either configuration.
+template <typename T>
+v8::Local<typename TypedArrayTraits<T>::Array> MoveToTypedArray(v8::Isolate* isolate, std::vector<T>&& values) {
+    using Array = typename TypedArrayTraits<T>::Array;
+    size_t length = values.size();
+#ifdef V8_ENABLE_SANDBOX
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, length * sizeof(T));
+    if (length) {
+        std::memcpy(buffer->Data(), values.data(), length * sizeof(T));
+    }
+#else
+    if (length == 0) {
+        return Array::New(v8::ArrayBuffer::New(isolate, 0), 0, 0);
+    }
+    auto* owned = new std::vector<T>(std::move(values));
+    std::unique_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(
+        owned->data(), length * sizeof(T),
+        [](void*, size_t, void* deleter_data) { delete static_cast<std::vector<T>*>(deleter_data); },
+        owned);
+    v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, std::move(store));
+#endif
+    return Array::New(buffer, 0, length);
+}
+
+// A typed array whose backing store V8 allocates up front (inside the
+// sandbox when it is enabled), written in place through span() and handed
+// to JavaScript by Finish() without a copy:
+//
+//   TypedArrayBuilder<double> out(isolate, n);
+//   std::span<double> values = out.span();   // zero-initialized
+//   for (size_t i = 0; i < n; ++i) values[i] = ...;
+//   return out.Finish();
+//
+// The span is valid until Finish(), after which it belongs to JavaScript.
+template <typename T>
+class TypedArrayBuilder {
+public:
+    using Array = typename TypedArrayTraits<T>::Array;
+
+    TypedArrayBuilder(v8::Isolate* isolate, size_t length)
+        : isolate_(isolate), length_(length),
+          store_(v8::ArrayBuffer::NewBackingStore(isolate, length * sizeof(T))) {}
+
+    std::span<T> span() { return {static_cast<T*>(store_->Data()), length_}; }
+    size_t size() const { return length_; }
+
+    v8::Local<Array> Finish() {
+        v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate_, std::move(store_));
+        return Array::New(buffer, 0, length_);
+    }
+
+private:
+    v8::Isolate* isolate_;
+    size_t length_;
+    std::unique_ptr<v8::BackingStore> store_;
+};
+
+// A view over a JavaScript typed array whose elements are exactly T (empty
+// if `value` is some other kind). Valid while the array is alive and not
+// detached or resized; writes through a span<T> are visible to JavaScript.
+template <typename T>
+std::span<T> ViewTypedArray(v8::Local<v8::Value> value) {
+    std::span<T> view;
+    Converter<std::span<T>>::FromV8(nullptr, value, view);
+    return view;
+}
+
+// Vectors of numbers become typed arrays: moved (zero-copy) when returned
+// by value from a bound function, copied from an lvalue
+template <typename T>
+struct Converter<std::vector<T>, std::void_t<typename TypedArrayTraits<T>::Array>> {
+    static constexpr const char* kExpected = TypedArrayTraits<T>::kExpected;
+
+    // Plain arrays of numbers are accepted too (element by element), so
+    // decoded JSON-shaped objects work
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, std::vector<T>& out) {
+        if (value->IsArray()) {
+            v8::Local<v8::Array> array = value.As<v8::Array>();
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            // Read once: Get() can run getters that resize the array
+            const uint32_t length = array->Length();
+            out.resize(length);
+            for (uint32_t i = 0; i < length; ++i) {
+                v8::Local<v8::Value> element;
+                if (!array->Get(context, i).ToLocal(&element)) return Conversion::WRONG_TYPE;
+                Conversion result = Converter<T>::FromV8(isolate, element, out[i]);
+                if (result != Conversion::OK) return result;
+            }
+            return Conversion::OK;
+        }
+        std::span<const T> view;
+        Conversion result = Converter<std::span<const T>>::FromV8(isolate, value, view);
+        if (result == Conversion::OK) {
+            out.assign(view.begin(), view.end());
+        }
+        return result;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const std::vector<T>& value) {
+        return Converter<std::span<const T>>::ToV8(isolate, std::span<const T>(value));
+    }
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, std::vector<T>&& value) {
+        return MoveToTypedArray(isolate, std::move(value));
+    }
+};
+
+namespace detail {
+
+template <typename T>
+using Stored = std::remove_cv_t<std::remove_reference_t<T>>;
+
+inline void Throw(v8::Isolate* isolate, bool range_error, const char* message) {
+    v8::Local<v8::String> text = v8::String::NewFromUtf8(isolate, message).ToLocalChecked();
+    isolate->ThrowException(range_error ? v8::Exception::RangeError(text) : v8::Exception::TypeError(text));
+}
+
+// `path` names the failing element of a compound argument, if any
+inline void ThrowConversionError(v8::Isolate* isolate, Conversion result, size_t index, const char* expected,
+                                 const std::string& path = {}) {
+    char subject[160];
+    if (path.empty()) {
+        std::snprintf(subject, sizeof(subject), "Argument %zu", index + 1);
+    } else {
+        std::snprintf(subject, sizeof(subject), "Argument %zu: %s", index + 1, path.c_str() + (path[0] == '.'));
+    }
+    char message[256];
+    switch (result) {
+        case Conversion::WRONG_TYPE:
+            std::snprintf(message, sizeof(message), "%s must be %s", subject, expected);
+            break;
+        case Conversion::NEGATIVE:
+            std::snprintf(message, sizeof(message), "%s must be non-negative", subject);
+            break;
+        default:
+            std::snprintf(message, sizeof(message), "%s is out of range", subject);
+            break;
+    }
+    Throw(isolate, result != Conversion::WRONG_TYPE, message);
+}
+
+template <size_t I, typename T>
+bool ConvertArgument(const v8::FunctionCallbackInfo<v8::Value>& args, T& out) {
+    Conversion result = Converter<T>::FromV8(args.GetIsolate(), args[static_cast<int>(I)], out);
+    if (result == Conversion::OK) return true;
+    if constexpr (kNestedConverter<T>) {
+        const FailedElement& element = LastFailedElement();
+        if (!element.path.empty()) {
+            ThrowConversionError(args.GetIsolate(), result, I, element.expected, element.path);
+            return false;
+        }
+    }
+    ThrowConversionError(args.GetIsolate(), result, I, Converter<T>::kExpected);
+    return false;
+}
+
+template <typename Tuple, size_t... I>
+bool ConvertArguments(const v8::FunctionCallbackInfo<v8::Value>& args, Tuple& values, std::index_sequence<I...>) {
+    return (ConvertArgument<I>(args, std::get<I>(values)) && ...);
+}
+
+template <typename R, typename... Args>
+void Invoke(R (*fn)(Args...), const v8::FunctionCallbackInfo<v8::Value>& args) {
+    constexpr int kArity = static_cast<int>(sizeof...(Args));
+    v8::Isolate* isolate = args.GetIsolate();
+    if (args.Length() < kArity) {
+        char message[96];
+        std::snprintf(message, sizeof(message), "Wrong number of arguments. Expected %d argument%s.",
+                      kArity, kArity == 1 ? "" : "s");
+        Throw(isolate, false, message);
+        return;
+    }
+
+    std::tuple<Stored<Args>...> values;
+    if (!ConvertArguments(args, values, std::index_sequence_for<Args...>{})) {
+        return;
+    }
+
+    if constexpr (std::is_void_v<R>) {
+        std::apply(fn, values);
+    } else {
+        args.GetReturnValue().Set(Converter<Stored<R>>::ToV8(isolate, std::apply(fn, values)));
+    }
+}
+
+// Runtime function pointer carried in the callback data; one instantiation
+// per signature rather than per function
+template <typename R, typename... Args>
+void Trampoline(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto fn = reinterpret_cast<R (*)(Args...)>(args.Data().As<v8::External>()->Value());
+    Invoke(fn, args);
+}
+
+} // namespace detail
+
+// The callback for a function known at compile time; F is called directly
+template <auto F>
+void Callback(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    detail::Invoke(F, args);
+}
+
+// The shared per-signature callback and the data it expects, for function
+// pointers only known at runtime
+template <typename R, typename... Args>
+constexpr v8::FunctionCallback TrampolineFor(R (*)(Args...)) {
+    return &detail::Trampoline<R, Args...>;
+}
+
+template <typename R, typename... Args>
+void* TrampolineData(R (*fn)(Args...)) {
+    return reinterpret_cast<void*>(fn);
+}
+
+// Fast API calls. For signatures made only of scalars (and, where V8 still
+// provides FastApiTypedArray, typed-array spans), Bind<&fn> also attaches a
+// v8::CFunction so optimized code calls `fn` without building a
+// FunctionCallbackInfo. The slow callback stays registered: V8 uses it from
+// the interpreter and whenever an argument does not match the fast
+// signature. Functions bound through a runtime pointer have no fast path.
+#if V8_MAJOR_VERSION < 13
+#define V8_BINDING_FAST_TYPED_ARRAYS 1
+#endif
+
+namespace detail {
+
+#if V8_MAJOR_VERSION < 13
+using FastReceiver = v8::Local<v8::Object>;
+#else
+using FastReceiver = v8::Local<v8::Value>;
+#endif
+
+// FastParam<T>::Type is what V8 passes for an argument of type T
+template <typename T, typename = void>
+struct FastParam {
+    static constexpr bool kSupported = false;
+};
+
+template <>
+struct FastParam<bool> {
+    static constexpr bool kSupported = true;
+    using Type = bool;
+    static Conversion From(bool value, bool& out) {
+        out = value;
+        return Conversion::OK;
+    }
+};
+
+// Integers arrive as doubles so range checks match the slow path exactly
+template <typename T>
+struct FastParam<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr bool kSupported = true;
+    using Type = double;
+    static Conversion From(double value, T& out) { return Converter<T>::FromNumber(value, out); }
+};
+
+template <typename T, T Min, T Max>
+struct FastParam<InRange<T, Min, Max>> {
+    static constexpr bool kSupported = true;
+    using Type = double;
+    static Conversion From(double value, InRange<T, Min, Max>& out) {
+        return Converter<InRange<T, Min, Max>>::FromNumber(value, out);
+    }
+};
+
+template <typename T>
+struct FastParam<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr bool kSupported = true;
+    using Type = T;
+    static Conversion From(T value, T& out) {
+        out = value;
+        return Conversion::OK;
+    }
+};
+
+#ifdef V8_BINDING_FAST_TYPED_ARRAYS
+template <typename T>
+constexpr bool kFastTypedArrayElement =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, int64_t> ||
+    std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T>
+struct FastParam<std::span<T>, std::enable_if_t<kFastTypedArrayElement<std::remove_const_t<T>>>> {
+    using Element = std::remove_const_t<T>;
+    static constexpr bool kSupported = true;
+    using Type = const v8::FastApiTypedArray<Element>&;
+    static Conversion From(Type value, std::span<T>& out) {
+        Element* data = nullptr;
+        // JavaScript typed arrays are always element-aligned
+        if (!value.getStorageIfAligned(&data)) return Conversion::WRONG_TYPE;
+        out = std::span<T>(data, value.length());
+        return Conversion::OK;
+    }
+};
+#endif
+
+template <typename T, typename = void>
+struct FastReturn {
+    static constexpr bool kSupported = false;
+};
+
+template <>
+struct FastReturn<void> {
+    static constexpr bool kSupported = true;
+    using Type = void;
+};
+
+template <typename T>
+struct FastReturn<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    static constexpr bool kSupported = true;
+    // 64-bit results become Numbers, as Converter<T>::ToV8 does
+    using Type = std::conditional_t<std::is_same_v<T, bool> || std::is_floating_point_v<T>, T,
+                 std::conditional_t<(sizeof(T) > 4), double,
+                 std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>>>;
+};
+
+template <typename Fn>
+struct Fast {
+    static constexpr bool kSupported = false;
+};
+
+template <typename R, typename... Args>
+struct Fast<R (*)(Args...)> {
+    static constexpr bool kSupported =
+        FastReturn<Stored<R>>::kSupported && (FastParam<Stored<Args>>::kSupported && ...);
+
+    template <R (*F)(Args...)>
+    struct Function {
+        using Return = typename FastReturn<Stored<R>>::Type;
+
+        static Return Call(FastReceiver, typename FastParam<Stored<Args>>::Type... params,
+                           v8::FastApiCallbackOptions& options) {
+            std::tuple<Stored<Args>...> values;
+            Failure failure;
+            if (!Convert(values, failure, std::index_sequence_for<Args...>{}, params...)) {
+                Fail(options, failure);
+                if constexpr (!std::is_void_v<Return>) {
+                    return Return{};
+                } else {
+                    return;
+                }
+            }
+            if constexpr (std::is_void_v<Return>) {
+                std::apply(F, values);
+            } else {
+                return static_cast<Return>(std::apply(F, values));
+            }
+        }
+
+    private:
+        struct Failure {
+            Conversion result = Conversion::OK;
+            size_t index = 0;
+            const char* expected = "";
+        };
+
+        template <size_t... I>
+        static bool Convert(std::tuple<Stored<Args>...>& values, Failure& failure, std::index_sequence<I...>,
+                            typename FastParam<Stored<Args>>::Type... params) {
+            auto check = [&failure](Conversion result, size_t index, const char* expected) {
+                if (result == Conversion::OK) return true;
+                failure = {result, index, expected};
+                return false;
+            };
+            return (check(FastParam<Stored<Args>>::From(params, std::get<I>(values)), I,
+                          Converter<Stored<Args>>::kExpected) && ...);
+        }
+
+        // Older V8 re-runs the call through the slow callback, which throws
+        // the usual error; newer V8 lets the fast call throw itself
+        static void Fail(v8::FastApiCallbackOptions& options, const Failure& failure) {
+#if V8_MAJOR_VERSION < 12
+            (void)failure;
+            options.fallback = true;
+#else
+            v8::HandleScope handle_scope(options.isolate);
+            ThrowConversionError(options.isolate, failure.result, failure.index, failure.expected);
+#endif
+        }
+    };
+};
+
+} // namespace detail
+
+// Whether Bind<&F> gets a fast path
+template <auto F>
+constexpr bool kHasFastCall = detail::Fast<decltype(F)>::kSupported;
+
+template <auto F>
+inline const v8::CFunction kFastFunction =
+    v8::CFunction::Make(&detail::Fast<decltype(F)>::template Function<F>::Call);
+
+// The CFunction for F, or nullptr if its signature has no fast equivalent
+template <auto F>
+constexpr const v8::CFunction* FastFunction() {
+    if constexpr (kHasFastCall<F>) {
+        return &kFastFunction<F>;
+    } else {
+        return nullptr;
+    }
+}
+
+// Function templates with a fast path must not be constructors
+inline v8::Local<v8::FunctionTemplate> NewFunctionTemplate(v8::Isolate* isolate, v8::FunctionCallback callback,
+                                                           const v8::CFunction* fast,
+                                                           v8::Local<v8::Value> data = {}) {
+    if (!fast) {
+        return v8::FunctionTemplate::New(isolate, callback, data);
+    }
+    return v8::FunctionTemplate::New(isolate, callback, data, v8::Local<v8::Signature>(), 0,
+                                     v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+                                     fast);
+}
+
+template <auto F>
+v8::Local<v8::FunctionTemplate> NewFunctionTemplate(v8::Isolate* isolate) {
+    return NewFunctionTemplate(isolate, &Callback<F>, FastFunction<F>());
+}
+
+template <typename R, typename... Args>
+v8::Local<v8::FunctionTemplate> NewFunctionTemplate(v8::Isolate* isolate, R (*fn)(Args...)) {
+    return v8::FunctionTemplate::New(isolate, TrampolineFor(fn),
+                                     v8::External::New(isolate, TrampolineData(fn)));
+}
+
+// Entry in the table a DLL can export as
+//   extern "C" const v8integration::binding::NativeFunction* V8NativeFunctions();
+// terminated by an entry with a null name. DllLoader installs each entry on
+// the global object behind a reloadable trampoline, without its fast path;
+// NewFunctionTemplate binds one directly, with it.
+struct NativeFunction {
+    const char* name;
+    v8::FunctionCallback callback;
+    const v8::CFunction* fast;
+};
+
+// F is a plain C++ function to bind, or a v8::FunctionCallback used as is
+// (for functions that inspect their arguments themselves, e.g. to accept
+// several typed array kinds)
+template <auto F>
+constexpr NativeFunction Native(const char* name) {
+    if constexpr (std::is_same_v<decltype(F), v8::FunctionCallback>) {
+        return {name, F, nullptr};
+    } else {
+        return {name, &Callback<F>, FastFunction<F>()};
+    }
+}
+
+// Compact signature strings for manifests, e.g. "(u)l" for
+// long long(uint32_t) and "([d)d" for double(std::span<const double>):
+// b bool, i/u 32-bit ints, l/L 64-bit ints, d floating point, s string,
+// [x typed array or numeric vector of x, v void, * anything else; a raw
+// v8::FunctionCallback is just "*"
+namespace detail {
+
+template <const std::string_view&... Parts>
+struct Join {
+    static constexpr auto kChars = [] {
+        std::array<char, (Parts.size() + ... + 0) + 1> chars{};
+        size_t i = 0;
+        ((std::copy(Parts.begin(), Parts.end(), chars.begin() + i), i += Parts.size()), ...);
+        return chars;
+    }();
+    static constexpr std::string_view value{kChars.data(), kChars.size() - 1};
+};
+
+inline constexpr std::string_view kArrayCode = "[";
+inline constexpr std::string_view kOpenParen = "(";
+inline constexpr std::string_view kCloseParen = ")";
+
+template <typename T, typename = void>
+struct TypeCode {
+    static constexpr std::string_view value = "*";
+};
+
+template <> struct TypeCode<void> { static constexpr std::string_view value = "v"; };
+template <> struct TypeCode<bool> { static constexpr std::string_view value = "b"; };
+template <> struct TypeCode<std::string> { static constexpr std::string_view value = "s"; };
+template <> struct TypeCode<const char*> { static constexpr std::string_view value = "s"; };
+
+template <typename T>
+struct TypeCode<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static constexpr std::string_view value = sizeof(T) > 4 ? (std::is_signed_v<T> ? "l" : "L")
+                                                            : (std::is_signed_v<T> ? "i" : "u");
+};
+
+template <typename T>
+struct TypeCode<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static constexpr std::string_view value = "d";
+};
+
+template <typename T, T Min, T Max>
+struct TypeCode<InRange<T, Min, Max>> {
+    static constexpr std::string_view value = TypeCode<T>::value;
+};
+
+template <typename T>
+struct TypeCode<std::span<T>> {
+    static constexpr std::string_view value = Join<kArrayCode, TypeCode<std::remove_const_t<T>>::value>::value;
+};
+
+template <typename T>
+struct TypeCode<std::vector<T>, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    static constexpr std::string_view value = Join<kArrayCode, TypeCode<T>::value>::value;
+};
+
+template <typename Fn>
+struct SignatureOf;
+
+template <typename R, typename... Args>
+struct SignatureOf<R (*)(Args...)> {
+    static constexpr std::string_view value =
+        Join<kOpenParen, TypeCode<std::decay_t<Args>>::value..., kCloseParen, TypeCode<R>::value>::value;
+};
+
+template <>
+struct SignatureOf<v8::FunctionCallback> {
+    static constexpr std::string_view value = "*";
+};
+
+} // namespace detail
+
+// NUL-terminated, usable in static tables
+template <auto F>
+constexpr const char* kSignature = detail::SignatureOf<decltype(F)>::value.data();
+
+// A DLL manifest lists every function without resolving any of them:
+//
+//   extern "C" const v8integration::binding::ManifestEntry* V8Manifest();
+//
+// returns a table terminated by an entry with a null name. DllLoader
+// installs a lazy property per entry and looks up `symbol` (a
+// NativeResolver) only when the property is first read, so load time does
+// not grow with the number of exports. Generate both from one X-macro list:
+//
+//   #define FIB_FUNCTIONS(X) X(fib, calculateFibSum) X(fibN, fibonacci)
+//   FIB_FUNCTIONS(V8_NATIVE_EXPORT)
+//   V8_MANIFEST(FIB_FUNCTIONS)
+//
+// Manifest functions are called through DllLoader's reloadable slots and
+// never get a Fast API path (optimized code would keep calling the build
+// it was compiled against), so every call builds a FunctionCallbackInfo;
+// the DllNativeCall benchmark measures the difference on a scalar function.
+// DLLs that need fast calls register through RegisterV8Functions instead
+// and give up in-place reload.
+enum ManifestFlags : uint32_t {
+    kManifestEager = 1u << 0,  // resolve at load time
+};
+
+struct ManifestEntry {
+    const char* name;
+    const char* symbol;
+    const char* signature;
+    uint32_t flags;
+};
+
+using NativeResolver = const NativeFunction* (*)();
+
+} // namespace v8integration::binding
+
+#define V8_NATIVE_EXPORT(name, fn)                                                                  \
+    extern "C" const ::v8integration::binding::NativeFunction* v8native_##name() {                  \
+        static const ::v8integration::binding::NativeFunction function =                            \
+            ::v8integration::binding::Native<&fn>(#name);                                            \
+        return &function;                                                                           \
+    }
+
+#define V8_MANIFEST_ENTRY(name, fn)                                                                 \
+    {#name, "v8native_" #name, ::v8integration::binding::kSignature<&fn>, 0},
+
+#define V8_MANIFEST(list)                                                                           \
+    extern "C" const ::v8integration::binding::ManifestEntry* V8Manifest() {                        \
+        static constexpr ::v8integration::binding::ManifestEntry entries[] = {                      \
+            list(V8_MANIFEST_ENTRY){nullptr, nullptr, nullptr, 0}};                                 \
+        return entries;                                                                             \
+    }
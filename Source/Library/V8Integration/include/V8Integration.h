@@ -1,10 +1,15 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <functional>
 #include <vector>
+#include <span>
 #include <v8.h>
+#include "V8Binding.h"
+#include "V8Module.h"
+#include "V8Struct.h"
 
 namespace v8integration {
 
@@ -59,6 +64,31 @@ public:
     void RegisterFunction(const std::string& name, FunctionCallback callback);
     void RegisterFunctions(const std::vector<JSFunction>& functions);
     
+    // Register a raw V8 callback; `data` is passed through as a v8::External
+    void RegisterCallback(const std::string& name, v8::FunctionCallback callback, void* data = nullptr);
+    
+    // Register a slow callback together with a V8 Fast API equivalent
+    // (fast may be null)
+    void RegisterFunction(const std::string& name, v8::FunctionCallback slow, const v8::CFunction* fast);
+    
+    // Bind a plain C++ function, converting arguments and result by type:
+    //   v8.Bind("fib", &calculateFibSum);    // one callback per signature
+    //   v8.Bind<&calculateFibSum>("fib");    // one callback per function, direct call,
+    //                                        // plus a fast call for scalar signatures
+    template <typename R, typename... Args>
+    void Bind(const std::string& name, R (*fn)(Args...)) {
+        RegisterCallback(name, binding::TrampolineFor(fn), binding::TrampolineData(fn));
+    }
+    
+    template <auto F>
+    void Bind(const std::string& name) {
+        RegisterFunction(name, &binding::Callback<F>, binding::FastFunction<F>());
+    }
+    
+    // Install native modules (see V8Module.h); each namespace is created
+    // on first use
+    void InstallModules(std::span<const binding::Module* const> modules);
+    
     // Register global objects
     void RegisterGlobalObject(const std::string& name, v8::Local<v8::Object> object);
     
@@ -91,6 +121,33 @@ public:
     static std::string V8ToString(v8::Isolate* isolate, v8::Local<v8::Value> value);
     static v8::Local<v8::String> ToV8String(v8::Isolate* isolate, const std::string& str);
     
+    // UTF-8 view of a value, written into a reusable thread-local buffer;
+    // valid until the next call on the same thread
+    static std::string_view V8ToStringView(v8::Isolate* isolate, v8::Local<v8::Value> value);
+    
+    // Strings of at least kExternalStringThreshold characters are handed to
+    // V8 as external strings that own (or share) the buffer instead of being
+    // copied onto the V8 heap. ASCII text becomes a one-byte string; other
+    // UTF-8 is transcoded once into an owned two-byte string, except for
+    // shared buffers, which are copied.
+    static constexpr size_t kExternalStringThreshold = 4096;
+    static v8::Local<v8::String> ToV8String(v8::Isolate* isolate, std::string&& str);
+    static v8::Local<v8::String> ToV8String(v8::Isolate* isolate, std::u16string&& str);
+    static v8::Local<v8::String> ToV8String(v8::Isolate* isolate, std::shared_ptr<const std::string> str);
+    
+    // Numeric containers across the boundary in O(1): a vector's storage
+    // becomes the typed array's backing store (Float64Array for double,
+    // Int32Array for int32_t, ...), and a typed array is viewed in place
+    template <typename T>
+    static v8::Local<v8::TypedArray> ToTypedArray(v8::Isolate* isolate, std::vector<T>&& values) {
+        return binding::MoveToTypedArray(isolate, std::move(values));
+    }
+    
+    template <typename T>
+    static std::span<T> ViewTypedArray(v8::Local<v8::Value> value) {
+        return binding::ViewTypedArray<T>(value);
+    }
+    
     // Error handling
     std::string GetLastError() const;
     void ClearError();
@@ -110,6 +167,18 @@ public:
     JSObjectBuilder& AddProperty(const std::string& name, int value);
     JSObjectBuilder& AddProperty(const std::string& name, bool value);
     JSObjectBuilder& AddFunction(const std::string& name, FunctionCallback callback);
+    JSObjectBuilder& AddFunction(const std::string& name, v8::FunctionCallback slow, const v8::CFunction* fast);
+    JSObjectBuilder& AddCallback(const std::string& name, v8::FunctionCallback callback, void* data = nullptr);
+    
+    template <typename R, typename... Args>
+    JSObjectBuilder& Bind(const std::string& name, R (*fn)(Args...)) {
+        return AddCallback(name, binding::TrampolineFor(fn), binding::TrampolineData(fn));
+    }
+    
+    template <auto F>
+    JSObjectBuilder& Bind(const std::string& name) {
+        return AddFunction(name, &binding::Callback<F>, binding::FastFunction<F>());
+    }
     
     v8::Local<v8::Object> Build();
 
@@ -134,4 +203,51 @@ public:
     explicit V8Exception(const std::string& message) : std::runtime_error(message) {}
 };
 
+// Builds many objects with one property layout. The layout's ObjectTemplate
+// and property name strings are created once per isolate and cached, each
+// object is instantiated from the template (so all of them share one
+// fast-mode hidden class) and values are filled in by position:
+//
+//   ShapedObjectBuilder rows(isolate, {"id", "name", "score"});
+//   for (const auto& r : results) {
+//       array->Set(context, i++, rows.Build(r.id, r.name, r.score));
+//   }
+//
+// Must be used inside a HandleScope with a context entered; the handles it
+// holds live in that scope.
+class ShapedObjectBuilder {
+public:
+    ShapedObjectBuilder(v8::Isolate* isolate, const std::vector<std::string>& properties);
+    
+    size_t Size() const { return names_.size(); }
+    
+    // New object with every property present and undefined
+    v8::Local<v8::Object> New() const;
+    
+    // Set the property at `index` in the layout
+    void Set(v8::Local<v8::Object> object, size_t index, v8::Local<v8::Value> value) const;
+    
+    // New object with values converted by binding::Converter, in layout order
+    template <typename... Ts>
+    v8::Local<v8::Object> Build(const Ts&... values) const {
+        if (sizeof...(Ts) != names_.size()) {
+            throw V8Exception("ShapedObjectBuilder::Build: expected " + std::to_string(names_.size()) +
+                              " values, got " + std::to_string(sizeof...(Ts)));
+        }
+        v8::Local<v8::Object> object = New();
+        size_t index = 0;
+        (Set(object, index++, binding::Converter<std::decay_t<Ts>>::ToV8(isolate_, values)), ...);
+        return object;
+    }
+    
+    // Layouts cached for `isolate`; binding::ReleaseIsolate() frees them
+    static size_t CachedShapeCount(v8::Isolate* isolate);
+
+private:
+    v8::Isolate* isolate_;
+    v8::Local<v8::Context> context_;
+    v8::Local<v8::ObjectTemplate> template_;
+    std::vector<v8::Local<v8::String>> names_;
+};
+
 } // namespace v8integration
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <v8.h>
+#include "V8Binding.h"
+
+// Native modules: functions grouped under a namespace object on the global,
+// declared as constant tables rather than registered at static-init time:
+//
+//   #define MATH_FUNCTIONS(X) X(add, MathAdd) X(power, MathPower)
+//   V8_MODULE(kMathModule, "math", "1.0.0", MATH_FUNCTIONS)
+//
+//   constexpr const binding::Module* kModules[] = {&kMathModule, &kStringModule};
+//   binding::InstallModules(isolate, context, kModules);
+//
+// A module's namespace is an ObjectTemplate holding one FunctionTemplate per
+// function (with its fast path), built the first time the module is used in
+// an isolate and cached. Installing only defines a lazy property per module
+// on the global object; the namespace object is instantiated from the
+// template when JS first reads it, so a context pays nothing for modules it
+// never touches. A module with a null name puts its functions directly on
+// the global object, each as its own lazy property.
+//
+// A namespace also carries the module's version as a read-only,
+// non-enumerable `version` property (math.version === "1.0.0"), unless one
+// of its functions has that name.
+//
+// Caches are keyed by address, so Modules and their function tables need
+// static storage duration (V8_MODULE provides it).
+namespace v8integration::binding {
+
+struct Module {
+    const char* name;  // global holding the namespace, or nullptr
+    const char* version;  // or nullptr
+    std::span<const NativeFunction> functions;
+};
+
+namespace detail {
+
+// Keyed by address: modules and their tables have static storage
+struct ModuleTemplates {
+    std::unordered_map<const Module*, v8::Eternal<v8::ObjectTemplate>> namespaces;
+    std::unordered_map<const NativeFunction*, v8::Eternal<v8::FunctionTemplate>> functions;
+    std::unordered_map<const void*, v8::Eternal<v8::External>> externals;
+};
+
+inline ModuleTemplates& TemplatesOf(v8::Isolate* isolate) {
+    return PerIsolate<ModuleTemplates>::Get(isolate, [](v8::Isolate*, ModuleTemplates&) {});
+}
+
+// Lazy property data; Externals are not tied to a context, so one per
+// isolate serves every install
+inline v8::Local<v8::External> ExternalOf(v8::Isolate* isolate, const void* pointer) {
+    auto& externals = TemplatesOf(isolate).externals;
+    auto it = externals.find(pointer);
+    if (it == externals.end()) {
+        v8::Local<v8::External> external = v8::External::New(isolate, const_cast<void*>(pointer));
+        it = externals.emplace(pointer, v8::Eternal<v8::External>(isolate, external)).first;
+    }
+    return it->second.Get(isolate);
+}
+
+inline v8::Local<v8::FunctionTemplate> FunctionTemplateOf(v8::Isolate* isolate, const NativeFunction& function) {
+    auto& functions = TemplatesOf(isolate).functions;
+    auto it = functions.find(&function);
+    if (it == functions.end()) {
+        v8::Local<v8::FunctionTemplate> function_template =
+            NewFunctionTemplate(isolate, function.callback, function.fast);
+        it = functions.emplace(&function, v8::Eternal<v8::FunctionTemplate>(isolate, function_template)).first;
+    }
+    return it->second.Get(isolate);
+}
+
+} // namespace detail
+
+// The cached namespace template of `module`
+inline v8::Local<v8::ObjectTemplate> ModuleTemplate(v8::Isolate* isolate, const Module& module) {
+    auto& namespaces = detail::TemplatesOf(isolate).namespaces;
+    auto it = namespaces.find(&module);
+    if (it != namespaces.end()) {
+        return it->second.Get(isolate);
+    }
+
+    v8::Local<v8::ObjectTemplate> object_template = v8::ObjectTemplate::New(isolate);
+    bool has_version_function = false;
+    for (const NativeFunction& function : module.functions) {
+        object_template->Set(Intern(isolate, function.name), detail::FunctionTemplateOf(isolate, function));
+        has_version_function = has_version_function || std::string_view(function.name) == "version";
+    }
+    if (module.version && !has_version_function) {
+        object_template->Set(Intern<"version">(isolate),
+                             v8::String::NewFromUtf8(isolate, module.version).ToLocalChecked(),
+                             static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontEnum | v8::DontDelete));
+    }
+    namespaces.emplace(&module, v8::Eternal<v8::ObjectTemplate>(isolate, object_template));
+    return object_template;
+}
+
+// A new namespace object for `module`, e.g. for a require()-style lookup
+inline v8::MaybeLocal<v8::Object> NewModuleInstance(v8::Local<v8::Context> context, const Module& module) {
+    return ModuleTemplate(context->GetIsolate(), module)->NewInstance(context);
+}
+
+namespace detail {
+
+inline void InstantiateModule(v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value>& info) {
+    v8::Isolate* isolate = info.GetIsolate();
+    const auto* module = static_cast<const Module*>(info.Data().As<v8::External>()->Value());
+    v8::Local<v8::Object> instance;
+    if (NewModuleInstance(isolate->GetCurrentContext(), *module).ToLocal(&instance)) {
+        info.GetReturnValue().Set(instance);
+    }
+}
+
+inline void InstantiateFunction(v8::Local<v8::Name>, const v8::PropertyCallbackInfo<v8::Value>& info) {
+    v8::Isolate* isolate = info.GetIsolate();
+    const auto* function = static_cast<const NativeFunction*>(info.Data().As<v8::External>()->Value());
+    v8::Local<v8::Function> instance;
+    if (FunctionTemplateOf(isolate, *function)->GetFunction(isolate->GetCurrentContext()).ToLocal(&instance)) {
+        info.GetReturnValue().Set(instance);
+    }
+}
+
+} // namespace detail
+
+// Define a lazy global per module (or per function, for unnamed modules).
+// Must run inside a HandleScope; V8 replaces each property with its value
+// on first read.
+inline void InstallModules(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                           std::span<const Module* const> modules) {
+    v8::Local<v8::Object> global = context->Global();
+    for (const Module* module : modules) {
+        if (module->name) {
+            global->SetLazyDataProperty(context, Intern(isolate, module->name), detail::InstantiateModule,
+                                        detail::ExternalOf(isolate, module)).Check();
+            continue;
+        }
+        for (const NativeFunction& function : module->functions) {
+            global->SetLazyDataProperty(context, Intern(isolate, function.name), detail::InstantiateFunction,
+                                        detail::ExternalOf(isolate, &function)).Check();
+        }
+    }
+}
+
+inline void InstallModule(v8::Isolate* isolate, v8::Local<v8::Context> context, const Module& module) {
+    const Module* modules[] = {&module};
+    InstallModules(isolate, context, modules);
+}
+
+} // namespace v8integration::binding
+
+// V8_MODULE(variable, "name", "version", LIST) defines a constexpr Module
+// from an X-macro list of (JS name, C++ function or v8::FunctionCallback)
+// pairs, as used by V8_MANIFEST. Pass nullptr as the name for functions
+// that belong on the global object.
+#define V8_MODULE_FUNCTION(name, fn) ::v8integration::binding::Native<&fn>(#name),
+
+#define V8_MODULE(variable, name, version, list)                                                    \
+    inline constexpr ::v8integration::binding::NativeFunction variable##Functions[] = {             \
+        list(V8_MODULE_FUNCTION)};                                                                  \
+    inline constexpr ::v8integration::binding::Module variable{name, version, variable##Functions};
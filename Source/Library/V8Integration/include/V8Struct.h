@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "V8Binding.h"
+
+// Reflection-based marshalling between C++ structs and JavaScript objects,
+// without a JSON.stringify / parse round trip:
+//
+//   struct Order { std::string id; double total; std::vector<Item> items; };
+//   V8_STRUCT(Order, id, total, items)
+//
+// declares the field list once; Order then converts like any other bound
+// type (as an argument or result of Bind, or through ToV8/FromV8 below).
+// Property names are internalized once per isolate and held as Eternals,
+// and objects are instantiated from a cached ObjectTemplate so every Order
+// shares one hidden class.
+//
+// Missing (undefined) properties leave the C++ field at its default;
+// present but mistyped ones fail the conversion, and the error names the
+// field ("Argument 1: items[0].quantity must be a number"). Numeric vectors become
+// typed arrays (plain arrays are accepted on input); other vectors become
+// Arrays; std::optional maps to undefined.
+namespace v8integration::binding {
+
+template <typename S, typename M>
+struct Field {
+    const char* name;
+    M S::*member;
+};
+
+template <typename S, typename M>
+constexpr Field<S, M> MakeField(const char* name, M S::*member) {
+    return {name, member};
+}
+
+// Specialize with `static constexpr auto fields = std::make_tuple(MakeField(...), ...)`,
+// or use V8_STRUCT
+template <typename S>
+struct StructInfo;
+
+namespace detail {
+
+template <typename S>
+constexpr size_t kFieldCount = std::tuple_size_v<std::decay_t<decltype(StructInfo<S>::fields)>>;
+
+template <typename S>
+struct StructShape {
+    std::array<v8::Eternal<v8::String>, kFieldCount<S>> names;
+    v8::Eternal<v8::ObjectTemplate> object_template;
+};
+
+template <typename S>
+const StructShape<S>& ShapeOf(v8::Isolate* isolate) {
+    return PerIsolate<StructShape<S>>::Get(isolate, [](v8::Isolate* isolate, StructShape<S>& shape) {
+        v8::Local<v8::ObjectTemplate> object_template = v8::ObjectTemplate::New(isolate);
+        size_t index = 0;
+        std::apply([&](const auto&... field) {
+            ((shape.names[index++].Set(isolate, v8::String::NewFromUtf8(isolate, field.name,
+                                                                        v8::NewStringType::kInternalized)
+                                                    .ToLocalChecked())),
+             ...);
+        }, StructInfo<S>::fields);
+        for (auto& name : shape.names) {
+            object_template->Set(name.Get(isolate), v8::Undefined(isolate));
+        }
+        shape.object_template.Set(isolate, object_template);
+    });
+}
+
+} // namespace detail
+
+template <typename S>
+struct Converter<S, std::void_t<decltype(StructInfo<S>::fields)>> {
+    static constexpr const char* kExpected = "an object";
+    static constexpr bool kNested = true;
+
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, S& out) {
+        if (!value->IsObject()) return detail::FailCompound(Conversion::WRONG_TYPE);
+        v8::Local<v8::Object> object = value.As<v8::Object>();
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const auto& shape = detail::ShapeOf<S>(isolate);
+
+        Conversion result = Conversion::OK;
+        size_t index = 0;
+        std::apply([&](const auto&... field) {
+            (ReadField(isolate, context, object, shape.names[index++].Get(isolate), field.name,
+                       out.*(field.member), result) &&
+             ...);
+        }, StructInfo<S>::fields);
+        return result;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const S& value) {
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const auto& shape = detail::ShapeOf<S>(isolate);
+        v8::Local<v8::Object> object = shape.object_template.Get(isolate)->NewInstance(context).ToLocalChecked();
+
+        size_t index = 0;
+        std::apply([&](const auto&... field) {
+            (object->Set(context, shape.names[index++].Get(isolate),
+                         Converter<std::decay_t<decltype(value.*(field.member))>>::ToV8(isolate, value.*(field.member)))
+                 .Check(),
+             ...);
+        }, StructInfo<S>::fields);
+        return object;
+    }
+
+private:
+    template <typename M>
+    static bool ReadField(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> object,
+                          v8::Local<v8::String> name, const char* field_name, M& out, Conversion& result) {
+        v8::Local<v8::Value> property;
+        if (!object->Get(context, name).ToLocal(&property)) {
+            result = detail::FailCompound(Conversion::WRONG_TYPE);
+            return false;
+        }
+        if (property->IsUndefined()) return true;
+        result = Converter<M>::FromV8(isolate, property, out);
+        if (result == Conversion::OK) return true;
+        char segment[128];
+        std::snprintf(segment, sizeof(segment), ".%s", field_name);
+        detail::FailElement<M>(result, segment);
+        return false;
+    }
+};
+
+template <typename T>
+struct Converter<std::optional<T>> {
+    static constexpr const char* kExpected = Converter<T>::kExpected;
+    static constexpr bool kNested = detail::kNestedConverter<T>;
+
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, std::optional<T>& out) {
+        if (value->IsNullOrUndefined()) {
+            out.reset();
+            return Conversion::OK;
+        }
+        T converted{};
+        Conversion result = Converter<T>::FromV8(isolate, value, converted);
+        if (result == Conversion::OK) {
+            out = std::move(converted);
+        }
+        return result;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const std::optional<T>& value) {
+        if (!value) return v8::Undefined(isolate);
+        return Converter<T>::ToV8(isolate, *value);
+    }
+};
+
+// Vectors of non-numeric elements (strings, structs, ...) are plain Arrays
+template <typename T>
+struct Converter<std::vector<T>, std::enable_if_t<!std::is_arithmetic_v<T>>> {
+    static constexpr const char* kExpected = "an array";
+    static constexpr bool kNested = true;
+
+    static Conversion FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, std::vector<T>& out) {
+        if (!value->IsArray()) return detail::FailCompound(Conversion::WRONG_TYPE);
+        v8::Local<v8::Array> array = value.As<v8::Array>();
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        // Read once: Get() can run getters that resize the array
+        const uint32_t length = array->Length();
+        out.resize(length);
+        for (uint32_t i = 0; i < length; ++i) {
+            v8::Local<v8::Value> element;
+            if (!array->Get(context, i).ToLocal(&element)) return detail::FailCompound(Conversion::WRONG_TYPE);
+            Conversion result = Converter<T>::FromV8(isolate, element, out[i]);
+            if (result != Conversion::OK) {
+                char segment[16];
+                std::snprintf(segment, sizeof(segment), "[%u]", i);
+                return detail::FailElement<T>(result, segment);
+            }
+        }
+        return Conversion::OK;
+    }
+
+    static v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const std::vector<T>& value) {
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Local<v8::Array> array = v8::Array::New(isolate, static_cast<int>(value.size()));
+        for (size_t i = 0; i < value.size(); ++i) {
+            array->Set(context, static_cast<uint32_t>(i), Converter<T>::ToV8(isolate, value[i])).Check();
+        }
+        return array;
+    }
+};
+
+// Struct (or any bound type) to and from a JS value. FromV8 returns false,
+// leaving `out` partially filled, if a present property has the wrong type.
+template <typename T>
+v8::Local<v8::Value> ToV8(v8::Isolate* isolate, const T& value) {
+    return Converter<T>::ToV8(isolate, value);
+}
+
+template <typename T>
+bool FromV8(v8::Isolate* isolate, v8::Local<v8::Value> value, T& out) {
+    return Converter<T>::FromV8(isolate, value, out) == Conversion::OK;
+}
+
+} // namespace v8integration::binding
+
+// V8_STRUCT(Type, field1, field2, ...) for up to 16 fields
+#define V8_STRUCT_FIELD(T, f) ::v8integration::binding::MakeField(#f, &T::f)
+#define V8_STRUCT_EXPAND(x) x
+#define V8_STRUCT_F1(T, a) V8_STRUCT_FIELD(T, a)
+#define V8_STRUCT_F2(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F1(T, __VA_ARGS__))
+#define V8_STRUCT_F3(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F2(T, __VA_ARGS__))
+#define V8_STRUCT_F4(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F3(T, __VA_ARGS__))
+#define V8_STRUCT_F5(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F4(T, __VA_ARGS__))
+#define V8_STRUCT_F6(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F5(T, __VA_ARGS__))
+#define V8_STRUCT_F7(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F6(T, __VA_ARGS__))
+#define V8_STRUCT_F8(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F7(T, __VA_ARGS__))
+#define V8_STRUCT_F9(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F8(T, __VA_ARGS__))
+#define V8_STRUCT_F10(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F9(T, __VA_ARGS__))
+#define V8_STRUCT_F11(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F10(T, __VA_ARGS__))
+#define V8_STRUCT_F12(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F11(T, __VA_ARGS__))
+#define V8_STRUCT_F13(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F12(T, __VA_ARGS__))
+#define V8_STRUCT_F14(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F13(T, __VA_ARGS__))
+#define V8_STRUCT_F15(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F14(T, __VA_ARGS__))
+#define V8_STRUCT_F16(T, a, ...) V8_STRUCT_FIELD(T, a), V8_STRUCT_EXPAND(V8_STRUCT_F15(T, __VA_ARGS__))
+#define V8_STRUCT_COUNT(...) \
+    V8_STRUCT_EXPAND(V8_STRUCT_COUNT_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define V8_STRUCT_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define V8_STRUCT_CAT(a, b) V8_STRUCT_CAT_(a, b)
+#define V8_STRUCT_CAT_(a, b) a##b
+
+#define V8_STRUCT(Type, ...)                                                                     \
+    template <>                                                                                  \
+    struct v8integration::binding::StructInfo<Type> {                                            \
+        static constexpr auto fields = std::make_tuple(                                          \
+            V8_STRUCT_EXPAND(V8_STRUCT_CAT(V8_STRUCT_F, V8_STRUCT_COUNT(__VA_ARGS__))(Type, __VA_ARGS__))); \
+    };
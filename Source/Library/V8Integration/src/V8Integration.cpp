@@ -4,7 +4,9 @@
 #include <fstream>
 #include <sstream>
 #include <memory>
+#include <cstring>
 #include <map>
+#include <unordered_map>
 #include <mutex>
 
 namespace v8integration {
@@ -14,6 +16,25 @@ static std::unique_ptr<v8::Platform> g_platform = nullptr;
 static int g_platform_ref_count = 0;
 static std::mutex g_platform_mutex;
 
+// ShapedObjectBuilder layouts, keyed by the joined property names. Held
+// per isolate as Eternals, like interned names, so they share the
+// isolate's lifetime instead of needing a release before Dispose().
+struct ObjectShape {
+    v8::Eternal<v8::ObjectTemplate> object_template;
+    std::vector<v8::Eternal<v8::String>> names;
+};
+struct ObjectShapes {
+    std::unordered_map<std::string, ObjectShape> layouts;
+};
+
+// Eternals are never freed, so past this many layouts further ones are
+// built per builder rather than cached
+constexpr size_t kMaxCachedShapes = 256;
+
+static ObjectShapes& ShapesOf(v8::Isolate* isolate) {
+    return binding::PerIsolate<ObjectShapes>::Get(isolate, [](v8::Isolate*, ObjectShapes&) {});
+}
+
 // Private implementation class
 class V8IntegrationImpl {
 public:
@@ -85,6 +106,7 @@ public:
         dllLoader_.UnloadAll();
         
         // Clean up V8
+        binding::ReleaseIsolate(isolate_);
         context_.Reset();
         
         if (isolate_) {
@@ -161,10 +183,42 @@ public:
         
         // Register in global object
         v8::Local<v8::Object> global = context->Global();
-        global->Set(context, ToV8String(isolate_, name), 
+        global->Set(context, binding::Intern(isolate_, name), 
                    func_template->GetFunction(context).ToLocalChecked()).Check();
     }
     
+    void RegisterCallback(const std::string& name, v8::FunctionCallback callback, void* data,
+                          const v8::CFunction* fast) {
+        if (!isolate_) return;
+        
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+        
+        // No wrapper: V8 calls `callback` (or `fast` from optimized code) directly
+        v8::Local<v8::Value> external;
+        if (data) {
+            external = v8::External::New(isolate_, data);
+        }
+        v8::Local<v8::FunctionTemplate> func_template =
+            binding::NewFunctionTemplate(isolate_, callback, fast, external);
+        
+        context->Global()->Set(context, binding::Intern(isolate_, name),
+                               func_template->GetFunction(context).ToLocalChecked()).Check();
+    }
+    
+    void InstallModules(std::span<const binding::Module* const> modules) {
+        if (!isolate_) return;
+        
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+        
+        binding::InstallModules(isolate_, context, modules);
+    }
+    
     std::vector<std::string> GetObjectProperties(const std::string& objectPath) {
         std::vector<std::string> properties;
         if (!isolate_) return properties;
@@ -187,7 +241,7 @@ public:
             while (std::getline(ss, part, '.')) {
                 if (part.empty()) continue;
                 
-                v8::Local<v8::String> key = ToV8String(isolate_, part);
+                v8::Local<v8::String> key = binding::Intern(isolate_, part);
                 v8::Local<v8::Value> value;
                 
                 if (!obj->Get(context, key).ToLocal(&value)) {
@@ -326,6 +380,18 @@ void V8Integration::RegisterFunctions(const std::vector<JSFunction>& functions)
     }
 }
 
+void V8Integration::RegisterFunction(const std::string& name, v8::FunctionCallback slow, const v8::CFunction* fast) {
+    impl_->RegisterCallback(name, slow, nullptr, fast);
+}
+
+void V8Integration::RegisterCallback(const std::string& name, v8::FunctionCallback callback, void* data) {
+    impl_->RegisterCallback(name, callback, data, nullptr);
+}
+
+void V8Integration::InstallModules(std::span<const binding::Module* const> modules) {
+    impl_->InstallModules(modules);
+}
+
 v8::Isolate* V8Integration::GetIsolate() const {
     return impl_->isolate_;
 }
@@ -378,10 +444,96 @@ bool V8Integration::LoadDll(const std::string& path) {
     return false;
 }
 
+// External string resources. V8 reads the characters in place and calls
+// Dispose() (deleting the resource) when the string is collected.
+namespace {
+    class OwnedOneByteString : public v8::String::ExternalOneByteStringResource {
+    public:
+        explicit OwnedOneByteString(std::string data) : data_(std::move(data)) {}
+        const char* data() const override { return data_.data(); }
+        size_t length() const override { return data_.size(); }
+    private:
+        std::string data_;
+    };
+    
+    class SharedOneByteString : public v8::String::ExternalOneByteStringResource {
+    public:
+        explicit SharedOneByteString(std::shared_ptr<const std::string> data) : data_(std::move(data)) {}
+        const char* data() const override { return data_->data(); }
+        size_t length() const override { return data_->size(); }
+    private:
+        std::shared_ptr<const std::string> data_;
+    };
+    
+    class OwnedTwoByteString : public v8::String::ExternalStringResource {
+    public:
+        explicit OwnedTwoByteString(std::u16string data) : data_(std::move(data)) {}
+        const uint16_t* data() const override { return reinterpret_cast<const uint16_t*>(data_.data()); }
+        size_t length() const override { return data_.size(); }
+    private:
+        std::u16string data_;
+    };
+    
+    // One-byte external strings are Latin-1, which only matches UTF-8 for ASCII
+    bool IsAscii(const std::string& str) {
+        const char* p = str.data();
+        size_t n = str.size();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, p + i, 8);
+            if (word & 0x8080808080808080ull) return false;
+        }
+        for (; i < n; ++i) {
+            if (static_cast<unsigned char>(p[i]) & 0x80) return false;
+        }
+        return true;
+    }
+    
+    // Malformed sequences become U+FFFD, as String::NewFromUtf8 does
+    std::u16string Utf8ToUtf16(const std::string& str) {
+        std::u16string out;
+        out.reserve(str.size());
+        const auto* p = reinterpret_cast<const unsigned char*>(str.data());
+        size_t n = str.size();
+        size_t i = 0;
+        while (i < n) {
+            unsigned char c = p[i];
+            uint32_t cp;
+            size_t extra;
+            if (c < 0x80) { cp = c; extra = 0; }
+            else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; extra = 1; }
+            else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; extra = 2; }
+            else if ((c & 0xF8) == 0xF0) { cp = c & 0x07; extra = 3; }
+            else { out.push_back(u'\uFFFD'); ++i; continue; }
+            
+            size_t j = 1;
+            for (; j <= extra && i + j < n && (p[i + j] & 0xC0) == 0x80; ++j) {
+                cp = (cp << 6) | (p[i + j] & 0x3F);
+            }
+            bool overlong = (extra == 1 && cp < 0x80) || (extra == 2 && cp < 0x800) || (extra == 3 && cp < 0x10000);
+            if (j <= extra || overlong || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                out.push_back(u'\uFFFD');
+                i += j;
+                continue;
+            }
+            i += j;
+            if (cp >= 0x10000) {
+                cp -= 0x10000;
+                out.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+                out.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+            } else {
+                out.push_back(static_cast<char16_t>(cp));
+            }
+        }
+        return out;
+    }
+}
+
 // Static utility functions
-std::string V8Integration::V8ToString(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+std::string_view V8Integration::V8ToStringView(v8::Isolate* isolate, v8::Local<v8::Value> value) {
     if (value.IsEmpty()) {
-        return "";
+        return {};
     }
     if (value->IsUndefined()) {
         return "undefined";
@@ -389,14 +541,78 @@ std::string V8Integration::V8ToString(v8::Isolate* isolate, v8::Local<v8::Value>
     if (value->IsNull()) {
         return "null";
     }
-    v8::String::Utf8Value utf8(isolate, value);
-    return std::string(*utf8);
+    
+    v8::Local<v8::String> str;
+    if (value->IsString()) {
+        str = value.As<v8::String>();
+    } else {
+        v8::TryCatch try_catch(isolate);
+        if (!value->ToString(isolate->GetCurrentContext()).ToLocal(&str)) {
+            return {};
+        }
+    }
+    
+    // Reused per thread, so steady-state conversions do not allocate
+    thread_local std::string buffer;
+    int length = str->Length();
+    
+    // One-byte strings are copied out directly; if they are all ASCII the
+    // Latin-1 bytes are already valid UTF-8
+    if (str->IsOneByte()) {
+        buffer.resize(static_cast<size_t>(length));
+        str->WriteOneByte(isolate, reinterpret_cast<uint8_t*>(buffer.data()), 0, length,
+                          v8::String::NO_NULL_TERMINATION);
+        if (IsAscii(buffer)) {
+            return buffer;
+        }
+    }
+    
+    buffer.resize(static_cast<size_t>(str->Utf8Length(isolate)));
+    str->WriteUtf8(isolate, buffer.data(), static_cast<int>(buffer.size()), nullptr,
+                   v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+    return buffer;
+}
+
+std::string V8Integration::V8ToString(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+    return std::string(V8ToStringView(isolate, value));
 }
 
 v8::Local<v8::String> V8Integration::ToV8String(v8::Isolate* isolate, const std::string& str) {
     return V8IntegrationImpl::ToV8String(isolate, str);
 }
 
+v8::Local<v8::String> V8Integration::ToV8String(v8::Isolate* isolate, std::string&& str) {
+    if (str.size() < kExternalStringThreshold) {
+        return V8IntegrationImpl::ToV8String(isolate, str);
+    }
+    if (IsAscii(str)) {
+        auto* resource = new OwnedOneByteString(std::move(str));
+        return v8::String::NewExternalOneByte(isolate, resource).ToLocalChecked();
+    }
+    return ToV8String(isolate, Utf8ToUtf16(str));
+}
+
+v8::Local<v8::String> V8Integration::ToV8String(v8::Isolate* isolate, std::u16string&& str) {
+    if (str.size() < kExternalStringThreshold) {
+        return v8::String::NewFromTwoByte(isolate, reinterpret_cast<const uint16_t*>(str.data()),
+                                          v8::NewStringType::kNormal, static_cast<int>(str.size())).ToLocalChecked();
+    }
+    auto* resource = new OwnedTwoByteString(std::move(str));
+    return v8::String::NewExternalTwoByte(isolate, resource).ToLocalChecked();
+}
+
+v8::Local<v8::String> V8Integration::ToV8String(v8::Isolate* isolate, std::shared_ptr<const std::string> str) {
+    if (!str) {
+        return v8::String::Empty(isolate);
+    }
+    // Shared buffers cannot be transcoded in place; non-ASCII text is copied
+    if (str->size() < kExternalStringThreshold || !IsAscii(*str)) {
+        return V8IntegrationImpl::ToV8String(isolate, *str);
+    }
+    auto* resource = new SharedOneByteString(std::move(str));
+    return v8::String::NewExternalOneByte(isolate, resource).ToLocalChecked();
+}
+
 // V8Scope implementation
 // V8Scope implementation
 V8Scope::V8Scope(V8Integration& v8) {
@@ -420,7 +636,7 @@ JSObjectBuilder::JSObjectBuilder(v8::Isolate* isolate)
 }
 
 JSObjectBuilder& JSObjectBuilder::AddProperty(const std::string& name, v8::Local<v8::Value> value) {
-    object_->Set(context_, V8Integration::ToV8String(isolate_, name), value).Check();
+    object_->Set(context_, binding::Intern(isolate_, name), value).Check();
     return *this;
 }
 
@@ -456,7 +672,28 @@ JSObjectBuilder& JSObjectBuilder::AddFunction(const std::string& name, FunctionC
                 }
             }, data);
     
-    object_->Set(context_, V8Integration::ToV8String(isolate_, name), 
+    object_->Set(context_, binding::Intern(isolate_, name), 
+                func_template->GetFunction(context_).ToLocalChecked()).Check();
+    return *this;
+}
+
+JSObjectBuilder& JSObjectBuilder::AddFunction(const std::string& name, v8::FunctionCallback slow,
+                                              const v8::CFunction* fast) {
+    v8::Local<v8::FunctionTemplate> func_template = binding::NewFunctionTemplate(isolate_, slow, fast);
+    
+    object_->Set(context_, binding::Intern(isolate_, name), 
+                func_template->GetFunction(context_).ToLocalChecked()).Check();
+    return *this;
+}
+
+JSObjectBuilder& JSObjectBuilder::AddCallback(const std::string& name, v8::FunctionCallback callback, void* data) {
+    v8::Local<v8::Value> external;
+    if (data) {
+        external = v8::External::New(isolate_, data);
+    }
+    v8::Local<v8::FunctionTemplate> func_template = v8::FunctionTemplate::New(isolate_, callback, external);
+    
+    object_->Set(context_, binding::Intern(isolate_, name), 
                 func_template->GetFunction(context_).ToLocalChecked()).Check();
     return *this;
 }
@@ -465,4 +702,58 @@ v8::Local<v8::Object> JSObjectBuilder::Build() {
     return object_;
 }
 
+// ShapedObjectBuilder implementation
+ShapedObjectBuilder::ShapedObjectBuilder(v8::Isolate* isolate, const std::vector<std::string>& properties)
+    : isolate_(isolate)
+    , context_(isolate->GetCurrentContext()) {
+    std::string key;
+    for (const auto& name : properties) {
+        key += name;
+        key += '\0';
+    }
+    
+    auto& layouts = ShapesOf(isolate_).layouts;
+    auto it = layouts.find(key);
+    if (it != layouts.end()) {
+        template_ = it->second.object_template.Get(isolate_);
+        names_.reserve(it->second.names.size());
+        for (const auto& name : it->second.names) {
+            names_.push_back(name.Get(isolate_));
+        }
+        return;
+    }
+    
+    template_ = v8::ObjectTemplate::New(isolate_);
+    names_.reserve(properties.size());
+    for (const auto& name : properties) {
+        v8::Local<v8::String> v8_name = binding::Intern(isolate_, name);
+        template_->Set(v8_name, v8::Undefined(isolate_));
+        names_.push_back(v8_name);
+    }
+    if (layouts.size() < kMaxCachedShapes) {
+        ObjectShape& shape = layouts[key];
+        shape.object_template.Set(isolate_, template_);
+        for (const auto& name : names_) {
+            shape.names.emplace_back(isolate_, name);
+        }
+    }
+}
+
+v8::Local<v8::Object> ShapedObjectBuilder::New() const {
+    return template_->NewInstance(context_).ToLocalChecked();
+}
+
+void ShapedObjectBuilder::Set(v8::Local<v8::Object> object, size_t index, v8::Local<v8::Value> value) const {
+    if (index >= names_.size()) {
+        throw V8Exception("ShapedObjectBuilder::Set: index " + std::to_string(index) + " out of range");
+    }
+    // The property already exists on the instance, so this is a store into
+    // an existing field rather than a map transition
+    object->Set(context_, names_[index], value).Check();
+}
+
+size_t ShapedObjectBuilder::CachedShapeCount(v8::Isolate* isolate) {
+    return ShapesOf(isolate).layouts.size();
+}
+
 } // namespace v8integration
\ No newline at end of file
@@ -11,6 +11,18 @@
 
 namespace v8_integration {
 
+namespace {
+    // Series with different labels are stored separately
+    std::string metricKey(const std::string& name, const char* suffix,
+                          const std::map<std::string, std::string>& labels) {
+        std::string key = name + suffix;
+        for (const auto& [label_key, label_value] : labels) {
+            key += '\0' + label_key + '=' + label_value;
+        }
+        return key;
+    }
+}
+
 // MetricsCollector Implementation
 MetricsCollector& MetricsCollector::getInstance() {
     static MetricsCollector instance;
@@ -21,7 +33,7 @@ void MetricsCollector::incrementCounter(const std::string& name, double value,
                                        const std::map<std::string, std::string>& labels) {
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     
-    std::string key = name + "_counter";
+    std::string key = metricKey(name, "_counter", labels);
     if (metrics_.find(key) == metrics_.end()) {
         metrics_[key] = {"v8_" + name, "counter", "Counter metric for " + name, labels, 0.0, 
                         std::chrono::system_clock::now()};
@@ -35,7 +47,7 @@ void MetricsCollector::setGauge(const std::string& name, double value,
                                const std::map<std::string, std::string>& labels) {
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     
-    std::string key = name + "_gauge";
+    std::string key = metricKey(name, "_gauge", labels);
     metrics_[key] = {"v8_" + name, "gauge", "Gauge metric for " + name, labels, value,
                      std::chrono::system_clock::now()};
 }
@@ -44,7 +56,7 @@ void MetricsCollector::recordHistogram(const std::string& name, double value,
                                       const std::map<std::string, std::string>& labels) {
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     
-    std::string key = name + "_histogram";
+    std::string key = metricKey(name, "_histogram", labels);
     metrics_[key] = {"v8_" + name, "histogram", "Histogram metric for " + name, labels, value,
                      std::chrono::system_clock::now()};
 }
@@ -53,7 +65,7 @@ void MetricsCollector::recordSummary(const std::string& name, double value,
                                     const std::map<std::string, std::string>& labels) {
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     
-    std::string key = name + "_summary";
+    std::string key = metricKey(name, "_summary", labels);
     metrics_[key] = {"v8_" + name, "summary", "Summary metric for " + name, labels, value,
                      std::chrono::system_clock::now()};
 }
@@ -327,12 +339,62 @@ TracingManager& TracingManager::getInstance() {
     return instance;
 }
 
+void TracingManager::setSamplingConfig(const SamplingConfig& config) {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    sampling_config_ = config;
+    sampling_config_.head_sample_rate = std::clamp(config.head_sample_rate, 0.0, 1.0);
+}
+
+TracingManager::SamplingConfig TracingManager::getSamplingConfig() const {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    return sampling_config_;
+}
+
+TracingManager::SamplingStats TracingManager::getSamplingStats() const {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    return sampling_stats_;
+}
+
+size_t TracingManager::evictExpiredTraces() {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    return evictExpiredLocked(std::chrono::steady_clock::now());
+}
+
+size_t TracingManager::getTraceCount() const {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    return traces_.size();
+}
+
+void TracingManager::clearTraces() {
+    std::lock_guard<std::mutex> lock(spans_mutex_);
+    traces_.clear();
+    expiry_index_.clear();
+}
+
 std::string TracingManager::startTrace(const std::string& operation_name,
                                       const std::string& parent_trace_id) {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_eviction_ >= std::chrono::seconds(1)) {
+        evictExpiredLocked(now);
+        last_eviction_ = now;
+    }
+    
     std::string trace_id = generateId();
-    traces_[trace_id] = std::vector<Span>();
+    sampling_stats_.started++;
+    
+    bool head_sampled = shouldHeadSample();
+    if (head_sampled) {
+        sampling_stats_.head_sampled++;
+    } else if (!tailSamplingEnabled()) {
+        // Nothing could keep this trace, so don't buffer it
+        sampling_stats_.dropped++;
+        return trace_id;
+    }
+    
+    TraceRecord& record = traces_[trace_id];
+    record.head_sampled = head_sampled;
     
     // Create root span
     Span root_span;
@@ -342,7 +404,8 @@ std::string TracingManager::startTrace(const std::string& operation_name,
     root_span.operation_name = operation_name;
     root_span.start_time = std::chrono::system_clock::now();
     
-    traces_[trace_id].push_back(root_span);
+    record.spans.push_back(root_span);
+    scheduleExpiry(record, trace_id, now);
     
     return trace_id;
 }
@@ -351,9 +414,34 @@ void TracingManager::finishTrace(const std::string& trace_id) {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     
     auto it = traces_.find(trace_id);
-    if (it != traces_.end() && !it->second.empty()) {
-        it->second[0].end_time = std::chrono::system_clock::now();
+    if (it == traces_.end() || it->second.finished) {
+        return;
+    }
+    
+    TraceRecord& record = it->second;
+    record.finished = true;
+    if (!record.spans.empty()) {
+        record.spans[0].end_time = std::chrono::system_clock::now();
+    }
+    
+    if (!record.head_sampled) {
+        bool keep = sampling_config_.keep_error_traces && record.has_error;
+        if (!keep && sampling_config_.latency_threshold.count() > 0 && !record.spans.empty()) {
+            auto latency = record.spans[0].end_time - record.spans[0].start_time;
+            keep = latency >= sampling_config_.latency_threshold;
+        }
+        
+        if (!keep) {
+            expiry_index_.erase(record.expiry);
+            traces_.erase(it);
+            sampling_stats_.dropped++;
+            return;
+        }
+        sampling_stats_.tail_kept++;
     }
+    
+    // Retention counts from completion for kept traces
+    scheduleExpiry(record, trace_id, std::chrono::steady_clock::now());
 }
 
 std::string TracingManager::startSpan(const std::string& trace_id, const std::string& operation_name,
@@ -372,7 +460,7 @@ std::string TracingManager::startSpan(const std::string& trace_id, const std::st
     span.operation_name = operation_name;
     span.start_time = std::chrono::system_clock::now();
     
-    it->second.push_back(span);
+    it->second.spans.push_back(span);
     
     return span.span_id;
 }
@@ -380,14 +468,8 @@ std::string TracingManager::startSpan(const std::string& trace_id, const std::st
 void TracingManager::finishSpan(const std::string& trace_id, const std::string& span_id) {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     
-    auto it = traces_.find(trace_id);
-    if (it != traces_.end()) {
-        for (auto& span : it->second) {
-            if (span.span_id == span_id) {
-                span.end_time = std::chrono::system_clock::now();
-                break;
-            }
-        }
+    if (Span* span = findSpan(trace_id, span_id)) {
+        span->end_time = std::chrono::system_clock::now();
     }
 }
 
@@ -395,13 +477,10 @@ void TracingManager::addTag(const std::string& trace_id, const std::string& span
                            const std::string& key, const std::string& value) {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     
-    auto it = traces_.find(trace_id);
-    if (it != traces_.end()) {
-        for (auto& span : it->second) {
-            if (span.span_id == span_id) {
-                span.tags[key] = value;
-                break;
-            }
+    if (Span* span = findSpan(trace_id, span_id)) {
+        span->tags[key] = value;
+        if (key == "error" && value != "false") {
+            traces_[trace_id].has_error = true;
         }
     }
 }
@@ -410,14 +489,8 @@ void TracingManager::addLog(const std::string& trace_id, const std::string& span
                            const std::string& message) {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     
-    auto it = traces_.find(trace_id);
-    if (it != traces_.end()) {
-        for (auto& span : it->second) {
-            if (span.span_id == span_id) {
-                span.logs.push_back(message);
-                break;
-            }
-        }
+    if (Span* span = findSpan(trace_id, span_id)) {
+        span->logs.push_back(message);
     }
 }
 
@@ -426,7 +499,7 @@ std::vector<TracingManager::Span> TracingManager::getTraceSpans(const std::strin
     
     auto it = traces_.find(trace_id);
     if (it != traces_.end()) {
-        return it->second;
+        return it->second.spans;
     }
     
     return {};
@@ -439,7 +512,7 @@ std::string TracingManager::exportJaeger() const {
     oss << "{\n  \"data\": [\n";
     
     bool first_trace = true;
-    for (const auto& [trace_id, spans] : traces_) {
+    for (const auto& [trace_id, record] : traces_) {
         if (!first_trace) oss << ",\n";
         
         oss << "    {\n";
@@ -447,7 +520,7 @@ std::string TracingManager::exportJaeger() const {
         oss << "      \"spans\": [\n";
         
         bool first_span = true;
-        for (const auto& span : spans) {
+        for (const auto& span : record.spans) {
             if (!first_span) oss << ",\n";
             
             oss << "        {\n";
@@ -489,4 +562,57 @@ std::string TracingManager::generateId() {
     return id;
 }
 
-} // namespace v8_integration
\ No newline at end of file
+bool TracingManager::shouldHeadSample() {
+    if (sampling_config_.head_sample_rate >= 1.0) return true;
+    if (sampling_config_.head_sample_rate <= 0.0) return false;
+    
+    static thread_local std::mt19937 gen(std::random_device{}());
+    static thread_local std::uniform_real_distribution<double> dis(0.0, 1.0);
+    return dis(gen) < sampling_config_.head_sample_rate;
+}
+
+bool TracingManager::tailSamplingEnabled() const {
+    return sampling_config_.keep_error_traces || sampling_config_.latency_threshold.count() > 0;
+}
+
+void TracingManager::scheduleExpiry(TraceRecord& record, const std::string& trace_id,
+                                   std::chrono::steady_clock::time_point now) {
+    if (record.expiry_scheduled) {
+        expiry_index_.erase(record.expiry);
+    }
+    
+    // Unfinished traces also expire so abandoned ones can't pin memory forever
+    auto expires_at = sampling_config_.retention.count() > 0
+        ? now + sampling_config_.retention
+        : std::chrono::steady_clock::time_point::max();
+    record.expiry = expiry_index_.emplace(expires_at, trace_id);
+    record.expiry_scheduled = true;
+}
+
+size_t TracingManager::evictExpiredLocked(std::chrono::steady_clock::time_point now) {
+    size_t evicted = 0;
+    while (!expiry_index_.empty() && expiry_index_.begin()->first <= now) {
+        traces_.erase(expiry_index_.begin()->second);
+        expiry_index_.erase(expiry_index_.begin());
+        evicted++;
+    }
+    
+    sampling_stats_.evicted += evicted;
+    return evicted;
+}
+
+TracingManager::Span* TracingManager::findSpan(const std::string& trace_id, const std::string& span_id) {
+    auto it = traces_.find(trace_id);
+    if (it == traces_.end()) {
+        return nullptr;
+    }
+    
+    for (auto& span : it->second.spans) {
+        if (span.span_id == span_id) {
+            return &span;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace v8_integration
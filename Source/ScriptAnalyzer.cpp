@@ -0,0 +1,338 @@
+#include "V8Integration/ScriptAnalyzer.h"
+#include <algorithm>
+#include <cctype>
+
+namespace v8_integration {
+
+namespace {
+    bool isIdentifierStart(unsigned char c) {
+        return std::isalpha(c) || c == '_' || c == '$' || c == '\\' || c >= 0x80;
+    }
+
+    bool isIdentifierPart(unsigned char c) {
+        return std::isalnum(c) || c == '_' || c == '$' || c == '\\' || c >= 0x80;
+    }
+
+    // Keywords after which a '/' starts a regular expression, not a division
+    bool keywordPrecedesExpression(std::string_view word) {
+        static const std::set<std::string_view> keywords = {
+            "return", "typeof", "instanceof", "in", "of", "new", "delete", "void",
+            "throw", "case", "do", "else", "yield", "await"
+        };
+        return keywords.count(word) > 0;
+    }
+
+    // Receivers through which a property name is still a global reference
+    bool isGlobalObject(std::string_view word) {
+        return word == "globalThis" || word == "window" || word == "self" || word == "global";
+    }
+
+    const char* unmatchedClosing(char c) {
+        switch (c) {
+            case '}': return "Unmatched closing brace";
+            case ')': return "Unmatched closing parenthesis";
+            default: return "Unmatched closing bracket";
+        }
+    }
+
+    const char* unmatchedOpening(char closer) {
+        switch (closer) {
+            case '}': return "Unmatched opening brace";
+            case ')': return "Unmatched opening parenthesis";
+            default: return "Unmatched opening bracket";
+        }
+    }
+}
+
+ScriptMetrics ScriptAnalyzer::analyze(std::string_view code, const IdentifierSet& banned_identifiers) {
+    ScriptMetrics metrics;
+
+    struct Open {
+        char closer;
+        bool do_body;        // '{' directly after `do`
+        bool template_expr;  // '${' inside a template literal
+        int line;
+    };
+
+    // What the previous token was decides whether '/' is a regex or division
+    enum class Previous { Nothing, Value, Punctuator, Keyword };
+
+    std::vector<Open> stack;
+    Previous previous = Previous::Nothing;
+    bool after_dot = false;
+    std::string_view receiver;    // identifier before the last '.' or '?.'
+    std::string_view last_word;   // previous token, if it was an identifier
+    char last_punctuator = 0;     // previous token, if it was a punctuator
+    bool after_do = false;
+    bool do_body_closed = false;
+    int line = 1;
+    size_t i = 0;
+    const size_t n = code.size();
+
+    auto fail = [&](const char* message, int at_line) {
+        metrics.syntax_error = message;
+        metrics.syntax_error_line = at_line;
+    };
+
+    // Scans template literal text from `i` up to the closing '`' or the next
+    // '${'. Returns false if the input ends first.
+    auto scanTemplate = [&]() -> bool {
+        while (i < n) {
+            char c = code[i];
+            if (c == '\\') {
+                i += 2;
+            } else if (c == '`') {
+                ++i;
+                previous = Previous::Value;
+                return true;
+            } else if (c == '$' && i + 1 < n && code[i + 1] == '{') {
+                stack.push_back({'}', false, true, line});
+                metrics.max_nesting_depth = std::max(metrics.max_nesting_depth, stack.size());
+                i += 2;
+                previous = Previous::Punctuator;
+                return true;
+            } else {
+                if (c == '\n') ++line;
+                ++i;
+            }
+        }
+        return false;
+    };
+
+    while (i < n) {
+        char c = code[i];
+        unsigned char uc = static_cast<unsigned char>(c);
+
+        if (c == '\n') {
+            ++line;
+            ++i;
+            continue;
+        }
+        if (std::isspace(uc)) {
+            ++i;
+            continue;
+        }
+
+        // Comments
+        if (c == '/' && i + 1 < n && code[i + 1] == '/') {
+            while (i < n && code[i] != '\n') ++i;
+            continue;
+        }
+        if (c == '/' && i + 1 < n && code[i + 1] == '*') {
+            size_t end = code.find("*/", i + 2);
+            if (end == std::string_view::npos) {
+                fail("Unterminated comment", line);
+                return metrics;
+            }
+            for (size_t k = i; k < end; ++k) {
+                if (code[k] == '\n') ++line;
+            }
+            i = end + 2;
+            continue;
+        }
+
+        ++metrics.token_count;
+        bool was_after_dot = after_dot;
+        std::string_view was_receiver = after_dot ? receiver : std::string_view();
+        std::string_view was_last_word = last_word;
+        char was_last_punctuator = last_punctuator;
+        bool was_after_do = after_do;
+        bool was_do_body_closed = do_body_closed;
+        last_word = {};
+        last_punctuator = 0;
+        after_dot = false;
+        after_do = false;
+        do_body_closed = false;
+
+        // String literals
+        if (c == '"' || c == '\'') {
+            int start_line = line;
+            ++i;
+            while (i < n && code[i] != c) {
+                if (code[i] == '\\') {
+                    if (i + 1 < n && code[i + 1] == '\n') ++line;
+                    ++i;
+                } else if (code[i] == '\n') {
+                    break;
+                }
+                ++i;
+            }
+            if (i >= n || code[i] != c) {
+                fail("Unterminated string literal", start_line);
+                return metrics;
+            }
+            ++i;
+            previous = Previous::Value;
+            continue;
+        }
+
+        // Template literals
+        if (c == '`') {
+            int start_line = line;
+            ++i;
+            if (!scanTemplate()) {
+                fail("Unterminated template literal", start_line);
+                return metrics;
+            }
+            continue;
+        }
+
+        // Regular expression literals
+        if (c == '/' && previous != Previous::Value) {
+            int start_line = line;
+            bool in_class = false;
+            ++i;
+            while (i < n) {
+                char r = code[i];
+                if (r == '\n') break;
+                if (r == '\\') {
+                    i += 2;
+                    continue;
+                }
+                if (r == '[') in_class = true;
+                else if (r == ']') in_class = false;
+                else if (r == '/' && !in_class) break;
+                ++i;
+            }
+            if (i >= n || code[i] != '/') {
+                fail("Unterminated regular expression", start_line);
+                return metrics;
+            }
+            ++i;
+            while (i < n && isIdentifierPart(static_cast<unsigned char>(code[i]))) ++i;
+            previous = Previous::Value;
+            continue;
+        }
+
+        // Identifiers and keywords
+        if (isIdentifierStart(uc)) {
+            size_t start = i;
+            while (i < n && isIdentifierPart(static_cast<unsigned char>(code[i]))) ++i;
+            std::string_view word = code.substr(start, i - start);
+
+            if (banned_identifiers.find(word) != banned_identifiers.end()) {
+                bool reference;
+                if (was_after_dot) {
+                    // job.process() is fine; globalThis.eval and arguments.callee are not
+                    reference = isGlobalObject(was_receiver) || (was_receiver == "arguments" && word == "callee");
+                } else {
+                    // Nor are object literal keys: { exports: 1 }
+                    size_t next = i;
+                    while (next < n && std::isspace(static_cast<unsigned char>(code[next]))) ++next;
+                    bool object_key = (was_last_punctuator == '{' || was_last_punctuator == ',') &&
+                                      !stack.empty() && stack.back().closer == '}' &&
+                                      next < n && code[next] == ':';
+                    reference = !object_key;
+                }
+                if (reference) {
+                    metrics.banned_references.push_back({std::string(word), line});
+                }
+            }
+            last_word = word;
+
+            // Property names (obj.for, obj.function) are not keywords
+            if (!was_after_dot) {
+                if (word == "for" || word == "do") {
+                    ++metrics.loop_count;
+                } else if (word == "while" && !was_do_body_closed) {
+                    ++metrics.loop_count;
+                } else if (word == "function") {
+                    ++metrics.function_count;
+                }
+                after_do = word == "do";
+            }
+
+            previous = !was_after_dot && keywordPrecedesExpression(word) ? Previous::Keyword : Previous::Value;
+            continue;
+        }
+
+        // Numeric literals
+        if (std::isdigit(uc) || (c == '.' && i + 1 < n && std::isdigit(static_cast<unsigned char>(code[i + 1])))) {
+            while (i < n && (std::isalnum(static_cast<unsigned char>(code[i])) || code[i] == '.' || code[i] == '_')) ++i;
+            previous = Previous::Value;
+            continue;
+        }
+
+        // Punctuators
+        last_punctuator = c;
+        switch (c) {
+            case '(':
+            case '[':
+            case '{': {
+                char closer = c == '(' ? ')' : (c == '[' ? ']' : '}');
+                stack.push_back({closer, c == '{' && was_after_do, false, line});
+                metrics.max_nesting_depth = std::max(metrics.max_nesting_depth, stack.size());
+                previous = Previous::Punctuator;
+                ++i;
+                break;
+            }
+            case ')':
+            case ']':
+            case '}': {
+                if (stack.empty() || stack.back().closer != c) {
+                    fail(unmatchedClosing(c), line);
+                    return metrics;
+                }
+                Open open = stack.back();
+                stack.pop_back();
+                ++i;
+                if (open.template_expr) {
+                    int start_line = line;
+                    if (!scanTemplate()) {
+                        fail("Unterminated template literal", start_line);
+                        return metrics;
+                    }
+                    break;
+                }
+                do_body_closed = open.do_body;
+                // A '}' usually ends a block, after which '/' starts a regex
+                previous = c == '}' ? Previous::Punctuator : Previous::Value;
+                break;
+            }
+            case '=':
+                if (i + 1 < n && code[i + 1] == '>') {
+                    ++metrics.function_count;
+                    i += 2;
+                } else {
+                    ++i;
+                }
+                previous = Previous::Punctuator;
+                break;
+            case '.':
+                if (i + 2 < n && code[i + 1] == '.' && code[i + 2] == '.') {
+                    i += 3;
+                } else {
+                    after_dot = true;
+                    receiver = was_last_word;
+                    ++i;
+                }
+                previous = Previous::Punctuator;
+                break;
+            case '?':
+                // Optional chaining `?.` (but not `cond?.5:1`)
+                if (i + 1 < n && code[i + 1] == '.' &&
+                    !(i + 2 < n && std::isdigit(static_cast<unsigned char>(code[i + 2])))) {
+                    after_dot = true;
+                    receiver = was_last_word;
+                    i += 2;
+                } else {
+                    ++i;
+                }
+                previous = Previous::Punctuator;
+                break;
+            default:
+                previous = Previous::Punctuator;
+                ++i;
+                break;
+        }
+    }
+
+    if (!stack.empty()) {
+        const Open& open = stack.back();
+        fail(open.template_expr ? "Unterminated template literal" : unmatchedOpening(open.closer), open.line);
+    }
+
+    return metrics;
+}
+
+} // namespace v8_integration
@@ -1,9 +1,16 @@
 #include "V8Integration/Security.h"
+#include "V8Integration/Monitoring.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <regex>
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <time.h>
+#include <v8-profiler.h>
 // #include <openssl/sha.h>
 // #include <openssl/evp.h>
 // Note: OpenSSL dependency is optional
@@ -18,18 +25,183 @@ SandboxManager& SandboxManager::getInstance() {
 
 bool SandboxManager::createSandbox(v8::Isolate* isolate, const std::string& sandbox_name,
                                   const SandboxConfig& config) {
+    return instantiateSandbox(isolate, sandbox_name, config, templateKey(config));
+}
+
+void SandboxManager::registerTemplate(const std::string& template_name, const SandboxConfig& config) {
+    std::lock_guard<std::mutex> lock(templates_mutex_);
+    named_templates_[template_name] = {config, templateKey(config)};
+}
+
+bool SandboxManager::createSandboxFromTemplate(v8::Isolate* isolate, const std::string& sandbox_name,
+                                               const std::string& template_name) {
+    SandboxTemplate sandbox_template;
+    {
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        auto it = named_templates_.find(template_name);
+        if (it == named_templates_.end()) {
+            return false;
+        }
+        sandbox_template = it->second;
+    }
+    return instantiateSandbox(isolate, sandbox_name, sandbox_template.config, sandbox_template.key);
+}
+
+bool SandboxManager::hasTemplate(const std::string& template_name) const {
+    std::lock_guard<std::mutex> lock(templates_mutex_);
+    return named_templates_.find(template_name) != named_templates_.end();
+}
+
+void SandboxManager::releaseTemplates(v8::Isolate* isolate) {
+    {
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        for (auto it = global_templates_.begin(); it != global_templates_.end();) {
+            if (it->first.first == isolate) {
+                it->second.Reset();
+                it = global_templates_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    evictScripts([isolate](const CachedScript& entry) { return entry.isolate == isolate; });
+}
+
+void SandboxManager::setScriptCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(script_cache_mutex_);
+    script_cache_budget_ = bytes;
+    while (script_cache_bytes_ > script_cache_budget_ && !script_lru_.empty()) {
+        eraseScriptLocked(std::prev(script_lru_.end()));
+        ++script_cache_evictions_;
+    }
+}
+
+SandboxManager::ScriptCacheStats SandboxManager::getScriptCacheStats() const {
+    std::lock_guard<std::mutex> lock(script_cache_mutex_);
+    ScriptCacheStats stats;
+    stats.hits = script_cache_hits_;
+    stats.misses = script_cache_misses_;
+    stats.evictions = script_cache_evictions_;
+    stats.entries = script_lru_.size();
+    stats.bytes = script_cache_bytes_;
+    stats.budget = script_cache_budget_;
+    return stats;
+}
+
+void SandboxManager::clearScriptCache() {
+    evictScripts([](const CachedScript&) { return true; });
+}
+
+std::list<SandboxManager::CachedScript>::iterator SandboxManager::findScriptLocked(v8::Isolate* isolate,
+                                                                                  const std::string& code,
+                                                                                  size_t hash) {
+    auto range = script_index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const CachedScript& entry = *it->second;
+        if (entry.isolate == isolate && entry.source == code) {
+            return it->second;
+        }
+    }
+    return script_lru_.end();
+}
+
+size_t SandboxManager::scriptHash(v8::Isolate* isolate, const std::string& code) {
+    return std::hash<std::string_view>{}(code) ^ (std::hash<v8::Isolate*>{}(isolate) * 0x9e3779b97f4a7c15ULL);
+}
+
+v8::MaybeLocal<v8::Script> SandboxManager::compileCached(v8::Isolate* isolate, const std::string& code) {
+    size_t hash = scriptHash(isolate, code);
+    v8::Local<v8::UnboundScript> unbound;
+    {
+        std::lock_guard<std::mutex> lock(script_cache_mutex_);
+        auto entry = findScriptLocked(isolate, code, hash);
+        if (entry != script_lru_.end()) {
+            script_lru_.splice(script_lru_.begin(), script_lru_, entry);
+            ++script_cache_hits_;
+            unbound = entry->script.Get(isolate);
+        } else {
+            ++script_cache_misses_;
+        }
+    }
+    if (!unbound.IsEmpty()) {
+        return unbound->BindToCurrentContext();
+    }
+    
+    v8::Local<v8::String> source_string;
+    if (!v8::String::NewFromUtf8(isolate, code.data(), v8::NewStringType::kNormal,
+                                 static_cast<int>(code.size())).ToLocal(&source_string)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    v8::ScriptCompiler::Source source(source_string);
+    if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source).ToLocal(&unbound)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    
+    cacheScript(isolate, code, unbound);
+    return unbound->BindToCurrentContext();
+}
+
+void SandboxManager::cacheScript(v8::Isolate* isolate, const std::string& code,
+                                 v8::Local<v8::UnboundScript> script) {
+    size_t hash = scriptHash(isolate, code);
+    size_t bytes = sizeof(CachedScript) + code.size() * kCompiledSizeFactor;
+    std::lock_guard<std::mutex> lock(script_cache_mutex_);
+    if (bytes > script_cache_budget_ || findScriptLocked(isolate, code, hash) != script_lru_.end()) {
+        return;
+    }
+    
+    CachedScript entry;
+    entry.isolate = isolate;
+    entry.source = code;
+    entry.hash = hash;
+    entry.bytes = bytes;
+    entry.script.Reset(isolate, script);
+    script_lru_.push_front(std::move(entry));
+    script_index_.emplace(hash, script_lru_.begin());
+    script_cache_bytes_ += bytes;
+    
+    while (script_cache_bytes_ > script_cache_budget_) {
+        eraseScriptLocked(std::prev(script_lru_.end()));
+        ++script_cache_evictions_;
+    }
+}
+
+void SandboxManager::evictScripts(const std::function<bool(const CachedScript&)>& predicate) {
+    std::lock_guard<std::mutex> lock(script_cache_mutex_);
+    for (auto it = script_lru_.begin(); it != script_lru_.end();) {
+        auto next = std::next(it);
+        if (predicate(*it)) {
+            eraseScriptLocked(it);
+        }
+        it = next;
+    }
+}
+
+void SandboxManager::eraseScriptLocked(std::list<CachedScript>::iterator entry) {
+    auto range = script_index_.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            script_index_.erase(it);
+            break;
+        }
+    }
+    script_cache_bytes_ -= entry->bytes;
+    entry->script.Reset();
+    script_lru_.erase(entry);
+}
+
+bool SandboxManager::instantiateSandbox(v8::Isolate* isolate, const std::string& sandbox_name,
+                                        const SandboxConfig& config, const std::string& template_key) {
     v8::HandleScope HandleScope(isolate);
     
-    // Create isolated context
-    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    // Create isolated context; restrictions come with the global template
+    v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr,
+                                                      getGlobalTemplate(isolate, template_key, config));
     if (context.IsEmpty()) {
         return false;
     }
-    
-    // Apply restrictions
-    {
-        v8::Context::Scope ContextScope(context);
-        applySandboxRestrictions(isolate, context, config);
+    if (config.disable_code_generation) {
+        context->AllowCodeGenerationFromStrings(false);
     }
     
     // Store sandbox
@@ -42,9 +214,34 @@ bool SandboxManager::createSandbox(v8::Isolate* isolate, const std::string& sand
     
     sandboxes_[sandbox_name] = std::move(info);
     
+    SandboxScheduler::TenantConfig tenant;
+    tenant.weight = config.cpu_weight;
+    tenant.quota = config.cpu_quota;
+    tenant.window = config.cpu_window;
+    scheduler_.configure(sandbox_name, tenant);
+    
     return true;
 }
 
+v8::Local<v8::ObjectTemplate> SandboxManager::getGlobalTemplate(v8::Isolate* isolate, const std::string& template_key,
+                                                                const SandboxConfig& config) {
+    std::lock_guard<std::mutex> lock(templates_mutex_);
+    auto& cached = global_templates_[{isolate, template_key}];
+    if (cached.IsEmpty()) {
+        cached.Reset(isolate, buildGlobalTemplate(isolate, config));
+    }
+    return cached.Get(isolate);
+}
+
+std::string SandboxManager::templateKey(const SandboxConfig& config) {
+    // Only what shapes the global object; limits and quotas do not
+    std::string key(1, config.remove_dangerous_globals ? 'R' : '-');
+    for (const auto& [name, value] : config.allowed_globals) {
+        key += '\0' + name + '=' + value;
+    }
+    return key;
+}
+
 v8::Local<v8::Context> SandboxManager::getSandboxContext(v8::Isolate* isolate, const std::string& sandbox_name) {
     std::lock_guard<std::mutex> lock(sandboxes_mutex_);
     
@@ -57,30 +254,115 @@ v8::Local<v8::Context> SandboxManager::getSandboxContext(v8::Isolate* isolate, c
 }
 
 bool SandboxManager::executeSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
-                                     const std::string& code, v8::Local<v8::Value>& result) {
-    v8::Local<v8::Context> context = getSandboxContext(isolate, sandbox_name);
+                                     const std::string& code, v8::Local<v8::Value>& result,
+                                     ErrorInfo* error) {
+    if (scheduler_.throttle(sandbox_name)) {
+        if (error) {
+            *error = ErrorInfo(ErrorCode::CPU_QUOTA_EXCEEDED,
+                               "Sandbox '" + sandbox_name + "' exceeded its CPU quota");
+        }
+        return false;
+    }
+    
+    auto start = SandboxScheduler::threadCpuTime();
+    bool ok = runSandboxed(isolate, sandbox_name, code, result, error);
+    scheduler_.charge(sandbox_name, SandboxScheduler::threadCpuTime() - start);
+    return ok;
+}
+
+bool SandboxManager::enqueueSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
+                                      std::string code, Completion on_complete) {
+    return scheduler_.enqueue(sandbox_name, [this, isolate, sandbox_name, code = std::move(code),
+                                      on_complete = std::move(on_complete)]() {
+        v8::HandleScope HandleScope(isolate);
+        v8::Local<v8::Value> result;
+        ErrorInfo error(ErrorCode::SUCCESS, "");
+        bool ok = runSandboxed(isolate, sandbox_name, code, result, &error);
+        if (on_complete) {
+            on_complete(ok, result, error);
+        }
+    });
+}
+
+size_t SandboxManager::runQueued(size_t max_runs) {
+    size_t ran = scheduler_.runPending(max_runs);
+    if (ran > 0) {
+        scheduler_.publishMetrics();
+    }
+    return ran;
+}
+
+SandboxScheduler::Usage SandboxManager::getCpuUsage(const std::string& sandbox_name) const {
+    return scheduler_.getUsage(sandbox_name);
+}
+
+bool SandboxManager::runSandboxed(v8::Isolate* isolate, const std::string& sandbox_name,
+                                  const std::string& code, v8::Local<v8::Value>& result,
+                                  ErrorInfo* error) {
+    v8::Local<v8::Context> context;
+    std::chrono::milliseconds timeout{0};
+    {
+        std::lock_guard<std::mutex> lock(sandboxes_mutex_);
+        auto it = sandboxes_.find(sandbox_name);
+        if (it != sandboxes_.end()) {
+            context = it->second.context.Get(isolate);
+            timeout = it->second.config.execution_timeout;
+        }
+    }
     if (context.IsEmpty()) {
+        if (error) {
+            *error = ErrorInfo(ErrorCode::EXECUTION_FAILED, "Sandbox not found: " + sandbox_name);
+        }
         return false;
     }
+    if (timeout.count() == 0) {
+        timeout = ResourceLimiter::getInstance().getExecutionTimeout();
+    }
     
     v8::Context::Scope ContextScope(context);
-    v8::HandleScope HandleScope(isolate);
+    v8::EscapableHandleScope HandleScope(isolate);
     
     // Compile and run code
     v8::TryCatch TryCatch(isolate);
-    v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, code.c_str()).ToLocalChecked();
-    v8::Local<v8::Script> script = v8::Script::Compile(context, source).ToLocalChecked();
-    
-    if (script.IsEmpty()) {
+    v8::Local<v8::Script> script;
+    if (!compileCached(isolate, code).ToLocal(&script)) {
+        if (error) {
+            *error = V8ErrorHandler::extractErrorInfo(isolate, TryCatch);
+            error->code = ErrorCode::COMPILATION_FAILED;
+        }
         return false;
     }
     
-    v8::Local<v8::Value> script_result = script->Run(context).ToLocalChecked();
+    v8::MaybeLocal<v8::Value> script_result;
+    bool timed_out = false;
+    if (timeout.count() > 0) {
+        ExecutionWatchdog::Scope watchdog(isolate, timeout);
+        script_result = script->Run(context);
+        timed_out = watchdog.timedOut();
+    } else {
+        script_result = script->Run(context);
+    }
+    
+    bool out_of_memory = ResourceLimiter::getInstance().recoverFromMemoryTermination(isolate);
+    
+    // A deadline that passed just as the script finished still keeps the result
     if (script_result.IsEmpty()) {
+        ErrorInfo info = timed_out
+            ? ErrorInfo(ErrorCode::TIMEOUT_ERROR, "Sandbox '" + sandbox_name + "' exceeded its execution timeout of " +
+                        std::to_string(timeout.count()) + " ms")
+            : out_of_memory
+            ? ErrorInfo(ErrorCode::MEMORY_ERROR, "Sandbox '" + sandbox_name + "' exceeded its isolate memory limit")
+            : V8ErrorHandler::extractErrorInfo(isolate, TryCatch);
+        if (timed_out || out_of_memory) {
+            V8ErrorHandler::logError(info);
+        }
+        if (error) {
+            *error = std::move(info);
+        }
         return false;
     }
     
-    result = script_result;
+    result = HandleScope.Escape(script_result.ToLocalChecked());
     return true;
 }
 
@@ -90,12 +372,18 @@ bool SandboxManager::hasSandbox(const std::string& sandbox_name) const {
 }
 
 void SandboxManager::removeSandbox(const std::string& sandbox_name) {
-    std::lock_guard<std::mutex> lock(sandboxes_mutex_);
-    auto it = sandboxes_.find(sandbox_name);
-    if (it != sandboxes_.end()) {
-        it->second.context.Reset();
-        sandboxes_.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(sandboxes_mutex_);
+        auto it = sandboxes_.find(sandbox_name);
+        if (it != sandboxes_.end()) {
+            it->second.context.Reset();
+            sandboxes_.erase(it);
+        }
     }
+    scheduler_.remove(sandbox_name);
+    
+    // Templates and compiled scripts stay cached for the next sandbox; the
+    // script LRU is bounded by its byte budget and releaseTemplates() drops both
 }
 
 std::vector<std::string> SandboxManager::listSandboxes() const {
@@ -107,33 +395,225 @@ std::vector<std::string> SandboxManager::listSandboxes() const {
     return names;
 }
 
-void SandboxManager::applySandboxRestrictions(v8::Isolate* isolate, v8::Local<v8::Context> context,
-                                             const SandboxConfig& config) {
-    v8::Local<v8::Object> global = context->Global();
+v8::Local<v8::ObjectTemplate> SandboxManager::buildGlobalTemplate(v8::Isolate* isolate, const SandboxConfig& config) {
+    v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
     
-    // Remove dangerous globals
+    // Template properties are installed over the builtins, so dangerous
+    // globals read as undefined without deleting them from every context
     if (config.remove_dangerous_globals) {
-        std::vector<std::string> dangerous = {
+        static const char* const dangerous[] = {
             "eval", "Function", "setTimeout", "setInterval", "require", "process",
             "Buffer", "global", "__dirname", "__filename", "module", "exports"
         };
         
-        for (const auto& name : dangerous) {
-            v8::Local<v8::String> key = v8::String::NewFromUtf8(isolate, name.c_str()).ToLocalChecked();
-            global->Delete(context, key).Check();
+        for (const char* name : dangerous) {
+            v8::Local<v8::String> key = v8::String::NewFromUtf8(isolate, name, v8::NewStringType::kInternalized).ToLocalChecked();
+            global->Set(key, v8::Undefined(isolate));
         }
     }
     
-    // Set up resource limits
-    if (config.memory_limit > 0) {
-        // isolate->SetRAMSizeLimit(config.memory_limit); // Not available in all V8 versions
-    }
-    
     // Add allowed globals
     for (const auto& [key, value] : config.allowed_globals) {
-        v8::Local<v8::String> key_str = v8::String::NewFromUtf8(isolate, key.c_str()).ToLocalChecked();
+        v8::Local<v8::String> key_str = v8::String::NewFromUtf8(isolate, key.c_str(), v8::NewStringType::kInternalized).ToLocalChecked();
         v8::Local<v8::String> value_str = v8::String::NewFromUtf8(isolate, value.c_str()).ToLocalChecked();
-        global->Set(context, key_str, value_str).Check();
+        global->Set(key_str, value_str);
+    }
+    
+    return global;
+}
+
+// SandboxScheduler Implementation
+std::chrono::nanoseconds SandboxScheduler::threadCpuTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+void SandboxScheduler::configure(const std::string& tenant, const TenantConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Tenant& state = tenants_[tenant];
+    state.config = config;
+    if (state.config.weight <= 0.0) {
+        state.config.weight = 1.0;
+    }
+    if (state.config.window.count() <= 0) {
+        state.config.window = std::chrono::milliseconds(1000);
+    }
+}
+
+void SandboxScheduler::remove(const std::string& tenant) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenant);
+    if (it != tenants_.end()) {
+        pending_ -= it->second.queue.size();
+        tenants_.erase(it);
+    }
+}
+
+int64_t SandboxScheduler::bucketWidthNs(const Tenant& tenant) {
+    auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(tenant.config.window).count();
+    return std::max<int64_t>(1, window / static_cast<int64_t>(kWindowBuckets));
+}
+
+int64_t SandboxScheduler::windowUsageNs(const Tenant& tenant, Clock::time_point now) {
+    int64_t id = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() /
+                 bucketWidthNs(tenant);
+    int64_t used = 0;
+    for (size_t i = 0; i < kWindowBuckets; ++i) {
+        if (tenant.bucket_ids[i] > id - static_cast<int64_t>(kWindowBuckets)) {
+            used += tenant.bucket_ns[i];
+        }
+    }
+    return used;
+}
+
+void SandboxScheduler::chargeLocked(Tenant& tenant, int64_t cpu_ns, Clock::time_point now) {
+    int64_t id = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() /
+                 bucketWidthNs(tenant);
+    size_t index = static_cast<size_t>(id % static_cast<int64_t>(kWindowBuckets));
+    if (tenant.bucket_ids[index] != id) {
+        tenant.bucket_ids[index] = id;
+        tenant.bucket_ns[index] = 0;
+    }
+    tenant.bucket_ns[index] += cpu_ns;
+    tenant.total_ns += cpu_ns;
+    ++tenant.executions;
+    tenant.virtual_time += static_cast<double>(cpu_ns) / tenant.config.weight;
+}
+
+void SandboxScheduler::charge(const std::string& tenant, std::chrono::nanoseconds cpu_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenant);
+    if (it != tenants_.end()) {
+        chargeLocked(it->second, cpu_time.count(), Clock::now());
+    }
+}
+
+bool SandboxScheduler::throttle(const std::string& tenant) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenant);
+    if (it == tenants_.end() || it->second.config.quota.count() == 0) {
+        return false;
+    }
+    if (windowUsageNs(it->second, Clock::now()) < it->second.config.quota.count()) {
+        return false;
+    }
+    ++it->second.throttled;
+    return true;
+}
+
+bool SandboxScheduler::enqueue(const std::string& tenant, Task task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenant);
+    if (it == tenants_.end()) {
+        return false;
+    }
+    Tenant& state = it->second;
+    if (state.queue.empty()) {
+        // A tenant that was idle does not get to bank the CPU it did not use
+        state.virtual_time = std::max(state.virtual_time, virtual_clock_);
+    }
+    state.queue.push_back(std::move(task));
+    ++pending_;
+    return true;
+}
+
+size_t SandboxScheduler::runPending(size_t max_tasks) {
+    std::set<std::string> throttled;
+    size_t ran = 0;
+    
+    while (ran < max_tasks) {
+        Task task;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            Tenant* best = nullptr;
+            for (auto& [tenant_name, tenant] : tenants_) {
+                if (tenant.queue.empty()) continue;
+                if (tenant.config.quota.count() > 0 &&
+                    windowUsageNs(tenant, now) >= tenant.config.quota.count()) {
+                    throttled.insert(tenant_name);
+                    continue;
+                }
+                if (!best || tenant.virtual_time < best->virtual_time) {
+                    best = &tenant;
+                    name = tenant_name;
+                }
+            }
+            if (!best) break;
+            
+            task = std::move(best->queue.front());
+            best->queue.pop_front();
+            --pending_;
+            virtual_clock_ = best->virtual_time;
+        }
+        
+        auto start = threadCpuTime();
+        task();
+        auto cpu_time = threadCpuTime() - start;
+        ++ran;
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tenants_.find(name);
+        if (it != tenants_.end()) {
+            chargeLocked(it->second, cpu_time.count(), Clock::now());
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& name : throttled) {
+        auto it = tenants_.find(name);
+        if (it != tenants_.end()) {
+            ++it->second.throttled;
+        }
+    }
+    return ran;
+}
+
+size_t SandboxScheduler::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+SandboxScheduler::Usage SandboxScheduler::getUsage(const std::string& tenant) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Usage usage;
+    auto it = tenants_.find(tenant);
+    if (it != tenants_.end()) {
+        usage.total = std::chrono::nanoseconds(it->second.total_ns);
+        usage.window = std::chrono::nanoseconds(windowUsageNs(it->second, Clock::now()));
+        usage.executions = it->second.executions;
+        usage.throttled = it->second.throttled;
+        usage.queued = it->second.queue.size();
+    }
+    return usage;
+}
+
+std::map<std::string, SandboxScheduler::Usage> SandboxScheduler::getAllUsage() const {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, tenant] : tenants_) {
+            names.push_back(name);
+        }
+    }
+    std::map<std::string, Usage> usage;
+    for (const auto& name : names) {
+        usage[name] = getUsage(name);
+    }
+    return usage;
+}
+
+void SandboxScheduler::publishMetrics() const {
+    auto& metrics = MetricsCollector::getInstance();
+    for (const auto& [name, usage] : getAllUsage()) {
+        std::map<std::string, std::string> labels = {{"sandbox", name}};
+        metrics.setGauge("sandbox_cpu_seconds", std::chrono::duration<double>(usage.total).count(), labels);
+        metrics.setGauge("sandbox_cpu_window_seconds", std::chrono::duration<double>(usage.window).count(), labels);
+        metrics.setGauge("sandbox_executions", static_cast<double>(usage.executions), labels);
+        metrics.setGauge("sandbox_throttled", static_cast<double>(usage.throttled), labels);
+        metrics.setGauge("sandbox_queued", static_cast<double>(usage.queued), labels);
     }
 }
 
@@ -159,6 +639,11 @@ void ResourceLimiter::setCallStackLimit(size_t limit) {
     call_stack_limit_ = limit;
 }
 
+std::chrono::milliseconds ResourceLimiter::getExecutionTimeout() const {
+    std::lock_guard<std::mutex> lock(limits_mutex_);
+    return execution_timeout_;
+}
+
 bool ResourceLimiter::checkMemoryUsage(v8::Isolate* isolate) {
     if (memory_limit_ == 0) return true;
     
@@ -193,203 +678,1209 @@ ResourceLimiter::ResourceUsage ResourceLimiter::getCurrentUsage(v8::Isolate* iso
     usage.memory_total = heap_stats.total_heap_size();
     usage.memory_limit = memory_limit_;
     usage.heap_size_limit = heap_stats.heap_size_limit();
+    if (auto* allocator = dynamic_cast<AccountingArrayBufferAllocator*>(isolate->GetArrayBufferAllocator())) {
+        usage.array_buffer_used = allocator->getAllocated();
+    }
     
     return usage;
 }
 
 void ResourceLimiter::enableResourceMonitoring(v8::Isolate* isolate, bool enable) {
+    if (enable) {
+        installMemoryPolicy(isolate, MemoryPolicy{});
+    } else {
+        removeMemoryPolicy(isolate);
+    }
+}
+
+void ResourceLimiter::configureCreateParams(v8::Isolate::CreateParams& params, const MemoryPolicy& policy) {
+    if (policy.heap_limit > 0) {
+        params.constraints.ConfigureDefaultsFromHeapSize(0, policy.heap_limit);
+    }
+    params.array_buffer_allocator = nullptr;
+    params.array_buffer_allocator_shared =
+        std::make_shared<AccountingArrayBufferAllocator>(policy.array_buffer_limit);
+}
+
+v8::Isolate* ResourceLimiter::createIsolate(const MemoryPolicy& policy) {
+    v8::Isolate::CreateParams params;
+    configureCreateParams(params, policy);
+    v8::Isolate* isolate = v8::Isolate::New(params);
+    if (isolate) {
+        installMemoryPolicy(isolate, policy);
+    }
+    return isolate;
+}
+
+void ResourceLimiter::installMemoryPolicy(v8::Isolate* isolate, const MemoryPolicy& policy) {
+    removeMemoryPolicy(isolate);
+    
+    auto state = std::make_unique<IsolateMemoryState>();
+    state->isolate = isolate;
+    state->policy = policy;
+    
+    // Allocators set up by configureCreateParams take the policy's limit
+    if (auto* allocator = dynamic_cast<AccountingArrayBufferAllocator*>(isolate->GetArrayBufferAllocator())) {
+        allocator->setLimit(policy.array_buffer_limit);
+    }
+    
+    isolate->AddNearHeapLimitCallback(&ResourceLimiter::nearHeapLimit, state.get());
+    // Limits raised by the callback drop back once the heap shrinks again
+    isolate->AutomaticallyRestoreInitialHeapLimit();
+    
     std::lock_guard<std::mutex> lock(limits_mutex_);
-    monitoring_enabled_ = enable;
+    memory_states_[isolate] = std::move(state);
+}
+
+void ResourceLimiter::removeMemoryPolicy(v8::Isolate* isolate) {
+    std::lock_guard<std::mutex> lock(limits_mutex_);
+    auto it = memory_states_.find(isolate);
+    if (it != memory_states_.end()) {
+        isolate->RemoveNearHeapLimitCallback(&ResourceLimiter::nearHeapLimit, 0);
+        memory_states_.erase(it);
+    }
+}
+
+ResourceLimiter::MemoryStats ResourceLimiter::getMemoryStats(v8::Isolate* isolate) const {
+    MemoryStats stats;
+    if (auto* allocator = dynamic_cast<AccountingArrayBufferAllocator*>(isolate->GetArrayBufferAllocator())) {
+        stats.array_buffer_used = allocator->getAllocated();
+        stats.array_buffer_rejected = allocator->getRejected();
+    }
     
-    if (enable && !monitoring_thread_) {
-        monitoring_thread_ = std::make_unique<std::thread>([this, isolate]() {
-            monitorResources(isolate);
-        });
-    } else if (!enable && monitoring_thread_) {
-        monitoring_thread_->join();
-        monitoring_thread_.reset();
+    std::lock_guard<std::mutex> lock(limits_mutex_);
+    auto it = memory_states_.find(isolate);
+    if (it != memory_states_.end()) {
+        stats.near_limit_events = it->second->near_limit_events.load();
+        stats.terminations = it->second->terminations.load();
     }
+    return stats;
 }
 
-void ResourceLimiter::monitorResources(v8::Isolate* isolate) {
-    while (monitoring_enabled_) {
-        if (!checkMemoryUsage(isolate)) {
-            // Memory limit exceeded
-            isolate->TerminateExecution();
+bool ResourceLimiter::recoverFromMemoryTermination(v8::Isolate* isolate) {
+    IsolateMemoryState* state = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(limits_mutex_);
+        auto it = memory_states_.find(isolate);
+        if (it != memory_states_.end()) {
+            state = it->second.get();
+        }
+    }
+    if (!state || !state->terminated.exchange(false)) {
+        return false;
+    }
+    
+    // The next tenant script gets its one grace period again
+    state->grown = false;
+    isolate->CancelTerminateExecution();
+    return true;
+}
+
+size_t ResourceLimiter::nearHeapLimit(void* data, size_t current_heap_limit, size_t initial_heap_limit) {
+    // Called synchronously by the GC on the isolate's own thread
+    auto* state = static_cast<IsolateMemoryState*>(data);
+    const MemoryPolicy& policy = state->policy;
+    ++state->near_limit_events;
+    
+    size_t headroom = policy.grow_bytes > 0 ? policy.grow_bytes : initial_heap_limit / 2;
+    
+    MemoryEvent event;
+    event.current_heap_limit = current_heap_limit;
+    event.initial_heap_limit = initial_heap_limit;
+    event.action_taken = policy.action;
+    
+    if (policy.action == MemoryLimitAction::GROW_ONCE && !state->grown) {
+        state->grown = true;
+        Logger::getInstance().warn("Isolate reached its heap limit of " + std::to_string(current_heap_limit) +
+                                   " bytes; growing by " + std::to_string(headroom) + " bytes once");
+        if (policy.on_limit) {
+            policy.on_limit(state->isolate, event);
+        }
+        return current_heap_limit + headroom;
+    }
+    
+    if (policy.action == MemoryLimitAction::SNAPSHOT_AND_TERMINATE) {
+        event.snapshot_path = writeHeapSnapshot(state->isolate, policy.snapshot_directory);
+    } else {
+        event.action_taken = MemoryLimitAction::TERMINATE;
+    }
+    
+    if (!state->terminated.exchange(true)) {
+        ++state->terminations;
+        state->isolate->TerminateExecution();
+        Logger::getInstance().error("Isolate terminated at its heap limit of " +
+                                    std::to_string(current_heap_limit) + " bytes" +
+                                    (event.snapshot_path.empty() ? "" : "; heap snapshot: " + event.snapshot_path));
+        if (policy.on_limit) {
+            policy.on_limit(state->isolate, event);
+        }
+    }
+    
+    // Termination is only noticed once JS unwinds, which still allocates
+    return current_heap_limit + headroom;
+}
+
+namespace {
+    class FileOutputStream : public v8::OutputStream {
+    public:
+        explicit FileOutputStream(std::ofstream& file) : file_(file) {}
+        void EndOfStream() override {}
+        WriteResult WriteAsciiChunk(char* data, int size) override {
+            file_.write(data, size);
+            return file_ ? kContinue : kAbort;
+        }
+        
+    private:
+        std::ofstream& file_;
+    };
+}
+
+std::string ResourceLimiter::writeHeapSnapshot(v8::Isolate* isolate, const std::string& directory) {
+    static std::atomic<int> sequence{0};
+    std::string path = directory + "/heap-" + std::to_string(::getpid()) + "-" +
+                       std::to_string(++sequence) + ".heapsnapshot";
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return "";
+    }
+    
+    const v8::HeapSnapshot* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+    if (!snapshot) {
+        return "";
+    }
+    FileOutputStream stream(file);
+    snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+    return file ? path : "";
+}
+
+// AccountingArrayBufferAllocator Implementation
+AccountingArrayBufferAllocator::AccountingArrayBufferAllocator(size_t limit_bytes) : limit_(limit_bytes) {
+}
+
+bool AccountingArrayBufferAllocator::reserve(size_t length) {
+    size_t current = allocated_.load(std::memory_order_relaxed);
+    do {
+        size_t limit = limit_.load(std::memory_order_relaxed);
+        if (limit > 0 && current + length > limit) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!allocated_.compare_exchange_weak(current, current + length, std::memory_order_relaxed));
+    return true;
+}
+
+void* AccountingArrayBufferAllocator::Allocate(size_t length) {
+    if (!reserve(length)) {
+        return nullptr;
+    }
+    void* data = std::calloc(length ? length : 1, 1);
+    if (!data) {
+        allocated_.fetch_sub(length, std::memory_order_relaxed);
+    }
+    return data;
+}
+
+void* AccountingArrayBufferAllocator::AllocateUninitialized(size_t length) {
+    if (!reserve(length)) {
+        return nullptr;
+    }
+    void* data = std::malloc(length ? length : 1);
+    if (!data) {
+        allocated_.fetch_sub(length, std::memory_order_relaxed);
+    }
+    return data;
+}
+
+void AccountingArrayBufferAllocator::Free(void* data, size_t length) {
+    std::free(data);
+    allocated_.fetch_sub(length, std::memory_order_relaxed);
+}
+
+// TenantIsolatePool Implementation
+TenantIsolatePool& TenantIsolatePool::getInstance() {
+    static TenantIsolatePool instance;
+    return instance;
+}
+
+TenantIsolatePool::~TenantIsolatePool() {
+    shutdown();
+}
+
+void TenantIsolatePool::configure(const Config& config) {
+    std::vector<std::shared_ptr<Worker>> reclaimed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        for (const auto& [tenant, worker] : workers_) {
+            {
+                std::lock_guard<std::mutex> worker_lock(worker->mutex);
+                worker->idle_timeout = config.idle_timeout;
+            }
+            // Wakes an idle worker so it waits on the new deadline
+            worker->wake.notify_one();
+        }
+        reclaimed = takeIdleWorkersLocked("");
+    }
+    for (const auto& worker : reclaimed) {
+        stopWorker(worker);
+    }
+}
+
+void TenantIsolatePool::registerTenant(const std::string& tenant, const TenantConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tenants_[tenant] = config;
+}
+
+void TenantIsolatePool::removeTenant(const std::string& tenant) {
+    std::shared_ptr<Worker> worker;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tenants_.erase(tenant);
+        auto it = workers_.find(tenant);
+        if (it != workers_.end()) {
+            worker = it->second;
+            workers_.erase(it);
+        }
+    }
+    if (worker) {
+        stopWorker(worker);
+    }
+}
+
+bool TenantIsolatePool::hasTenant(const std::string& tenant) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tenants_.find(tenant) != tenants_.end();
+}
+
+void TenantIsolatePool::execute(const std::string& tenant, std::string code, Completion on_complete) {
+    std::vector<std::shared_ptr<Worker>> reclaimed;
+    bool known = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto config = tenants_.find(tenant);
+        if (config != tenants_.end()) {
+            known = true;
+            std::shared_ptr<Worker>& worker = workers_[tenant];
+            bool start = !worker;
+            if (worker) {
+                std::lock_guard<std::mutex> worker_lock(worker->mutex);
+                start = worker->failed;
+            }
+            if (worker && start) {
+                // Its isolate could not be created; try again with a new one
+                reclaimed.push_back(worker);
+            }
+            if (start) {
+                worker = std::make_shared<Worker>();
+                worker->tenant = tenant;
+                worker->config = config->second;
+                worker->idle_timeout = config_.idle_timeout;
+                worker->last_used = std::chrono::steady_clock::now();
+                Worker* raw = worker.get();
+                worker->thread = std::thread([this, raw] { runWorker(*raw); });
+                ++created_;
+                auto idle = takeIdleWorkersLocked(tenant);
+                reclaimed.insert(reclaimed.end(), idle.begin(), idle.end());
+            }
+            
+            // Queued under the pool lock, so a worker picked for reclaim never gets new work
+            {
+                std::lock_guard<std::mutex> worker_lock(worker->mutex);
+                worker->queue.push_back({std::move(code), std::move(on_complete)});
+                worker->last_used = std::chrono::steady_clock::now();
+            }
+            worker->wake.notify_one();
+        }
+    }
+    
+    if (!known) {
+        ExecutionResult result;
+        result.error = ErrorInfo(ErrorCode::EXECUTION_FAILED, "Unknown tenant: " + tenant);
+        if (on_complete) {
+            on_complete(result);
+        }
+    }
+    for (const auto& worker : reclaimed) {
+        stopWorker(worker);
+    }
+}
+
+std::future<TenantIsolatePool::ExecutionResult> TenantIsolatePool::execute(const std::string& tenant, std::string code) {
+    auto promise = std::make_shared<std::promise<ExecutionResult>>();
+    std::future<ExecutionResult> future = promise->get_future();
+    execute(tenant, std::move(code), [promise](const ExecutionResult& result) {
+        promise->set_value(result);
+    });
+    return future;
+}
+
+TenantIsolatePool::Stats TenantIsolatePool::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.live = workers_.size();
+    for (const auto& [tenant, worker] : workers_) {
+        std::lock_guard<std::mutex> worker_lock(worker->mutex);
+        if (worker->parked) {
+            ++stats.parked;
+        }
+    }
+    stats.created = created_;
+    stats.reclaimed = reclaimed_;
+    stats.executions = executions_.load();
+    return stats;
+}
+
+void TenantIsolatePool::shutdown() {
+    std::map<std::string, std::shared_ptr<Worker>> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers.swap(workers_);
+    }
+    for (const auto& [tenant, worker] : workers) {
+        stopWorker(worker);
+    }
+}
+
+std::vector<std::shared_ptr<TenantIsolatePool::Worker>> TenantIsolatePool::takeIdleWorkersLocked(const std::string& keep) {
+    std::vector<std::shared_ptr<Worker>> reclaimed;
+    while (workers_.size() > config_.max_isolates) {
+        // Least recently used tenant with nothing queued or running
+        auto victim = workers_.end();
+        for (auto it = workers_.begin(); it != workers_.end(); ++it) {
+            if (it->first == keep) continue;
+            std::lock_guard<std::mutex> worker_lock(it->second->mutex);
+            if (it->second->busy || !it->second->queue.empty()) continue;
+            if (victim == workers_.end() || it->second->last_used < victim->second->last_used) {
+                victim = it;
+            }
+        }
+        if (victim == workers_.end()) {
+            break;  // everyone is busy; retried when the next isolate is started
+        }
+        reclaimed.push_back(victim->second);
+        workers_.erase(victim);
+        ++reclaimed_;
+    }
+    return reclaimed;
+}
+
+void TenantIsolatePool::stopWorker(const std::shared_ptr<Worker>& worker) {
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->stopping = true;
+    }
+    worker->wake.notify_one();
+    if (worker->thread.joinable()) {
+        worker->thread.join();
+    }
+}
+
+void TenantIsolatePool::failJobs(Worker& worker) {
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.failed = true;
+    for (;;) {
+        worker.wake.wait(lock, [&worker] { return worker.stopping || !worker.queue.empty(); });
+        if (worker.queue.empty()) {
             break;
         }
+        Job job = std::move(worker.queue.front());
+        worker.queue.pop_front();
+        lock.unlock();
+        
+        ExecutionResult result;
+        result.error = ErrorInfo(ErrorCode::INITIALIZATION_FAILED,
+                                 "Could not create an isolate for tenant: " + worker.tenant);
+        if (job.on_complete) {
+            job.on_complete(result);
+        }
+        lock.lock();
+    }
+}
+
+void TenantIsolatePool::runWorker(Worker& worker) {
+    v8::Isolate* isolate = ResourceLimiter::getInstance().createIsolate(worker.config.memory);
+    if (!isolate) {
+        failJobs(worker);
+        return;
+    }
+    const std::string sandbox_name = "tenant:" + worker.tenant;
+    
+    {
+        v8::Isolate::Scope IsolateScope(isolate);
+        SandboxManager& sandboxes = SandboxManager::getInstance();
+        sandboxes.createSandbox(isolate, sandbox_name, worker.config.sandbox);
+        
+        auto has_work = [&worker] { return worker.stopping || !worker.queue.empty(); };
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        for (;;) {
+            if (!has_work()) {
+                if (worker.parked) {
+                    worker.wake.wait(lock, has_work);
+                } else if (std::chrono::steady_clock::now() < worker.last_used + worker.idle_timeout) {
+                    // Re-evaluated after every wake-up, so configure() can change the timeout
+                    worker.wake.wait_until(lock, worker.last_used + worker.idle_timeout);
+                    continue;
+                } else {
+                    // Idle: trim the heap but keep the isolate and its compiled scripts
+                    worker.parked = true;
+                    lock.unlock();
+                    isolate->IsolateInBackgroundNotification();
+                    isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+                    lock.lock();
+                    continue;
+                }
+            }
+            if (worker.queue.empty()) {
+                break;  // stopping with nothing left to run
+            }
+            
+            Job job = std::move(worker.queue.front());
+            worker.queue.pop_front();
+            worker.busy = true;
+            bool was_parked = worker.parked;
+            worker.parked = false;
+            lock.unlock();
+            
+            if (was_parked) {
+                isolate->IsolateInForegroundNotification();
+            }
+            
+            ExecutionResult result;
+            {
+                v8::HandleScope HandleScope(isolate);
+                v8::Local<v8::Value> value;
+                result.ok = sandboxes.executeSandboxed(isolate, sandbox_name, job.code, value, &result.error);
+                if (result.ok) {
+                    v8::Local<v8::Context> context = sandboxes.getSandboxContext(isolate, sandbox_name);
+                    v8::Context::Scope ContextScope(context);
+                    v8::TryCatch TryCatch(isolate);
+                    v8::Local<v8::String> text;
+                    bool as_json = value->IsObject() && !value->IsFunction();
+                    if ((as_json ? v8::JSON::Stringify(context, value) : value->ToString(context)).ToLocal(&text)) {
+                        v8::String::Utf8Value utf8(isolate, text);
+                        result.value.assign(*utf8 ? *utf8 : "", utf8.length());
+                    }
+                }
+            }
+            ++executions_;
+            if (job.on_complete) {
+                job.on_complete(result);
+            }
+            
+            lock.lock();
+            worker.busy = false;
+            worker.last_used = std::chrono::steady_clock::now();
+        }
+        lock.unlock();
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        sandboxes.removeSandbox(sandbox_name);
+        sandboxes.releaseTemplates(isolate);
     }
+    
+    ResourceLimiter::getInstance().removeMemoryPolicy(isolate);
+    isolate->Dispose();
+}
+
+// ExecutionWatchdog Implementation
+ExecutionWatchdog& ExecutionWatchdog::getInstance() {
+    static ExecutionWatchdog instance;
+    return instance;
+}
+
+ExecutionWatchdog::ExecutionWatchdog()
+    : wheel_(kWheelSlots), epoch_(std::chrono::steady_clock::now()) {
+    thread_ = std::thread(&ExecutionWatchdog::run, this);
+}
+
+ExecutionWatchdog::~ExecutionWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+ExecutionWatchdog::Handle ExecutionWatchdog::arm(v8::Isolate* isolate, std::chrono::milliseconds timeout) {
+    Entry entry;
+    entry.isolate = isolate;
+    return insert(std::move(entry), timeout);
+}
+
+ExecutionWatchdog::Handle ExecutionWatchdog::arm(std::chrono::milliseconds timeout, std::function<void()> on_expire) {
+    Entry entry;
+    entry.on_expire = std::move(on_expire);
+    return insert(std::move(entry), timeout);
+}
+
+ExecutionWatchdog::Handle ExecutionWatchdog::insert(Entry entry, std::chrono::milliseconds timeout) {
+    bool was_idle;
+    Handle handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t now = currentTick();
+        was_idle = armed_count_ == 0;
+        if (was_idle) {
+            // Nothing is armed, so the ticks since the last run can be skipped
+            processed_tick_ = std::max(processed_tick_, now);
+        }
+        
+        uint64_t ticks = static_cast<uint64_t>((timeout + kTickResolution - std::chrono::milliseconds(1)) / kTickResolution);
+        // +1 because `now` is rounded down; an entry never fires early
+        entry.deadline_tick = std::max(now + ticks + 1, processed_tick_ + 1);
+        
+        handle = next_handle_++;
+        wheel_[entry.deadline_tick % kWheelSlots].push_back(handle);
+        entries_.emplace(handle, std::move(entry));
+        ++armed_count_;
+    }
+    if (was_idle) {
+        wake_.notify_one();
+    }
+    return handle;
+}
+
+bool ExecutionWatchdog::disarm(Handle handle) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = entries_.find(handle);
+    if (it == entries_.end()) {
+        return false;
+    }
+    
+    // The wheel slot still lists the handle; it is dropped when the slot is next visited
+    bool expired = it->second.expired;
+    if (!expired) {
+        --armed_count_;
+    } else if (running_callbacks_ && std::this_thread::get_id() != thread_.get_id()) {
+        // Its callback may be running; don't let the caller free what it uses
+        callbacks_done_.wait(lock, [this] { return !running_callbacks_; });
+    }
+    entries_.erase(handle);
+    return expired;
+}
+
+ExecutionWatchdog::Stats ExecutionWatchdog::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.armed = armed_count_;
+    stats.expired = expired_count_;
+    return stats;
+}
+
+uint64_t ExecutionWatchdog::currentTick() const {
+    return static_cast<uint64_t>((std::chrono::steady_clock::now() - epoch_) / kTickResolution);
+}
+
+void ExecutionWatchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (armed_count_ == 0) {
+            wake_.wait(lock, [this] { return stopping_ || armed_count_ > 0; });
+            continue;
+        }
+        
+        uint64_t now = currentTick();
+        if (now > processed_tick_) {
+            auto callbacks = advanceTo(now);
+            if (!callbacks.empty()) {
+                running_callbacks_ = true;
+                lock.unlock();
+                for (auto& callback : callbacks) {
+                    callback();
+                }
+                lock.lock();
+                running_callbacks_ = false;
+                callbacks_done_.notify_all();
+                continue;
+            }
+        }
+        wake_.wait_until(lock, epoch_ + (processed_tick_ + 1) * kTickResolution);
+    }
+}
+
+std::vector<std::function<void()>> ExecutionWatchdog::advanceTo(uint64_t tick) {
+    std::vector<std::function<void()>> callbacks;
+    // After a long stall every slot is visited once rather than once per tick
+    uint64_t first = tick - processed_tick_ > kWheelSlots ? tick - kWheelSlots + 1 : processed_tick_ + 1;
+    
+    for (uint64_t t = first; t <= tick; ++t) {
+        auto& slot = wheel_[t % kWheelSlots];
+        size_t kept = 0;
+        for (Handle handle : slot) {
+            auto it = entries_.find(handle);
+            if (it == entries_.end() || it->second.expired) {
+                continue;
+            }
+            Entry& entry = it->second;
+            if (entry.deadline_tick > tick) {
+                slot[kept++] = handle;  // due on a later turn of the wheel
+                continue;
+            }
+            
+            entry.expired = true;
+            --armed_count_;
+            ++expired_count_;
+            if (entry.on_expire) {
+                callbacks.push_back(std::move(entry.on_expire));
+            } else if (entry.isolate) {
+                // Under the lock, so a disarmed isolate is never terminated after disposal
+                entry.isolate->TerminateExecution();
+            }
+        }
+        slot.resize(kept);
+    }
+    processed_tick_ = tick;
+    return callbacks;
+}
+
+ExecutionWatchdog::Scope::Scope(v8::Isolate* isolate, std::chrono::milliseconds timeout)
+    : isolate_(isolate), handle_(ExecutionWatchdog::getInstance().arm(isolate, timeout)) {
+}
+
+ExecutionWatchdog::Scope::~Scope() {
+    timedOut();
+}
+
+bool ExecutionWatchdog::Scope::timedOut() {
+    if (!finished_) {
+        finished_ = true;
+        timed_out_ = ExecutionWatchdog::getInstance().disarm(handle_);
+        if (timed_out_) {
+            isolate_->CancelTerminateExecution();
+        }
+    }
+    return timed_out_;
+}
+
+// PatternScanner Implementation
+PatternScanner::PatternScanner(const std::vector<std::string>& patterns) {
+    patterns_.resize(patterns.size());
+    
+    std::vector<std::array<int32_t, 256>> go(1);
+    go[0].fill(-1);
+    outputs_.emplace_back();
+    
+    for (size_t index = 0; index < patterns.size(); ++index) {
+        Pattern& pattern = patterns_[index];
+        pattern.source = patterns[index];
+        
+        if (!compile(pattern.source, pattern)) {
+            // Throws std::regex_error for invalid patterns, as before
+            pattern.fallback = std::make_unique<std::regex>(pattern.source);
+            continue;
+        }
+        
+        int32_t node = 0;
+        for (char c : pattern.prefix) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            if (go[node][byte] == -1) {
+                go[node][byte] = static_cast<int32_t>(go.size());
+                go.emplace_back();
+                go.back().fill(-1);
+                outputs_.emplace_back();
+            }
+            node = go[node][byte];
+        }
+        outputs_[node].push_back(static_cast<uint32_t>(index));
+        ++automaton_patterns_;
+    }
+    
+    // Breadth-first failure links, folded into a dense DFA so scanning is
+    // one table lookup per byte
+    std::vector<int32_t> fail(go.size(), 0);
+    std::vector<int32_t> queue;
+    queue.reserve(go.size());
+    for (int c = 0; c < 256; ++c) {
+        if (go[0][c] == -1) {
+            go[0][c] = 0;
+        } else {
+            fail[go[0][c]] = 0;
+            queue.push_back(go[0][c]);
+        }
+    }
+    
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t node = queue[head];
+        for (int c = 0; c < 256; ++c) {
+            int32_t child = go[node][c];
+            if (child == -1) {
+                go[node][c] = go[fail[node]][c];
+            } else {
+                fail[child] = go[fail[node]][c];
+                const auto& inherited = outputs_[fail[child]];
+                outputs_[child].insert(outputs_[child].end(), inherited.begin(), inherited.end());
+                queue.push_back(child);
+            }
+        }
+    }
+    
+    transitions_.resize(go.size() * 256);
+    for (size_t state = 0; state < go.size(); ++state) {
+        std::copy(go[state].begin(), go[state].end(), transitions_.begin() + state * 256);
+    }
+}
+
+bool PatternScanner::compile(const std::string& source, Pattern& pattern) {
+    std::vector<Step> steps;
+    
+    for (size_t i = 0; i < source.size(); ++i) {
+        char c = source[i];
+        if (c == '\\') {
+            if (i + 1 >= source.size()) return false;
+            char escaped = source[++i];
+            if (escaped == 's') {
+                StepType type = StepType::Space;
+                if (i + 1 < source.size() && source[i + 1] == '*') {
+                    type = StepType::SpaceStar;
+                    ++i;
+                } else if (i + 1 < source.size() && source[i + 1] == '+') {
+                    type = StepType::SpacePlus;
+                    ++i;
+                }
+                steps.push_back({type, 0});
+            } else if (std::isalnum(static_cast<unsigned char>(escaped))) {
+                return false;  // \d, \w, \b, ...
+            } else {
+                steps.push_back({StepType::Literal, escaped});
+            }
+        } else if (std::string_view(".[]()|?*+^${}").find(c) != std::string_view::npos) {
+            return false;
+        } else {
+            steps.push_back({StepType::Literal, c});
+        }
+    }
+    
+    size_t prefix_end = 0;
+    while (prefix_end < steps.size() && steps[prefix_end].type == StepType::Literal) {
+        pattern.prefix += steps[prefix_end++].literal;
+    }
+    if (pattern.prefix.empty()) return false;
+    
+    // Greedy whitespace runs are only exact when followed by a
+    // non-whitespace literal (or the end of the pattern)
+    for (size_t i = prefix_end; i < steps.size(); ++i) {
+        if (steps[i].type != StepType::SpaceStar && steps[i].type != StepType::SpacePlus) continue;
+        if (i + 1 < steps.size() &&
+            (steps[i + 1].type != StepType::Literal ||
+             std::isspace(static_cast<unsigned char>(steps[i + 1].literal)))) {
+            pattern.prefix.clear();
+            return false;
+        }
+    }
+    
+    pattern.tail.assign(steps.begin() + prefix_end, steps.end());
+    return true;
+}
+
+bool PatternScanner::matchTail(const Pattern& pattern, std::string_view text, size_t pos) {
+    auto is_space = [&](size_t at) {
+        return at < text.size() && std::isspace(static_cast<unsigned char>(text[at]));
+    };
+    
+    for (const Step& step : pattern.tail) {
+        switch (step.type) {
+            case StepType::Literal:
+                if (pos >= text.size() || text[pos] != step.literal) return false;
+                ++pos;
+                break;
+            case StepType::Space:
+                if (!is_space(pos)) return false;
+                ++pos;
+                break;
+            case StepType::SpacePlus:
+                if (!is_space(pos)) return false;
+                [[fallthrough]];
+            case StepType::SpaceStar:
+                while (is_space(pos)) ++pos;
+                break;
+        }
+    }
+    return true;
+}
+
+std::vector<size_t> PatternScanner::collectMatches(std::string_view text,
+                                                   const std::vector<bool>& found) const {
+    std::vector<size_t> matches;
+    for (size_t index = 0; index < patterns_.size(); ++index) {
+        const auto& fallback = patterns_[index].fallback;
+        if (found[index] || (fallback && std::regex_search(text.begin(), text.end(), *fallback))) {
+            matches.push_back(index);
+        }
+    }
+    return matches;
 }
 
 // CodeValidator Implementation
+namespace {
+    const std::vector<std::string>& defaultDangerousPatterns() {
+        static const std::vector<std::string> patterns = {
+            R"(eval\s*\()",
+            R"(Function\s*\()",
+            R"(setTimeout\s*\()",
+            R"(setInterval\s*\()",
+            R"(require\s*\()",
+            R"(process\.)",
+            R"(__dirname)",
+            R"(__filename)",
+            R"(Buffer\.)",
+            R"(global\.)",
+            R"(module\.exports)",
+            R"(exports\.)",
+            R"(new\s+Function)",
+            R"(with\s*\()",
+            R"(arguments\.callee)"
+        };
+        return patterns;
+    }
+    
+    thread_local std::vector<std::string> t_last_violations;
+    
+    std::string describeCompileError(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                     const v8::TryCatch& try_catch) {
+        v8::Local<v8::Message> message = try_catch.Message();
+        if (message.IsEmpty()) {
+            return "Script failed to compile";
+        }
+        v8::String::Utf8Value text(isolate, message->Get());
+        int line = message->GetLineNumber(context).FromMaybe(0);
+        return std::string("Syntax error: ") + (*text ? *text : "unknown") +
+               " (line " + std::to_string(line) + ")";
+    }
+    
+    // Second, independent hash for cache keys (FNV-1a over 8-byte words)
+    uint64_t checkHash(std::string_view text) {
+        uint64_t hash = 14695981039346656037ULL;
+        size_t i = 0;
+        for (; i + 8 <= text.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, text.data() + i, sizeof(word));
+            hash = (hash ^ word) * 1099511628211ULL;
+            hash ^= hash >> 29;
+        }
+        for (; i < text.size(); ++i) {
+            hash = (hash ^ static_cast<unsigned char>(text[i])) * 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+CodeValidator::CodeValidator() {
+    rebuildRules();
+}
+
 CodeValidator& CodeValidator::getInstance() {
     static CodeValidator instance;
     return instance;
 }
 
 bool CodeValidator::validateCode(const std::string& code) {
-    std::lock_guard<std::mutex> lock(validation_mutex_);
+    ValidationResult result = validate(code);
+    t_last_violations = std::move(result.violations);
+    return result.valid;
+}
+
+CodeValidator::ValidationResult CodeValidator::validate(std::string_view code) {
+    std::shared_ptr<const Rules> rules = rules_.load();
     
-    // Check for dangerous patterns
-    if (!checkDangerousPatterns(code)) {
-        return false;
+    uint64_t hash = std::hash<std::string_view>()(code);
+    uint64_t check = checkHash(code);
+    auto& slot = cache_[hash % kCacheSlots];
+    
+    std::shared_ptr<const CacheEntry> entry = slot.load();
+    if (entry && entry->hash == hash && entry->check == check &&
+        entry->length == code.size() && entry->generation == rules->generation) {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return entry->result;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    
+    ValidationResult result = runChecks(*rules, code);
+    slot.store(std::make_shared<const CacheEntry>(
+        CacheEntry{hash, check, code.size(), rules->generation, result}));
+    return result;
+}
+
+bool CodeValidator::validateScript(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                  const std::string& code) {
+    if (mode_.load() == ValidationMode::PARSE) {
+        ScriptAnalysis analysis = analyzeScript(isolate, context, code);
+        t_last_violations = std::move(analysis.violations);
+        if (analysis.valid) {
+            // executeSandboxed of the same source binds this compile instead of parsing again
+            v8::HandleScope HandleScope(isolate);
+            SandboxManager::getInstance().cacheScript(isolate, code, analysis.script.Get(isolate));
+        }
+        return analysis.valid;
     }
     
-    // Check syntax
-    if (!checkSyntax(code)) {
+    if (!validateCode(code)) {
         return false;
     }
     
-    // Check complexity
-    if (!checkComplexity(code)) {
+    // Try to compile the script; a syntax error fails validation
+    v8::HandleScope HandleScope(isolate);
+    v8::TryCatch TryCatch(isolate);
+    v8::Local<v8::String> source;
+    if (!v8::String::NewFromUtf8(isolate, code.data(), v8::NewStringType::kNormal,
+                                 static_cast<int>(code.size())).ToLocal(&source) ||
+        v8::Script::Compile(context, source).IsEmpty()) {
+        t_last_violations.push_back(describeCompileError(isolate, context, TryCatch));
         return false;
     }
     
     return true;
 }
 
-bool CodeValidator::validateScript(v8::Isolate* isolate, v8::Local<v8::Context> context,
-                                  const std::string& code) {
-    if (!validateCode(code)) {
-        return false;
+CodeValidator::ValidationResult CodeValidator::validateStructure(std::string_view code, ScriptMetrics* metrics_out) {
+    std::shared_ptr<const Rules> rules = rules_.load();
+    const ScriptLimits& limits = rules->script_limits;
+    ScriptMetrics metrics = ScriptAnalyzer::analyze(code, limits.banned_identifiers);
+    
+    ValidationResult result;
+    if (!metrics.syntax_error.empty()) {
+        result.violations.push_back("Syntax error: " + metrics.syntax_error +
+                                    " (line " + std::to_string(metrics.syntax_error_line) + ")");
+    }
+    for (const auto& reference : metrics.banned_references) {
+        result.violations.push_back("Banned identifier '" + reference.name + "' (line " +
+                                    std::to_string(reference.line) + ")");
+    }
+    if (limits.max_nesting_depth != 0 && metrics.max_nesting_depth > limits.max_nesting_depth) {
+        result.violations.push_back("Nesting depth " + std::to_string(metrics.max_nesting_depth) +
+                                    " exceeds limit " + std::to_string(limits.max_nesting_depth));
+    }
+    if (limits.max_loops != 0 && metrics.loop_count > limits.max_loops) {
+        result.violations.push_back("Loop count " + std::to_string(metrics.loop_count) +
+                                    " exceeds limit " + std::to_string(limits.max_loops));
+    }
+    if (limits.max_functions != 0 && metrics.function_count > limits.max_functions) {
+        result.violations.push_back("Function count " + std::to_string(metrics.function_count) +
+                                    " exceeds limit " + std::to_string(limits.max_functions));
     }
     
-    // Try to compile the script
+    result.valid = result.violations.empty();
+    if (metrics_out) {
+        *metrics_out = std::move(metrics);
+    }
+    return result;
+}
+
+CodeValidator::ScriptAnalysis CodeValidator::analyzeScript(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                                           const std::string& code) {
+    ScriptAnalysis analysis;
+    analysis.isolate = isolate;
+    
+    ValidationResult structure = validateStructure(code, &analysis.metrics);
+    analysis.violations = std::move(structure.violations);
+    if (!structure.valid) {
+        return analysis;
+    }
+    
+    // The one real parse; kept as an UnboundScript plus a code cache so the
+    // later run does not parse again
+    v8::HandleScope HandleScope(isolate);
+    v8::Context::Scope ContextScope(context);
     v8::TryCatch TryCatch(isolate);
-    v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, code.c_str()).ToLocalChecked();
-    v8::Local<v8::Script> script = v8::Script::Compile(context, source).ToLocalChecked();
     
-    return !script.IsEmpty();
+    v8::Local<v8::String> source_string;
+    v8::Local<v8::UnboundScript> unbound;
+    if (!v8::String::NewFromUtf8(isolate, code.data(), v8::NewStringType::kNormal,
+                                 static_cast<int>(code.size())).ToLocal(&source_string)) {
+        analysis.violations.push_back("Script source could not be converted to a V8 string");
+        return analysis;
+    }
+    
+    v8::ScriptCompiler::Source source(source_string);
+    if (!v8::ScriptCompiler::CompileUnboundScript(isolate, &source).ToLocal(&unbound)) {
+        analysis.violations.push_back(describeCompileError(isolate, context, TryCatch));
+        return analysis;
+    }
+    
+    analysis.script.Reset(isolate, unbound);
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cache(v8::ScriptCompiler::CreateCodeCache(unbound));
+    if (cache) {
+        analysis.code_cache.assign(cache->data, cache->data + cache->length);
+    }
+    analysis.valid = true;
+    return analysis;
+}
+
+v8::MaybeLocal<v8::Script> CodeValidator::compileAnalyzed(v8::Isolate* isolate, v8::Local<v8::Context> context,
+                                                          const std::string& code, const ScriptAnalysis& analysis) {
+    if (!analysis.valid) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    
+    v8::EscapableHandleScope HandleScope(isolate);
+    v8::Context::Scope ContextScope(context);
+    
+    if (analysis.isolate == isolate && !analysis.script.IsEmpty()) {
+        return HandleScope.Escape(analysis.script.Get(isolate)->BindToCurrentContext());
+    }
+    
+    v8::Local<v8::String> source_string;
+    if (!v8::String::NewFromUtf8(isolate, code.data(), v8::NewStringType::kNormal,
+                                 static_cast<int>(code.size())).ToLocal(&source_string)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    
+    // Another isolate: consume the code cache (V8 recompiles if it is rejected)
+    v8::Local<v8::Script> script;
+    if (!analysis.code_cache.empty()) {
+        auto* cached = new v8::ScriptCompiler::CachedData(
+            analysis.code_cache.data(), static_cast<int>(analysis.code_cache.size()),
+            v8::ScriptCompiler::CachedData::BufferNotOwned);
+        v8::ScriptCompiler::Source source(source_string, cached);
+        if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+    } else if (!v8::Script::Compile(context, source_string).ToLocal(&script)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    return HandleScope.Escape(script);
+}
+
+void CodeValidator::setValidationMode(ValidationMode mode) {
+    mode_.store(mode);
+}
+
+CodeValidator::ValidationMode CodeValidator::getValidationMode() const {
+    return mode_.load();
+}
+
+void CodeValidator::setScriptLimits(const ScriptLimits& limits) {
+    std::lock_guard<std::mutex> lock(validation_mutex_);
+    script_limits_ = limits;
+    rebuildRules();
+}
+
+CodeValidator::ScriptLimits CodeValidator::getScriptLimits() const {
+    return rules_.load()->script_limits;
 }
 
 void CodeValidator::addDangerousPattern(const std::string& pattern) {
     std::lock_guard<std::mutex> lock(validation_mutex_);
-    dangerous_patterns_.push_back(std::regex(pattern));
+    custom_patterns_.push_back(pattern);
+    try {
+        rebuildRules();
+    } catch (...) {
+        custom_patterns_.pop_back();
+        throw;
+    }
 }
 
 void CodeValidator::removeDangerousPattern(const std::string& pattern) {
     std::lock_guard<std::mutex> lock(validation_mutex_);
-    dangerous_patterns_.erase(
-        std::remove_if(dangerous_patterns_.begin(), dangerous_patterns_.end(),
-                      [&pattern](const std::regex&) {
-                          // This is a simplified comparison
-                          return false; // Would need proper regex comparison
-                      }),
-        dangerous_patterns_.end()
+    custom_patterns_.erase(
+        std::remove(custom_patterns_.begin(), custom_patterns_.end(), pattern),
+        custom_patterns_.end()
     );
+    rebuildRules();
 }
 
 void CodeValidator::setComplexityLimit(size_t limit) {
     std::lock_guard<std::mutex> lock(validation_mutex_);
     complexity_limit_ = limit;
+    rebuildRules();
 }
 
 std::vector<std::string> CodeValidator::getViolations() const {
-    std::lock_guard<std::mutex> lock(validation_mutex_);
-    return violations_;
-}
-
-bool CodeValidator::checkDangerousPatterns(const std::string& code) {
-    violations_.clear();
-    
-    // Default dangerous patterns
-    std::vector<std::string> default_patterns = {
-        R"(eval\s*\()",
-        R"(Function\s*\()",
-        R"(setTimeout\s*\()",
-        R"(setInterval\s*\()",
-        R"(require\s*\()",
-        R"(process\.)",
-        R"(__dirname)",
-        R"(__filename)",
-        R"(Buffer\.)",
-        R"(global\.)",
-        R"(module\.exports)",
-        R"(exports\.)",
-        R"(new\s+Function)",
-        R"(with\s*\()",
-        R"(arguments\.callee)"
-    };
-    
-    for (const auto& pattern_str : default_patterns) {
-        std::regex pattern(pattern_str);
-        if (std::regex_search(code, pattern)) {
-            violations_.push_back("Dangerous pattern detected: " + pattern_str);
-        }
-    }
-    
-    // Check custom patterns
-    for (const auto& pattern : dangerous_patterns_) {
-        if (std::regex_search(code, pattern)) {
-            violations_.push_back("Custom dangerous pattern detected");
-        }
+    return t_last_violations;
+}
+
+CodeValidator::CacheStats CodeValidator::getCacheStats() const {
+    CacheStats stats;
+    stats.hits = cache_hits_.load(std::memory_order_relaxed);
+    stats.misses = cache_misses_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CodeValidator::clearCache() {
+    for (auto& slot : cache_) {
+        slot.store(nullptr);
     }
+}
+
+void CodeValidator::rebuildRules() {
+    std::vector<std::string> patterns = defaultDangerousPatterns();
+    patterns.insert(patterns.end(), custom_patterns_.begin(), custom_patterns_.end());
     
-    return violations_.empty();
+    // A new generation invalidates every cached result
+    rules_.store(std::make_shared<const Rules>(Rules{
+        PatternScanner(patterns), defaultDangerousPatterns().size(), complexity_limit_,
+        script_limits_, ++generation_}));
 }
 
-bool CodeValidator::checkSyntax(const std::string& code) {
-    // Basic syntax checks
+CodeValidator::ValidationResult CodeValidator::runChecks(const Rules& rules, std::string_view code) const {
+    ValidationResult result;
+    
+    // Pattern matching, bracket balance and nesting depth share one pass
     size_t brace_count = 0;
     size_t paren_count = 0;
     size_t bracket_count = 0;
+    size_t max_nesting = 0;
+    const char* unmatched_closing = nullptr;
     
-    for (char c : code) {
+    std::vector<size_t> matches = rules.scanner.scan(code, [&](unsigned char c) {
         switch (c) {
-            case '{': brace_count++; break;
-            case '}': if (brace_count > 0) brace_count--; else { violations_.push_back("Unmatched closing brace"); return false; } break;
+            case '{':
+                if (++brace_count > max_nesting) max_nesting = brace_count;
+                break;
+            case '}':
+                if (brace_count > 0) brace_count--;
+                else if (!unmatched_closing) unmatched_closing = "Unmatched closing brace";
+                break;
             case '(': paren_count++; break;
-            case ')': if (paren_count > 0) paren_count--; else { violations_.push_back("Unmatched closing parenthesis"); return false; } break;
+            case ')':
+                if (paren_count > 0) paren_count--;
+                else if (!unmatched_closing) unmatched_closing = "Unmatched closing parenthesis";
+                break;
             case '[': bracket_count++; break;
-            case ']': if (bracket_count > 0) bracket_count--; else { violations_.push_back("Unmatched closing bracket"); return false; } break;
+            case ']':
+                if (bracket_count > 0) bracket_count--;
+                else if (!unmatched_closing) unmatched_closing = "Unmatched closing bracket";
+                break;
         }
-    }
+    });
     
-    if (brace_count != 0) {
-        violations_.push_back("Unmatched opening brace");
-        return false;
+    for (size_t index : matches) {
+        if (index < rules.default_pattern_count) {
+            result.violations.push_back("Dangerous pattern detected: " + rules.scanner.pattern(index));
+        } else {
+            result.violations.push_back("Custom dangerous pattern detected");
+        }
     }
-    if (paren_count != 0) {
-        violations_.push_back("Unmatched opening parenthesis");
-        return false;
+    if (!result.violations.empty()) {
+        result.valid = false;
+        return result;
     }
-    if (bracket_count != 0) {
-        violations_.push_back("Unmatched opening bracket");
-        return false;
-    }
-    
-    return true;
-}
-
-bool CodeValidator::checkComplexity(const std::string& code) {
-    if (complexity_limit_ == 0) return true;
-    
-    // Simple complexity check based on code length and nesting
-    size_t complexity = code.length();
-    
-    // Count nested structures
-    size_t nesting_level = 0;
-    size_t max_nesting = 0;
     
-    for (char c : code) {
-        if (c == '{') {
-            nesting_level++;
-            max_nesting = std::max(max_nesting, nesting_level);
-        } else if (c == '}') {
-            if (nesting_level > 0) nesting_level--;
-        }
+    const char* syntax_error = unmatched_closing;
+    if (!syntax_error) {
+        if (brace_count != 0) syntax_error = "Unmatched opening brace";
+        else if (paren_count != 0) syntax_error = "Unmatched opening parenthesis";
+        else if (bracket_count != 0) syntax_error = "Unmatched opening bracket";
+    }
+    if (syntax_error) {
+        result.violations.push_back(syntax_error);
+        result.valid = false;
+        return result;
     }
     
-    complexity += max_nesting * 10; // Weight nesting heavily
-    
-    if (complexity > complexity_limit_) {
-        violations_.push_back("Code complexity exceeds limit: " + std::to_string(complexity));
-        return false;
+    if (rules.complexity_limit != 0) {
+        // Simple complexity measure: code length, weighting nesting heavily
+        size_t complexity = code.length() + max_nesting * 10;
+        if (complexity > rules.complexity_limit) {
+            result.violations.push_back("Code complexity exceeds limit: " + std::to_string(complexity));
+            result.valid = false;
+        }
     }
     
-    return true;
+    return result;
 }
 
 // CryptoManager Implementation
@@ -2,10 +2,11 @@
 #include <libplatform/libplatform.h>
 #include <iostream>
 #include <memory>
-#include "V8AutoRegister.h"
+#include "V8Module.h"
 
 using namespace v8;
-using namespace v8reg;
+
+namespace binding = v8integration::binding;
 
 void Fibonacci(const FunctionCallbackInfo<Value>& args) {
     Isolate* isolate = args.GetIsolate();
@@ -54,8 +55,12 @@ void Multiply(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(Number::New(isolate, a * b));
 }
 
-V8_REGISTER_FUNCTION(fibonacci, Fibonacci);
-V8_REGISTER_FUNCTION(multiply, Multiply);
+// An unnamed module puts its functions directly on the global object
+#define DIRECT_FUNCTIONS(X)      \
+    X(fibonacci, Fibonacci)      \
+    X(multiply, Multiply)
+
+V8_MODULE(kDirectFunctions, nullptr, "1.0.0", DIRECT_FUNCTIONS)
 
 int main() {
     std::unique_ptr<Platform> platform = platform::NewDefaultPlatform();
@@ -73,7 +78,7 @@ int main() {
         Local<Context> context = Context::New(isolate);
         Context::Scope context_scope(context);
         
-        FunctionRegistry::Instance().InstallAll(isolate, context);
+        binding::InstallModule(isolate, context, kDirectFunctions);
         
         const char* script_source = R"(
             console.log('Fibonacci(10) =', fibonacci(10));
@@ -90,6 +95,7 @@ int main() {
         Local<Value> result = script->Run(context).ToLocalChecked();
     }
     
+    binding::ReleaseIsolate(isolate);
     isolate->Dispose();
     V8::Dispose();
     V8::ShutdownPlatform();
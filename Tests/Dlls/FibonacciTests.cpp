@@ -5,8 +5,9 @@
 #include <memory>
 #include <string>
 #include <chrono>
-#include <cmath>
+#include <cstdio>
 #include <vector>
+#include "DllLoader.h"
 
 using namespace v8;
 
@@ -15,6 +16,7 @@ protected:
     Isolate* isolate;
     Isolate::CreateParams create_params;
     void* dll_handle = nullptr;
+    std::string dll_path;
     
     static void SetUpTestSuite() {
         static bool initialized = false;
@@ -45,7 +47,10 @@ protected:
         
         for (const char** path = paths; *path != nullptr; ++path) {
             dll_handle = dlopen(*path, RTLD_LAZY);
-            if (dll_handle) break;
+            if (dll_handle) {
+                dll_path = *path;
+                break;
+            }
         }
         
         ASSERT_NE(dll_handle, nullptr) << "Failed to load Fib.so from any path. Last error: " << dlerror();
@@ -84,6 +89,31 @@ protected:
         // Run the script
         return compiled_script->Run(context).ToLocalChecked();
     }
+    
+    // Runs `code` after RegisterV8Functions; returns the result as a string,
+    // or "throws: <message>"
+    std::string Run(const std::string& code) {
+        Isolate::Scope isolate_scope(isolate);
+        HandleScope handle_scope(isolate);
+        Local<Context> context = Context::New(isolate);
+        Context::Scope context_scope(context);
+        
+        typedef void (*RegisterFunc)(Isolate*, Local<Context>);
+        RegisterFunc registerFunc = (RegisterFunc)dlsym(dll_handle, "RegisterV8Functions");
+        EXPECT_NE(registerFunc, nullptr) << "Failed to find RegisterV8Functions";
+        registerFunc(isolate, context);
+        
+        TryCatch try_catch(isolate);
+        Local<Value> result;
+        Local<Script> script = Script::Compile(context, String::NewFromUtf8(isolate, code.c_str()).ToLocalChecked())
+            .ToLocalChecked();
+        if (!script->Run(context).ToLocal(&result)) {
+            String::Utf8Value error(isolate, try_catch.Exception());
+            return std::string("throws: ") + *error;
+        }
+        String::Utf8Value text(isolate, result);
+        return *text;
+    }
 };
 
 TEST_F(FibonacciTest, BasicValues) {
@@ -191,10 +221,118 @@ TEST_F(FibonacciTest, EdgeCases) {
     // Test edge case of 0
     EXPECT_EQ(CallFib(0)->NumberValue(isolate->GetCurrentContext()).FromJust(), 0);
     
-    // Test maximum safe integer range
-    // For n=78, the sum is still within JavaScript's safe integer range
-    double result = CallFib(78)->NumberValue(isolate->GetCurrentContext()).FromJust();
-    EXPECT_GT(result, 0);
-    EXPECT_FALSE(std::isnan(result));
-    EXPECT_FALSE(std::isinf(result));
-}
\ No newline at end of file
+    // 77 is the largest n whose sum is a safe integer; past it fib throws
+    // instead of returning a rounded Number
+    EXPECT_EQ(Run("fib(77)"), "8944394323791463");
+    EXPECT_EQ(Run("Number.isSafeInteger(fib(77)) && BigInt(fib(77)) === fibBig(77)"), "true");
+    EXPECT_EQ(Run("fib(78)"), "throws: RangeError: Argument 1 is out of range");
+    EXPECT_EQ(Run("fibBig(78)"), "14472334024676220");
+}
+
+TEST_F(FibonacciTest, BigIntResults) {
+    EXPECT_EQ(Run("typeof fibBig(10)"), "bigint");
+    EXPECT_EQ(Run("fibBig(0)"), "0");
+    EXPECT_EQ(Run("fibBig(100)"), "573147844013817084100");
+    
+    // Fast doubling against the plain BigInt loop, across the table boundary
+    // and several 64-bit word boundaries
+    EXPECT_EQ(Run(R"(
+        let a = 0n, b = 1n, sum = 0n, ok = true;
+        for (let n = 0; n <= 2000; n++) {
+            if (fibBig(n) !== sum) { ok = false; break; }
+            sum += a; [a, b] = [b, a + b];
+        }
+        ok
+    )"), "true");
+    
+    EXPECT_EQ(Run("fibBig((1 << 20) + 1)"), "throws: RangeError: Argument 1 is out of range");
+    EXPECT_EQ(Run("fibBig(-1)"), "throws: RangeError: Argument 1 must be non-negative");
+}
+
+TEST_F(FibonacciTest, BatchCalls) {
+    EXPECT_EQ(Run("fibBatch(new Int32Array([0, 1, 10, 91])) instanceof BigInt64Array"), "true");
+    EXPECT_EQ(Run("fibBatch(new Int32Array([0, 1, 10, 91])).join()"), "0,0,88,7540113804746346428");
+    EXPECT_EQ(Run("fibBatch(new Int32Array(0)).length"), "0");
+    EXPECT_EQ(Run("fibBatch([1, 2])"), "throws: TypeError: Argument 1 must be an Int32Array");
+    EXPECT_EQ(Run("fibBatch(new Int32Array([5, 92]))"), "throws: RangeError: Element 1 (92) is out of range 0..91");
+    EXPECT_EQ(Run("fibBatch(new Int32Array([-1]))"), "throws: RangeError: Element 0 (-1) is out of range 0..91");
+}
+
+TEST_F(FibonacciTest, BenchmarkThroughput) {
+    std::string report = Run(R"(
+        const count = 1 << 20;
+        const ns = new Int32Array(count);
+        for (let i = 0; i < count; i++) ns[i] = i % 92;
+        function time(f) {
+            const start = Date.now();
+            f();
+            return Date.now() - start;
+        }
+        let total = 0;
+        const perCall = time(() => { for (let i = 0; i < count; i++) total += fib(ns[i]); });
+        const batch = time(() => { fibBatch(ns); });
+        const bigFirst = time(() => fibBig(1 << 20));
+        const bigCached = time(() => fibBig(1 << 20));
+        [count + ' calls: fib ' + perCall + ' ms, fibBatch ' + batch + ' ms',
+         'fibBig(2^20): first ' + bigFirst + ' ms, cached ' + bigCached + ' ms'].join('\n')
+    )");
+    ASSERT_EQ(report.find("throws"), std::string::npos) << report;
+    std::printf("Fibonacci throughput\n%s\n", report.c_str());
+}
+
+TEST_F(FibonacciTest, ManifestDescribesExports) {
+    typedef const v8integration::binding::ManifestEntry* (*ManifestFunc)();
+    ManifestFunc manifestFunc = (ManifestFunc)dlsym(dll_handle, "V8Manifest");
+    ASSERT_NE(manifestFunc, nullptr) << "Failed to find V8Manifest";
+    
+    const auto* entry = manifestFunc();
+    ASSERT_NE(entry->name, nullptr);
+    EXPECT_STREQ(entry->name, "fib");
+    EXPECT_STREQ(entry->signature, "(u)l");
+    EXPECT_NE(dlsym(dll_handle, entry->symbol), nullptr);
+    EXPECT_STREQ(entry[1].name, "fibBig");
+    EXPECT_STREQ(entry[1].signature, "(u)*");
+    EXPECT_STREQ(entry[2].name, "fibBatch");
+    EXPECT_STREQ(entry[2].signature, "*");
+    EXPECT_EQ(entry[3].name, nullptr);
+}
+
+TEST_F(FibonacciTest, LoaderBindsManifestFunctionsLazilyAndReloadsInPlace) {
+    Isolate::Scope isolate_scope(isolate);
+    HandleScope handle_scope(isolate);
+    Local<Context> context = Context::New(isolate);
+    Context::Scope context_scope(context);
+    
+    DllLoader loader;
+    ASSERT_TRUE(loader.LoadDll(dll_path, isolate, context));
+    
+    auto run = [&](const char* code) {
+        Local<Script> script = Script::Compile(context, String::NewFromUtf8(isolate, code).ToLocalChecked())
+            .ToLocalChecked();
+        return script->Run(context).ToLocalChecked();
+    };
+    
+    // First read resolves and replaces the stub; later reads see the same function
+    EXPECT_TRUE(run("typeof fib === 'function' && fib === fib")->BooleanValue(isolate));
+    EXPECT_EQ(run("fib(10)")->NumberValue(context).FromJust(), 88);
+    
+    // A reload swaps the implementation behind references JS already holds
+    run("var heldFib = fib");
+    ASSERT_TRUE(loader.ReloadDll(dll_path, isolate, context));
+    EXPECT_TRUE(run("heldFib === fib")->BooleanValue(isolate));
+    EXPECT_EQ(run("heldFib(20)")->NumberValue(context).FromJust(), 10945);
+    ASSERT_TRUE(loader.ReloadDll(dll_path, isolate, context));
+    EXPECT_EQ(run("fib(15)")->NumberValue(context).FromJust(), 986);
+    
+    // After an unload the held function throws instead of calling unmapped code
+    ASSERT_TRUE(loader.UnloadDll(dll_path));
+    EXPECT_TRUE(run("try { heldFib(5); false } catch (e) { e.message.includes('DLL not loaded') }")
+                    ->BooleanValue(isolate));
+    
+    // Loading again brings it back
+    ASSERT_TRUE(loader.LoadDll(dll_path, isolate, context));
+    EXPECT_EQ(run("heldFib(10)")->NumberValue(context).FromJust(), 88);
+    
+    loader.UnloadAll();
+    v8integration::binding::ReleaseIsolate(isolate);
+}
@@ -1,63 +1,26 @@
 #include <v8.h>
 #include <libplatform/libplatform.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
-#include "V8ModuleSystem.h"
+#include "V8Module.h"
 
 using namespace v8;
-using namespace v8mod;
 
-void MathAdd(const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    
-    if (args.Length() < 2 || !args[0]->IsNumber() || !args[1]->IsNumber()) {
-        isolate->ThrowException(Exception::TypeError(
-            String::NewFromUtf8(isolate, "Two numeric arguments required").ToLocalChecked()));
-        return;
-    }
-    
-    double a = args[0].As<Number>()->Value();
-    double b = args[1].As<Number>()->Value();
-    
-    args.GetReturnValue().Set(Number::New(isolate, a + b));
-}
+namespace binding = v8integration::binding;
 
-void MathSubtract(const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    
-    if (args.Length() < 2 || !args[0]->IsNumber() || !args[1]->IsNumber()) {
-        isolate->ThrowException(Exception::TypeError(
-            String::NewFromUtf8(isolate, "Two numeric arguments required").ToLocalChecked()));
-        return;
-    }
-    
-    double a = args[0].As<Number>()->Value();
-    double b = args[1].As<Number>()->Value();
-    
-    args.GetReturnValue().Set(Number::New(isolate, a - b));
+// Plain C++ functions; the binding layer checks and converts the arguments
+double MathAdd(double a, double b) {
+    return a + b;
 }
 
-void MathPower(const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    
-    if (args.Length() < 2 || !args[0]->IsNumber() || !args[1]->IsNumber()) {
-        isolate->ThrowException(Exception::TypeError(
-            String::NewFromUtf8(isolate, "Two numeric arguments required").ToLocalChecked()));
-        return;
-    }
-    
-    double base = args[0].As<Number>()->Value();
-    double exponent = args[1].As<Number>()->Value();
-    
-    args.GetReturnValue().Set(Number::New(isolate, std::pow(base, exponent)));
+double MathSubtract(double a, double b) {
+    return a - b;
 }
 
-DEFINE_V8_MODULE(MathModule, "math", "1.0.0");
-
-void MathModule::RegisterFunctions(V8Module& module) {
-    module.AddFunction("add", MathAdd, "Add two numbers")
-          .AddFunction("subtract", MathSubtract, "Subtract two numbers")
-          .AddFunction("power", MathPower, "Raise a number to a power");
+double MathPower(double base, double exponent) {
+    return std::pow(base, exponent);
 }
 
 void StringReverse(const FunctionCallbackInfo<Value>& args) {
@@ -104,12 +67,20 @@ void StringRepeat(const FunctionCallbackInfo<Value>& args) {
         String::NewFromUtf8(isolate, result.c_str()).ToLocalChecked());
 }
 
-DEFINE_V8_MODULE(StringModule, "string", "1.0.0");
+// Modules are constant tables: name, version and (JS name, C++ function) pairs
+#define MATH_FUNCTIONS(X)        \
+    X(add, MathAdd)              \
+    X(subtract, MathSubtract)    \
+    X(power, MathPower)
 
-void StringModule::RegisterFunctions(V8Module& module) {
-    module.AddFunction("reverse", StringReverse, "Reverse a string")
-          .AddFunction("repeat", StringRepeat, "Repeat a string n times");
-}
+#define STRING_FUNCTIONS(X)      \
+    X(reverse, StringReverse)    \
+    X(repeat, StringRepeat)
+
+V8_MODULE(kMathModule, "math", "1.0.0", MATH_FUNCTIONS)
+V8_MODULE(kStringModule, "string", "1.0.0", STRING_FUNCTIONS)
+
+constexpr const binding::Module* kModules[] = {&kMathModule, &kStringModule};
 
 int main() {
     std::unique_ptr<Platform> platform = platform::NewDefaultPlatform();
@@ -127,8 +98,8 @@ int main() {
         Local<Context> context = Context::New(isolate);
         Context::Scope context_scope(context);
         
-        ModuleRegistry<MathModule>::GetModule().Install(isolate, context);
-        ModuleRegistry<StringModule>::GetModule().Install(isolate, context);
+        // Each namespace object is created the first time the script reads it
+        binding::InstallModules(isolate, context, kModules);
         
         const char* script_source = R"(
             console.log('Math module:');
@@ -147,6 +118,7 @@ int main() {
         Local<Value> result = script->Run(context).ToLocalChecked();
     }
     
+    binding::ReleaseIsolate(isolate);
     isolate->Dispose();
     V8::Dispose();
     V8::ShutdownPlatform();
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <v8.h>
+#include <libplatform/libplatform.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include "DllLoader.h"
+
+using namespace v8;
+
+// The Numeric DLL loaded through DllLoader, checked against the equivalent
+// pure-JS loops
+class NumericTest : public ::testing::Test {
+protected:
+    Isolate* isolate = nullptr;
+    Isolate::CreateParams create_params;
+    std::string dll_path;
+
+    static void SetUpTestSuite() {
+        static bool initialized = false;
+        if (!initialized) {
+            V8::InitializeICUDefaultLocation("");
+            V8::InitializeExternalStartupData("");
+            static std::unique_ptr<Platform> platform = platform::NewDefaultPlatform();
+            V8::InitializePlatform(platform.get());
+            V8::Initialize();
+            initialized = true;
+        }
+    }
+
+    void SetUp() override {
+        for (const char* path : {"../Bin/Numeric.so", "./Bin/Numeric.so", "Bin/Numeric.so"}) {
+            if (std::filesystem::exists(path)) {
+                dll_path = path;
+                break;
+            }
+        }
+        ASSERT_FALSE(dll_path.empty()) << "Failed to find Numeric.so";
+
+        create_params.array_buffer_allocator = ArrayBuffer::Allocator::NewDefaultAllocator();
+        isolate = Isolate::New(create_params);
+    }
+
+    void TearDown() override {
+        v8integration::binding::ReleaseIsolate(isolate);
+        isolate->Dispose();
+        delete create_params.array_buffer_allocator;
+    }
+
+    // Runs `code` with the DLL loaded; returns the result as a string, or
+    // "throws: <message>"
+    std::string Run(const std::string& code) {
+        Isolate::Scope isolate_scope(isolate);
+        HandleScope handle_scope(isolate);
+        Local<Context> context = Context::New(isolate);
+        Context::Scope context_scope(context);
+
+        DllLoader loader;
+        EXPECT_TRUE(loader.LoadDll(dll_path, isolate, context));
+
+        TryCatch try_catch(isolate);
+        Local<Value> result;
+        Local<Script> script = Script::Compile(context, String::NewFromUtf8(isolate, code.c_str()).ToLocalChecked())
+            .ToLocalChecked();
+        if (!script->Run(context).ToLocal(&result)) {
+            String::Utf8Value error(isolate, try_catch.Exception());
+            return std::string("throws: ") + *error;
+        }
+        String::Utf8Value text(isolate, result);
+        return *text;
+    }
+};
+
+// Shared by the tests: typed arrays of every supported kind with an odd
+// length, so the vector loops and their scalar tails both run
+static const char* kFixtures = R"(
+    function fill(Kind, n, f) { const a = new Kind(n); for (let i = 0; i < n; i++) a[i] = f(i); return a; }
+    const kinds = [Float64Array, Float32Array, Int32Array];
+    const arrays = kinds.map(Kind => [fill(Kind, 1001, i => (i * 37) % 101 - 50), fill(Kind, 1001, i => (i % 7) - 3)]);
+    function jsSum(a) { let s = 0; for (let i = 0; i < a.length; i++) s += a[i]; return s; }
+    function jsDot(a, b) { let s = 0; for (let i = 0; i < a.length; i++) s += a[i] * b[i]; return s; }
+    function same(a, b) { if (a.length !== b.length) return false; for (let i = 0; i < a.length; i++) if (!Object.is(a[i], b[i])) return false; return true; }
+)";
+
+TEST_F(NumericTest, ReductionsMatchJsLoops) {
+    EXPECT_EQ(Run(std::string(kFixtures) + R"(
+        arrays.every(([a, b]) => simdSum(a) === jsSum(a) && simdDot(a, b) === jsDot(a, b) &&
+                                 simdMinMax(a).min === Math.min(...a) && simdMinMax(a).max === Math.max(...a))
+    )"), "true");
+    EXPECT_EQ(Run("JSON.stringify([simdSum(new Float64Array(0)), simdMinMax(new Int32Array(0))])"),
+              "[0,{\"min\":null,\"max\":null}]");
+    EXPECT_EQ(Run("const m = simdMinMax(new Float32Array([1, NaN, 3])); isNaN(m.min) && isNaN(m.max)"), "true");
+}
+
+TEST_F(NumericTest, ElementWiseArithmetic) {
+    EXPECT_EQ(Run(std::string(kFixtures) + R"(
+        arrays.every(([a, b]) => {
+            const Kind = a.constructor;
+            const ref = (f) => fill(Kind, a.length, i => f(a[i], b[i]));
+            return same(simdAdd(a, b), ref((x, y) => x + y)) && same(simdSub(a, b), ref((x, y) => x - y)) &&
+                   same(simdMul(a, b), ref((x, y) => x * y)) && same(simdDiv(a, b), ref((x, y) => x / y)) &&
+                   same(simdMul(a, 3), ref(x => x * 3));
+        })
+    )"), "true");
+
+    // Writing into an existing array, including the input itself
+    EXPECT_EQ(Run("const a = new Int32Array([1, 2, 3]); simdAdd(a, 10, a) === a && a.join()"), "11,12,13");
+
+    // Int32 arithmetic wraps; division truncates and x / 0 is 0
+    EXPECT_EQ(Run("simdMul(new Int32Array([0x7fffffff]), 2)[0] === Math.imul(0x7fffffff, 2)"), "true");
+    EXPECT_EQ(Run("simdDiv(new Int32Array([7, -7, 5, -2147483648]), new Int32Array([2, 2, 0, -1])).join()"),
+              "3,-3,0,-2147483648");
+}
+
+TEST_F(NumericTest, PrefixSumHistogramAndSort) {
+    EXPECT_EQ(Run("simdPrefixSum(new Float64Array([1, 2, 3, 4])).join()"), "1,3,6,10");
+    EXPECT_EQ(Run("simdPrefixSum(new Int32Array([5, -1])) instanceof Int32Array"), "true");
+
+    // Bins over the array's range by default; hi lands in the last bin
+    EXPECT_EQ(Run("simdHistogram(new Float64Array([0, 1, 2, 3, 4, 5, 6, 7, 8, 10]), 5).join()"), "2,2,2,2,2");
+    EXPECT_EQ(Run("simdHistogram(new Int32Array([-5, 0, 1, 99]), 2, 0, 2).join()"), "1,1");
+
+    EXPECT_EQ(Run(std::string(kFixtures) + R"(
+        arrays.every(([a]) => same(simdSort(a.slice()), a.slice().sort()))
+    )"), "true");
+    EXPECT_EQ(Run("const s = simdSort(new Float64Array([NaN, 0, -0, -1])); Object.is(s[1], -0) && isNaN(s[3])"),
+              "true");
+}
+
+TEST_F(NumericTest, RejectsMismatchedArguments) {
+    EXPECT_EQ(Run("simdSum([1, 2, 3])"),
+              "throws: TypeError: Argument 1 must be a Float64Array, Float32Array or Int32Array");
+    EXPECT_EQ(Run("simdDot(new Float64Array(2), new Float32Array(2))"),
+              "throws: TypeError: Argument 2 must be a Float64Array like argument 1");
+    EXPECT_EQ(Run("simdAdd(new Int32Array(2), new Int32Array(3))"),
+              "throws: RangeError: Argument 2 must have the length of argument 1");
+    EXPECT_EQ(Run("simdHistogram(new Float64Array([NaN]), 4)"),
+              "throws: RangeError: Array contains NaN; pass lo and hi explicitly");
+}
+
+TEST_F(NumericTest, BenchmarkAgainstJsLoops) {
+    // Both sides get a warm-up so the JS loops are optimized before timing
+    std::string report = Run(std::string(kFixtures) + R"(
+        const n = 1 << 20, rounds = 50;
+        const a = fill(Float64Array, n, i => Math.sin(i)), b = fill(Float64Array, n, i => Math.cos(i));
+        const out = new Float64Array(n);
+        function jsAdd(a, b, out) { for (let i = 0; i < a.length; i++) out[i] = a[i] + b[i]; return out; }
+        function jsMinMax(a) {
+            let min = Infinity, max = -Infinity;
+            for (let i = 0; i < a.length; i++) { if (a[i] < min) min = a[i]; if (a[i] > max) max = a[i]; }
+            return {min, max};
+        }
+        function time(f) {
+            for (let r = 0; r < 5; r++) f();
+            const start = Date.now();
+            for (let r = 0; r < rounds; r++) f();
+            return (Date.now() - start) / rounds;
+        }
+        const rows = [
+            ['sum', time(() => jsSum(a)), time(() => simdSum(a))],
+            ['dot', time(() => jsDot(a, b)), time(() => simdDot(a, b))],
+            ['add', time(() => jsAdd(a, b, out)), time(() => simdAdd(a, b, out))],
+            ['minMax', time(() => jsMinMax(a)), time(() => simdMinMax(a))],
+        ];
+        simdLevel() + '\n' + rows.map(([name, js, native]) =>
+            name.padEnd(8) + 'js ' + js.toFixed(3) + ' ms  native ' + native.toFixed(3) + ' ms').join('\n')
+    )");
+    ASSERT_EQ(report.find("throws"), std::string::npos) << report;
+    std::printf("Numeric kernels (%d elements, ms per call), SIMD level %s\n", 1 << 20, report.c_str());
+}
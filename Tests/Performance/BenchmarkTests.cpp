@@ -3,9 +3,21 @@
 #include <libplatform/libplatform.h>
 #include <memory>
 #include <string>
+#include <algorithm>
+#include <span>
 #include <vector>
 #include <random>
 #include <chrono>
+#include <cstdio>
+#include <optional>
+#include <filesystem>
+#include <dlfcn.h>
+#include "V8Integration/ErrorHandler.h"
+#include "V8Integration/Security.h"
+#include "V8Binding.h"
+#include "V8Integration.h"
+#include "V8Struct.h"
+#include "DllLoader.h"
 
 class V8PerformanceFixture : public benchmark::Fixture {
 public:
@@ -381,6 +393,434 @@ BENCHMARK_DEFINE_F(V8PerformanceFixture, StressTest)(benchmark::State& state) {
 }
 BENCHMARK_REGISTER_F(V8PerformanceFixture, StressTest)->Iterations(10);
 
+// Sandbox creation: a fresh context with restrictions applied by deleting
+// each dangerous global (the per-sandbox work createSandbox used to do)
+// vs. instantiating from a cached template
+BENCHMARK_DEFINE_F(V8PerformanceFixture, SandboxCreationDeleteGlobals)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    const char* dangerous[] = {
+        "eval", "Function", "setTimeout", "setInterval", "require", "process",
+        "Buffer", "global", "__dirname", "__filename", "module", "exports"
+    };
+    
+    for (auto _ : state) {
+        v8::HandleScope HandleScope(isolate);
+        v8::Local<v8::Context> sandbox = v8::Context::New(isolate);
+        v8::Local<v8::Object> global = sandbox->Global();
+        for (const char* name : dangerous) {
+            global->Delete(sandbox, v8::String::NewFromUtf8(isolate, name).ToLocalChecked()).Check();
+        }
+        global->Set(sandbox, v8::String::NewFromUtf8Literal(isolate, "tenant"),
+                    v8::String::NewFromUtf8Literal(isolate, "acme")).Check();
+        benchmark::DoNotOptimize(sandbox);
+    }
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, SandboxCreationDeleteGlobals)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(V8PerformanceFixture, SandboxCreationFromTemplate)(benchmark::State& state) {
+    using v8_integration::SandboxManager;
+    v8::Isolate::Scope IsolateScope(isolate);
+    SandboxManager& manager = SandboxManager::getInstance();
+    
+    v8_integration::SandboxConfig config;
+    config.allowed_globals["tenant"] = "acme";
+    manager.registerTemplate("benchmark", config);
+    
+    for (auto _ : state) {
+        v8::HandleScope HandleScope(isolate);
+        manager.createSandboxFromTemplate(isolate, "benchmark_sandbox", "benchmark");
+        manager.removeSandbox("benchmark_sandbox");
+    }
+    manager.releaseTemplates(isolate);
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, SandboxCreationFromTemplate)->Unit(benchmark::kMicrosecond);
+
+// Repeated tenant handler through executeSandboxed, with the compiled-script
+// cache cleared every iteration (full parse) vs. left warm
+BENCHMARK_DEFINE_F(V8PerformanceFixture, SandboxRepeatedHandler)(benchmark::State& state) {
+    using v8_integration::SandboxManager;
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    SandboxManager& manager = SandboxManager::getInstance();
+    manager.createSandbox(isolate, "benchmark_handler", v8_integration::SandboxConfig{});
+    bool cached = state.range(0) != 0;
+    
+    std::string handler = "function handle(request) {\n";
+    for (int i = 0; i < 200; ++i) {
+        handler += "  if (request.kind === 'k" + std::to_string(i) + "') return " + std::to_string(i) + ";\n";
+    }
+    handler += "  return -1;\n}\nhandle({ kind: 'k150' });";
+    
+    for (auto _ : state) {
+        if (!cached) {
+            manager.clearScriptCache();
+        }
+        v8::HandleScope IterationScope(isolate);
+        v8::Local<v8::Value> result;
+        manager.executeSandboxed(isolate, "benchmark_handler", handler, result);
+        benchmark::DoNotOptimize(result);
+    }
+    
+    manager.removeSandbox("benchmark_handler");
+    manager.releaseTemplates(isolate);
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, SandboxRepeatedHandler)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Native calls from a hot JS loop through the FunctionCallbackInfo path
+// (Arg 0) vs. with a V8 Fast API CFunction attached (Arg 1)
+namespace {
+    int32_t NativeAdd(int32_t a, int32_t b) { return a + b; }
+
+    double NativeSum(std::span<const double> values) {
+        double total = 0;
+        for (double v : values) total += v;
+        return total;
+    }
+
+    template <auto F>
+    void RunNativeCallLoop(benchmark::State& state, v8::Isolate* isolate, v8::Local<v8::Context> ctx,
+                           const char* setup, const char* loop) {
+        bool fast = state.range(0) != 0;
+        v8::Local<v8::FunctionTemplate> tmpl = fast
+            ? v8integration::binding::NewFunctionTemplate<F>(isolate)
+            : v8::FunctionTemplate::New(isolate, &v8integration::binding::Callback<F>);
+        ctx->Global()->Set(ctx, v8::String::NewFromUtf8Literal(isolate, "native"),
+                           tmpl->GetFunction(ctx).ToLocalChecked()).Check();
+
+        v8::Script::Compile(ctx, v8::String::NewFromUtf8(isolate, setup).ToLocalChecked())
+            .ToLocalChecked()->Run(ctx).ToLocalChecked();
+        v8::Local<v8::Script> script =
+            v8::Script::Compile(ctx, v8::String::NewFromUtf8(isolate, loop).ToLocalChecked()).ToLocalChecked();
+
+        for (auto _ : state) {
+            v8::Local<v8::Value> result = script->Run(ctx).ToLocalChecked();
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations() * 10000);
+    }
+}
+
+BENCHMARK_DEFINE_F(V8PerformanceFixture, NativeCallScalar)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+
+    RunNativeCallLoop<&NativeAdd>(state, isolate, ctx,
+        "function run() { let s = 0; for (let i = 0; i < 10000; i++) s = native(s & 0xffff, i); return s; }",
+        "run()");
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, NativeCallScalar)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// V8 13 dropped FastApiTypedArray, so there a span argument has no fast
+// path and Arg 1 runs the same callback as Arg 0
+BENCHMARK_DEFINE_F(V8PerformanceFixture, NativeCallTypedArray)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+
+    RunNativeCallLoop<&NativeSum>(state, isolate, ctx,
+        "const samples = new Float64Array(16).fill(0.5);\n"
+        "function run() { let s = 0; for (let i = 0; i < 10000; i++) s += native(samples); return s; }",
+        "run()");
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, NativeCallTypedArray)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// The same DLL function called from a hot JS loop through DllLoader's
+// reloadable trampoline, which has no Fast API path (Arg 0), vs. bound
+// directly from the DLL's resolver with its CFunction (Arg 1). The gap is
+// what in-place reload costs per call.
+BENCHMARK_DEFINE_F(V8PerformanceFixture, DllNativeCall)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+    bool direct = state.range(0) != 0;
+    
+    std::string path;
+    for (const char* candidate : {"../Bin/Fib.so", "./Bin/Fib.so", "Bin/Fib.so"}) {
+        if (std::filesystem::exists(candidate)) {
+            path = candidate;
+            break;
+        }
+    }
+    if (path.empty()) {
+        state.SkipWithError("Fib.so not found");
+        return;
+    }
+    
+    DllLoader loader;
+    if (!loader.LoadDll(path, isolate, ctx)) {
+        state.SkipWithError("Failed to load Fib.so");
+        return;
+    }
+    void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+    auto resolve = reinterpret_cast<v8integration::binding::NativeResolver>(dlsym(handle, "v8native_fib"));
+    if (direct && resolve) {
+        const v8integration::binding::NativeFunction* fib = resolve();
+        ctx->Global()->Set(ctx, v8::String::NewFromUtf8Literal(isolate, "fib"),
+                           v8integration::binding::NewFunctionTemplate(isolate, fib->callback, fib->fast)
+                               ->GetFunction(ctx).ToLocalChecked()).Check();
+    }
+    
+    v8::Script::Compile(ctx, v8::String::NewFromUtf8Literal(isolate,
+        "function run() { let s = 0; for (let i = 0; i < 10000; i++) s += fib(i % 40); return s; }"))
+        .ToLocalChecked()->Run(ctx).ToLocalChecked();
+    v8::Local<v8::Script> script =
+        v8::Script::Compile(ctx, v8::String::NewFromUtf8Literal(isolate, "run()")).ToLocalChecked();
+    
+    for (auto _ : state) {
+        v8::Local<v8::Value> result = script->Run(ctx).ToLocalChecked();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * 10000);
+    
+    ctx->Global()->Delete(ctx, v8::String::NewFromUtf8Literal(isolate, "fib")).Check();
+    if (handle) {
+        dlclose(handle);
+    }
+    loader.UnloadAll();
+    v8integration::binding::ReleaseIsolate(isolate);
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, DllNativeCall)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Returning identically-shaped records: property-by-property Set on a fresh
+// object (Arg 0) vs. ShapedObjectBuilder, which instantiates the layout's
+// cached ObjectTemplate and stores into its existing fields (Arg 1). The
+// builder is constructed per batch, as a native function returning rows
+// would, so the cache lookup is included.
+BENCHMARK_DEFINE_F(V8PerformanceFixture, ShapedRecords)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+    bool templated = state.range(0) != 0;
+    
+    const char* fields[] = {"id", "name", "score", "active"};
+    v8::Local<v8::String> label = v8::String::NewFromUtf8Literal(isolate, "record");
+    
+    for (auto _ : state) {
+        v8::HandleScope IterationScope(isolate);
+        v8::Local<v8::Array> records = v8::Array::New(isolate, 1000);
+        std::optional<v8integration::ShapedObjectBuilder> shape;
+        if (templated) {
+            shape.emplace(isolate, std::vector<std::string>(std::begin(fields), std::end(fields)));
+        }
+        for (int r = 0; r < 1000; ++r) {
+            v8::Local<v8::Object> record;
+            v8::Local<v8::Value> values[] = {
+                v8::Integer::New(isolate, r), label, v8::Number::New(isolate, r * 0.5), v8::Boolean::New(isolate, r & 1)
+            };
+            if (templated) {
+                record = shape->New();
+                for (int i = 0; i < 4; ++i) {
+                    shape->Set(record, i, values[i]);
+                }
+            } else {
+                record = v8::Object::New(isolate);
+                for (int i = 0; i < 4; ++i) {
+                    record->Set(ctx, v8::String::NewFromUtf8(isolate, fields[i]).ToLocalChecked(), values[i]).Check();
+                }
+            }
+            records->Set(ctx, r, record).Check();
+        }
+        benchmark::DoNotOptimize(records);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, ShapedRecords)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Handing a 1M-element std::vector<double> result to JS: element-wise into
+// an Array of Numbers (Arg 0) vs. moving its storage into a Float64Array
+// backing store (Arg 1, a copy when V8_ENABLE_SANDBOX is defined) vs.
+// producing the values straight into a TypedArrayBuilder (Arg 2, which
+// also times filling them)
+BENCHMARK_DEFINE_F(V8PerformanceFixture, VectorResultToJS)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+    int64_t mode = state.range(0);
+    constexpr size_t kLength = 1 << 20;
+    
+    for (auto _ : state) {
+        v8::HandleScope IterationScope(isolate);
+        v8::Local<v8::Value> value;
+        if (mode == 2) {
+            v8integration::binding::TypedArrayBuilder<double> builder(isolate, kLength);
+            std::span<double> out = builder.span();
+            std::fill(out.begin(), out.end(), 1.5);
+            value = builder.Finish();
+            benchmark::DoNotOptimize(value);
+            continue;
+        }
+        
+        state.PauseTiming();
+        std::vector<double> result(kLength, 1.5);
+        state.ResumeTiming();
+        
+        if (mode == 1) {
+            value = v8integration::binding::MoveToTypedArray(isolate, std::move(result));
+        } else {
+            v8::Local<v8::Array> array = v8::Array::New(isolate, static_cast<int>(kLength));
+            for (size_t i = 0; i < kLength; ++i) {
+                array->Set(ctx, static_cast<uint32_t>(i), v8::Number::New(isolate, result[i])).Check();
+            }
+            value = array;
+        }
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, VectorResultToJS)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+
+// Decoding a JS record into a C++ struct: JSON.stringify + copy out of the
+// string (before any C++ JSON parse even starts; Arg 0) vs. reading the
+// fields directly through V8_STRUCT with eternal names (Arg 1)
+namespace {
+    struct BenchRecord {
+        std::string name;
+        int32_t id = 0;
+        double score = 0;
+        bool active = false;
+    };
+}
+V8_STRUCT(BenchRecord, name, id, score, active)
+
+BENCHMARK_DEFINE_F(V8PerformanceFixture, StructDecode)(benchmark::State& state) {
+    v8::Isolate::Scope IsolateScope(isolate);
+    v8::HandleScope HandleScope(isolate);
+    v8::Local<v8::Context> ctx = v8::Local<v8::Context>::New(isolate, context);
+    v8::Context::Scope ContextScope(ctx);
+    bool direct = state.range(0) != 0;
+    
+    v8::Local<v8::Value> record = v8::Script::Compile(ctx,
+        v8::String::NewFromUtf8Literal(isolate, "({ name: 'sensor-17', id: 17, score: 0.75, active: true })"))
+        .ToLocalChecked()->Run(ctx).ToLocalChecked();
+    
+    for (auto _ : state) {
+        v8::HandleScope IterationScope(isolate);
+        if (direct) {
+            BenchRecord decoded;
+            v8integration::binding::FromV8(isolate, record, decoded);
+            benchmark::DoNotOptimize(decoded);
+        } else {
+            v8::Local<v8::String> json = v8::JSON::Stringify(ctx, record).ToLocalChecked();
+            v8::String::Utf8Value utf8(isolate, json);
+            std::string text(*utf8, utf8.length());
+            benchmark::DoNotOptimize(text);
+        }
+    }
+    v8integration::binding::ReleaseIsolate(isolate);
+}
+BENCHMARK_REGISTER_F(V8PerformanceFixture, StructDecode)->Arg(0)->Arg(1);
+
+// Logger throughput with 16 producer threads, synchronous vs. async writer.
+// Output goes to a temp file with the console disabled so the numbers
+// reflect the logger rather than the terminal.
+static void LoggerThroughput(benchmark::State& state, bool async) {
+    using v8_integration::Logger;
+    Logger& logger = Logger::getInstance();
+    static const std::string log_path = "/tmp/v8_logger_benchmark.log";
+    
+    if (state.thread_index() == 0) {
+        std::remove(log_path.c_str());
+        logger.enableConsoleLogging(false);
+        logger.enableFileLogging(log_path);
+        if (async) {
+            logger.enableAsyncLogging();
+        }
+    }
+    
+    for (auto _ : state) {
+        logger.info("benchmark record from worker thread");
+    }
+    
+    if (state.thread_index() == 0) {
+        logger.flush();
+        logger.disableAsyncLogging();
+        logger.enableConsoleLogging(true);
+        std::remove(log_path.c_str());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(LoggerThroughput, Sync, false)->Threads(16)->UseRealTime();
+BENCHMARK_CAPTURE(LoggerThroughput, Async, true)->Threads(16)->UseRealTime();
+
+// Cost of a log statement filtered out by the runtime level
+static void LoggerDisabledStatement(benchmark::State& state) {
+    using v8_integration::Logger;
+    using v8_integration::LogLevel;
+    Logger::getInstance().setLevel(LogLevel::ERROR);
+    
+    int value = 0;
+    for (auto _ : state) {
+        V8_LOGF_WARN("value {} of {}", value, std::string("suppressed"));
+        benchmark::DoNotOptimize(++value);
+    }
+    
+    Logger::getInstance().setLevel(LogLevel::INFO);
+}
+BENCHMARK(LoggerDisabledStatement);
+
+// Text file logging vs. the binary sink for the same format-string statement
+static void LoggerOutputFormat(benchmark::State& state, bool binary) {
+    using v8_integration::Logger;
+    Logger& logger = Logger::getInstance();
+    const std::string log_path = "/tmp/v8_logger_format_benchmark.log";
+    std::remove(log_path.c_str());
+    
+    logger.enableConsoleLogging(false);
+    if (binary) {
+        v8_integration::BinaryLogWriter::Config config;
+        config.path = log_path;
+        logger.enableBinaryLogging(config);
+    } else {
+        logger.enableFileLogging(log_path);
+    }
+    
+    int64_t request = 0;
+    for (auto _ : state) {
+        V8_LOGF_INFO("request {} took {:.3f}ms status={}", ++request, 1.25, 200);
+    }
+    
+    logger.flush();
+    logger.disableBinaryLogging();
+    logger.enableConsoleLogging(true);
+    std::remove(log_path.c_str());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(LoggerOutputFormat, Text, false);
+BENCHMARK_CAPTURE(LoggerOutputFormat, Binary, true);
+
+// CodeValidator over a ~1MB bundle: a full scan, and a repeat upload served
+// from the source-hash cache
+static void CodeValidatorLargeBundle(benchmark::State& state, bool cached) {
+    using v8_integration::CodeValidator;
+    CodeValidator& validator = CodeValidator::getInstance();
+    validator.setComplexityLimit(0);
+    
+    std::string bundle;
+    while (bundle.size() < 1024 * 1024) {
+        bundle += "function handler" + std::to_string(bundle.size()) +
+                  "(request) {\n    const items = request.items.map(x => x * 2);\n"
+                  "    return { total: items.reduce((a, b) => a + b, 0) };\n}\n";
+    }
+    
+    for (auto _ : state) {
+        if (!cached) {
+            validator.clearCache();
+        }
+        benchmark::DoNotOptimize(validator.validateCode(bundle));
+    }
+    
+    validator.setComplexityLimit(10000);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bundle.size()));
+}
+BENCHMARK_CAPTURE(CodeValidatorLargeBundle, Scan, false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(CodeValidatorLargeBundle, Cached, true)->Unit(benchmark::kMillisecond);
+
 // Custom main function to add additional reporting
 int main(int argc, char** argv) {
     benchmark::Initialize(&argc, argv);
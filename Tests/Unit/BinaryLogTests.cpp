@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "V8Integration/BinaryLog.h"
+#include "V8Integration/ErrorHandler.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace v8_integration;
+
+class BinaryLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = "/tmp/v8_binary_log_test_" + std::to_string(::getpid()) + ".binlog";
+        removeFiles();
+    }
+
+    void TearDown() override {
+        Logger::getInstance().disableBinaryLogging();
+        removeFiles();
+    }
+
+    void removeFiles() {
+        std::remove(path_.c_str());
+        for (int i = 1; i < 8; ++i) {
+            std::remove((path_ + "." + std::to_string(i)).c_str());
+        }
+    }
+
+    static std::vector<BinaryLogReader::Record> readAll(const std::string& path, std::string* error = nullptr) {
+        std::ifstream input(path, std::ios::binary);
+        BinaryLogReader reader(input);
+        std::vector<BinaryLogReader::Record> records;
+        BinaryLogReader::Record record;
+        while (reader.next(record)) {
+            records.push_back(record);
+        }
+        if (error) {
+            *error = reader.error();
+        }
+        return records;
+    }
+
+    BinaryLogWriter::Config config() const {
+        BinaryLogWriter::Config config;
+        config.path = path_;
+        return config;
+    }
+
+    std::string path_;
+};
+
+TEST_F(BinaryLogTest, RoundTripsTypedArguments) {
+    {
+        BinaryLogWriter writer(config());
+        ASSERT_TRUE(writer.isOpen());
+        writer.write(2, "id={} ratio={:.2f} ok={} name={} delta={}", "main.cpp", 42, "run", true,
+                     7u, 0.125, true, std::string("fib"), -3);
+    }
+
+    std::string error;
+    auto records = readAll(path_, &error);
+    EXPECT_TRUE(error.empty()) << error;
+    ASSERT_EQ(records.size(), 1u);
+
+    const auto& record = records[0];
+    EXPECT_EQ(record.level, 2);
+    EXPECT_EQ(record.file, "main.cpp");
+    EXPECT_EQ(record.line, 42);
+    EXPECT_EQ(record.function, "run");
+    ASSERT_EQ(record.args.size(), 5u);
+    EXPECT_EQ(std::get<uint64_t>(record.args[0]), 7u);
+    EXPECT_EQ(std::get<int64_t>(record.args[4]), -3);
+    EXPECT_EQ(BinaryLogReader::render(record.format, record.args),
+              "id=7 ratio=0.12 ok=true name=fib delta=-3");
+}
+
+TEST_F(BinaryLogTest, InternsFormatsAndLocations) {
+    {
+        BinaryLogWriter writer(config());
+        writer.write(2, "count {}", "a.cpp", 1, "f", true, 1);
+    }
+    std::ifstream first(path_, std::ios::binary | std::ios::ate);
+    auto one_record = static_cast<size_t>(first.tellg());
+
+    removeFiles();
+    {
+        BinaryLogWriter writer(config());
+        for (int i = 0; i < 100; ++i) {
+            writer.write(2, "count {}", "a.cpp", 1, "f", true, i);
+        }
+    }
+    std::ifstream second(path_, std::ios::binary | std::ios::ate);
+    auto hundred_records = static_cast<size_t>(second.tellg());
+
+    // Definitions are written once; each further record is fixed-size
+    size_t per_record = (hundred_records - one_record) / 99;
+    EXPECT_LT(per_record, 40u);
+    EXPECT_EQ(readAll(path_).size(), 100u);
+}
+
+TEST_F(BinaryLogTest, RotatedFilesDecodeIndependently) {
+    auto cfg = config();
+    cfg.max_file_size = 512;
+    cfg.max_files = 3;
+    {
+        BinaryLogWriter writer(cfg);
+        for (int i = 0; i < 200; ++i) {
+            writer.write(3, "rotation record {}", "r.cpp", 7, "g", true, i);
+        }
+    }
+
+    std::ifstream rotated(path_ + ".1");
+    ASSERT_TRUE(rotated.good());
+    std::ifstream dropped(path_ + ".3");
+    EXPECT_FALSE(dropped.good());
+
+    for (const auto& path : {path_, path_ + ".1", path_ + ".2"}) {
+        std::string error;
+        auto records = readAll(path, &error);
+        EXPECT_TRUE(error.empty()) << path << ": " << error;
+        EXPECT_FALSE(records.empty()) << path;
+    }
+
+    auto newest = readAll(path_);
+    ASSERT_FALSE(newest.empty());
+    EXPECT_EQ(std::get<int64_t>(newest.back().args[0]), 199);
+}
+
+TEST_F(BinaryLogTest, RejectsNonLogInput) {
+    std::istringstream input("not a binary log");
+    BinaryLogReader reader(input);
+    BinaryLogReader::Record record;
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.error().empty());
+}
+
+TEST_F(BinaryLogTest, CorruptStringLengthIsReportedAsTruncated) {
+    std::string log(binlog::kMagic, sizeof(binlog::kMagic));
+    binlog::appendRaw<uint16_t>(log, binlog::kVersion);
+    binlog::appendRaw<uint32_t>(log, binlog::kByteOrderMark);
+    log.push_back(static_cast<char>(binlog::EntryType::Format));
+    binlog::appendRaw<uint32_t>(log, 1);
+    binlog::appendRaw<uint32_t>(log, 0xFFFFFFF0u);  // claims ~4 GiB, holds 5 bytes
+    log += "value";
+
+    std::istringstream input(log);
+    BinaryLogReader reader(input);
+    BinaryLogReader::Record record;
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_EQ(reader.error(), "truncated format entry");
+}
+
+TEST_F(BinaryLogTest, LoggerRoutesRecordsToBinarySink) {
+    Logger& logger = Logger::getInstance();
+    logger.setLevel(LogLevel::INFO);
+    ASSERT_TRUE(logger.enableBinaryLogging(config()));
+    EXPECT_TRUE(logger.isBinaryLogging());
+
+    V8_LOGF_INFO("loaded {} modules", 4);
+    V8_LOGF_DEBUG("filtered {}", 1);
+    logger.warn("plain text message");
+    logger.disableBinaryLogging();
+
+    auto records = readAll(path_);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(BinaryLogReader::render(records[0].format, records[0].args), "loaded 4 modules");
+    EXPECT_STREQ(BinaryLogReader::levelName(records[0].level), "INFO");
+    EXPECT_NE(records[0].file.find("BinaryLogTests.cpp"), std::string::npos);
+    EXPECT_EQ(BinaryLogReader::render(records[1].format, records[1].args), "plain text message");
+    EXPECT_STREQ(BinaryLogReader::levelName(records[1].level), "WARN");
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "V8Integration/Security.h"
+#include <atomic>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace v8_integration;
+
+class PatternScannerTest : public ::testing::Test {};
+
+TEST_F(PatternScannerTest, MatchesLiteralPrefixWithWhitespaceTail) {
+    PatternScanner scanner({R"(eval\s*\()", R"(new\s+Function)", R"(process\.)"});
+
+    EXPECT_EQ(scanner.findAll("x = eval  (code)"), std::vector<size_t>{0});
+    EXPECT_EQ(scanner.findAll("new\n\tFunction('a')"), std::vector<size_t>{1});
+    EXPECT_TRUE(scanner.findAll("newFunction()").empty());
+    EXPECT_TRUE(scanner.findAll("process_env").empty());
+    EXPECT_EQ(scanner.findAll("process.exit(); eval(x)"), (std::vector<size_t>{0, 2}));
+}
+
+TEST_F(PatternScannerTest, OverlappingPrefixesAreAllReported) {
+    PatternScanner scanner({"exports\\.", "module\\.exports", "s\\.x"});
+
+    EXPECT_EQ(scanner.findAll("module.exports.x = 1"), (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST_F(PatternScannerTest, AgreesWithStdRegex) {
+    std::vector<std::string> patterns = {
+        R"(eval\s*\()", R"(with\s*\()", R"(arguments\.callee)", R"(Buffer\.)", R"(new\s+Function)"
+    };
+    PatternScanner scanner(patterns);
+
+    std::vector<std::string> inputs = {
+        "", "eval", "eval(", "evaleval (", "with(x){}", "with  \n (", "arguments.callee",
+        "argumentscallee", "Buffer.from()", "new Function", "newFunction", "retrieval ()"
+    };
+    for (const auto& input : inputs) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (std::regex_search(input, std::regex(patterns[i]))) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(scanner.findAll(input), expected) << input;
+    }
+}
+
+TEST_F(PatternScannerTest, UnsupportedSyntaxFallsBackToRegex) {
+    PatternScanner scanner({R"(\bfetch\b)", R"(import\s*\(\s*['"])"});
+
+    EXPECT_EQ(scanner.findAll("await fetch(url)"), std::vector<size_t>{0});
+    EXPECT_TRUE(scanner.findAll("prefetch(url)").empty());
+    EXPECT_EQ(scanner.findAll("import( 'fs')"), std::vector<size_t>{1});
+}
+
+class CodeValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        validator().setComplexityLimit(10000);
+        validator().clearCache();
+    }
+
+    void TearDown() override {
+        validator().removeDangerousPattern("fetch\\s*\\(");
+        validator().setComplexityLimit(10000);
+    }
+
+    static CodeValidator& validator() { return CodeValidator::getInstance(); }
+};
+
+TEST_F(CodeValidatorTest, AcceptsSafeCode) {
+    EXPECT_TRUE(validator().validateCode("function add(a, b) { return a + b; }"));
+    EXPECT_TRUE(validator().getViolations().empty());
+}
+
+TEST_F(CodeValidatorTest, ReportsDangerousPatterns) {
+    EXPECT_FALSE(validator().validateCode("eval('1'); process.exit()"));
+
+    auto violations = validator().getViolations();
+    ASSERT_EQ(violations.size(), 2u);
+    EXPECT_NE(violations[0].find("eval"), std::string::npos);
+    EXPECT_NE(violations[1].find("process"), std::string::npos);
+}
+
+TEST_F(CodeValidatorTest, ReportsUnbalancedBrackets) {
+    EXPECT_FALSE(validator().validateCode("function f() { return [1, 2; }"));
+    ASSERT_EQ(validator().getViolations().size(), 1u);
+
+    EXPECT_FALSE(validator().validateCode("x)"));
+    EXPECT_EQ(validator().getViolations()[0], "Unmatched closing parenthesis");
+}
+
+TEST_F(CodeValidatorTest, EnforcesComplexityLimit) {
+    validator().setComplexityLimit(50);
+    EXPECT_FALSE(validator().validateCode(std::string(100, ' ')));
+    EXPECT_NE(validator().getViolations()[0].find("complexity"), std::string::npos);
+}
+
+TEST_F(CodeValidatorTest, CustomPatternsCanBeAddedAndRemoved) {
+    validator().addDangerousPattern("fetch\\s*\\(");
+    EXPECT_FALSE(validator().validateCode("fetch ('/api')"));
+    EXPECT_EQ(validator().getViolations()[0], "Custom dangerous pattern detected");
+
+    validator().removeDangerousPattern("fetch\\s*\\(");
+    EXPECT_TRUE(validator().validateCode("fetch ('/api')"));
+}
+
+TEST_F(CodeValidatorTest, InvalidCustomPatternThrowsAndIsNotKept) {
+    EXPECT_THROW(validator().addDangerousPattern("(unclosed"), std::regex_error);
+    EXPECT_TRUE(validator().validateCode("(unclosed)"));
+}
+
+TEST_F(CodeValidatorTest, RepeatedSourceIsServedFromCache) {
+    std::string code = "let total = 0; for (let i = 0; i < 10; i++) { total += i; }";
+    auto before = validator().getCacheStats();
+
+    EXPECT_TRUE(validator().validateCode(code));
+    EXPECT_TRUE(validator().validateCode(code));
+
+    auto after = validator().getCacheStats();
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+}
+
+TEST_F(CodeValidatorTest, RuleChangesInvalidateCachedResults) {
+    std::string code = "fetch('/api')";
+    EXPECT_TRUE(validator().validateCode(code));
+
+    validator().addDangerousPattern("fetch\\s*\\(");
+    EXPECT_FALSE(validator().validateCode(code));
+}
+
+TEST_F(CodeValidatorTest, ConcurrentCallersSeeConsistentResults) {
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([t, &failures] {
+            for (int i = 0; i < 200; ++i) {
+                std::string safe = "var x" + std::to_string(t * 1000 + i) + " = 1;";
+                std::string unsafe = "eval('" + std::to_string(i) + "')";
+                if (!validator().validateCode(safe) || validator().validateCode(unsafe)) {
+                    ++failures;
+                }
+                if (validator().getViolations().empty()) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+}
+
+class ScriptAnalyzerTest : public ::testing::Test {};
+
+TEST_F(ScriptAnalyzerTest, CountsLoopsFunctionsAndNesting) {
+    auto metrics = ScriptAnalyzer::analyze(
+        "function f(a) { for (let i = 0; i < a.length; i++) { while (x) {} } }\n"
+        "do { y++; } while (y < 3);\n"
+        "const g = (v) => v * 2;");
+
+    EXPECT_TRUE(metrics.syntax_error.empty()) << metrics.syntax_error;
+    EXPECT_EQ(metrics.loop_count, 3u);
+    EXPECT_EQ(metrics.function_count, 2u);
+    EXPECT_EQ(metrics.max_nesting_depth, 3u);
+}
+
+TEST_F(ScriptAnalyzerTest, IgnoresBracketsAndKeywordsInLiterals) {
+    auto metrics = ScriptAnalyzer::analyze(
+        "const s = '{[(for'; // while (\n"
+        "/* function { */ const r = /[)}]+/g;\n"
+        "const t = `a ${ { k: '}' }.k } for`;\n"
+        "const q = 4 / 2 / 1; obj.for = obj.function;");
+
+    EXPECT_TRUE(metrics.syntax_error.empty()) << metrics.syntax_error;
+    EXPECT_EQ(metrics.loop_count, 0u);
+    EXPECT_EQ(metrics.function_count, 0u);
+    EXPECT_EQ(metrics.max_nesting_depth, 2u);
+}
+
+TEST_F(ScriptAnalyzerTest, ReportsFirstLexicalError) {
+    auto metrics = ScriptAnalyzer::analyze("let a = 1;\nlet b = 'open;\n");
+    EXPECT_EQ(metrics.syntax_error, "Unterminated string literal");
+    EXPECT_EQ(metrics.syntax_error_line, 2);
+
+    metrics = ScriptAnalyzer::analyze("if (x) {\n  call(\n}");
+    EXPECT_EQ(metrics.syntax_error, "Unmatched closing brace");
+    EXPECT_EQ(metrics.syntax_error_line, 3);
+}
+
+TEST_F(ScriptAnalyzerTest, FindsBannedIdentifiersOutsideLiterals) {
+    auto metrics = ScriptAnalyzer::analyze("const e = 'eval';\nglobalThis\n  .eval(code);", {"eval"});
+    ASSERT_EQ(metrics.banned_references.size(), 1u);
+    EXPECT_EQ(metrics.banned_references[0].name, "eval");
+    EXPECT_EQ(metrics.banned_references[0].line, 3);
+}
+
+TEST_F(ScriptAnalyzerTest, IgnoresBannedNamesAsPropertiesAndKeys) {
+    auto banned = CodeValidator::ScriptLimits{}.banned_identifiers;
+    auto metrics = ScriptAnalyzer::analyze(
+        "job.process();\nconst m = config.module ?? cfg?.exports;\n"
+        "const o = {exports: 1, global : 2, 'require': 3};\nswitch (o.exports) { default: break; }", banned);
+    EXPECT_TRUE(metrics.syntax_error.empty()) << metrics.syntax_error;
+    EXPECT_TRUE(metrics.banned_references.empty());
+}
+
+TEST_F(ScriptAnalyzerTest, ReportsFreeReferencesNextToKeys) {
+    auto banned = CodeValidator::ScriptLimits{}.banned_identifiers;
+    auto metrics = ScriptAnalyzer::analyze(
+        "const o = {process, key: module};\nconst f = ok ? require : null;\n"
+        "function g() { return arguments.callee; }", banned);
+    ASSERT_EQ(metrics.banned_references.size(), 4u);
+    EXPECT_EQ(metrics.banned_references[0].name, "process");
+    EXPECT_EQ(metrics.banned_references[1].name, "module");
+    EXPECT_EQ(metrics.banned_references[2].name, "require");
+    EXPECT_EQ(metrics.banned_references[3].name, "callee");
+    EXPECT_EQ(metrics.banned_references[3].line, 3);
+}
+
+TEST_F(CodeValidatorTest, StructureCheckAppliesScriptLimits) {
+    auto original = validator().getScriptLimits();
+    auto limits = original;
+    limits.max_loops = 1;
+    validator().setScriptLimits(limits);
+
+    auto result = validator().validateStructure("for (;;) {} while (false) {}");
+    EXPECT_FALSE(result.valid);
+    ASSERT_EQ(result.violations.size(), 1u);
+    EXPECT_EQ(result.violations[0], "Loop count 2 exceeds limit 1");
+
+    // Patterns would flag the string; the tokenizer does not
+    ScriptMetrics metrics;
+    result = validator().validateStructure("const help = 'never call eval(x)';", &metrics);
+    EXPECT_TRUE(result.valid);
+    EXPECT_GT(metrics.token_count, 0u);
+
+    result = validator().validateStructure("require('fs')");
+    ASSERT_EQ(result.violations.size(), 1u);
+    EXPECT_EQ(result.violations[0], "Banned identifier 'require' (line 1)");
+
+    validator().setScriptLimits(original);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../../Source/App/Console/DllLoader.h"
 #include <filesystem>
+#include <atomic>
+#include <thread>
+#include <libplatform/libplatform.h>
 
 namespace fs = std::filesystem;
 
@@ -104,4 +107,118 @@ TEST(DllLoaderBasic, PathTraversal) {
     EXPECT_FALSE(loader.UnloadDll("../../../etc/passwd"));
     EXPECT_FALSE(loader.UnloadDll("./././file.so"));
     EXPECT_FALSE(loader.UnloadDll("path/../../../file.so"));
-}
\ No newline at end of file
+}
+
+TEST(DllLoaderBasic, RefCountOfUnknownPathIsZero) {
+    EXPECT_EQ(DllLoader::GetRefCount("missing.so"), 0u);
+    EXPECT_EQ(DllLoader::GetRefCount(""), 0u);
+}
+
+// Loaders on separate isolates and threads sharing one library
+class DllLoaderSharedTest : public ::testing::Test {
+protected:
+    std::string dll_path;
+
+    static void SetUpTestSuite() {
+        static std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    void SetUp() override {
+        for (const char* path : {"../Bin/Fib.so", "./Bin/Fib.so", "Bin/Fib.so"}) {
+            if (fs::exists(path)) {
+                dll_path = path;
+                break;
+            }
+        }
+        if (dll_path.empty()) {
+            GTEST_SKIP() << "Fib.so not built";
+        }
+    }
+
+    // Load, call and unload `iterations` times on a fresh isolate
+    static int LoadCallUnload(const std::string& path, int iterations) {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        v8::Isolate* isolate = v8::Isolate::New(create_params);
+        int failures = 0;
+        {
+            v8::Isolate::Scope isolate_scope(isolate);
+            v8::HandleScope handle_scope(isolate);
+            v8::Local<v8::Context> context = v8::Context::New(isolate);
+            v8::Context::Scope context_scope(context);
+
+            DllLoader loader;
+            v8::Local<v8::Script> script = v8::Script::Compile(
+                context, v8::String::NewFromUtf8Literal(isolate, "fib(10)")).ToLocalChecked();
+            for (int i = 0; i < iterations; ++i) {
+                if (!loader.LoadDll(path, isolate, context)) {
+                    ++failures;
+                    continue;
+                }
+                v8::Local<v8::Value> result;
+                if (!script->Run(context).ToLocal(&result) || result->NumberValue(context).FromJust() != 88) {
+                    ++failures;
+                }
+                if (!loader.UnloadDll(path)) {
+                    ++failures;
+                }
+            }
+        }
+        v8integration::binding::ReleaseIsolate(isolate);
+        isolate->Dispose();
+        delete create_params.array_buffer_allocator;
+        return failures;
+    }
+};
+
+TEST_F(DllLoaderSharedTest, LoadersShareOneRefcountedLibrary) {
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    {
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> first = v8::Context::New(isolate);
+        v8::Local<v8::Context> second = v8::Context::New(isolate);
+
+        DllLoader a;
+        DllLoader b;
+        ASSERT_TRUE(a.LoadDll(dll_path, isolate, first));
+        // A different spelling of the same file shares the mapping
+        ASSERT_TRUE(b.LoadDll(fs::absolute(dll_path).string(), isolate, second));
+        EXPECT_EQ(DllLoader::GetRefCount(dll_path), 2u);
+
+        // Functions stay callable in one context while the other unloads
+        ASSERT_TRUE(a.UnloadDll(dll_path));
+        EXPECT_EQ(DllLoader::GetRefCount(dll_path), 1u);
+        v8::Context::Scope context_scope(second);
+        v8::Local<v8::Value> result = v8::Script::Compile(
+            second, v8::String::NewFromUtf8Literal(isolate, "fib(10)")).ToLocalChecked()->Run(second).ToLocalChecked();
+        EXPECT_EQ(result->NumberValue(second).FromJust(), 88);
+
+        b.UnloadAll();
+        EXPECT_EQ(DllLoader::GetRefCount(dll_path), 0u);
+    }
+    v8integration::binding::ReleaseIsolate(isolate);
+    isolate->Dispose();
+    delete create_params.array_buffer_allocator;
+}
+
+TEST_F(DllLoaderSharedTest, ConcurrentLoadUnloadAcrossIsolates) {
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 50;
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] { failures += LoadCallUnload(dll_path, kIterations); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(DllLoader::GetRefCount(dll_path), 0u);
+}
@@ -0,0 +1,179 @@
+#include "V8Compat.h"
+#include "../TestUtils.h"
+#include "V8Integration/Security.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+using namespace v8_integration;
+using namespace std::chrono_literals;
+
+class ExecutionWatchdogTest : public ::testing::Test {
+protected:
+    static ExecutionWatchdog& watchdog() { return ExecutionWatchdog::getInstance(); }
+
+    static void waitForIdle() {
+        auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (watchdog().getStats().armed > 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+};
+
+TEST_F(ExecutionWatchdogTest, ExpiresAfterTimeout) {
+    std::atomic<bool> fired{false};
+    auto start = std::chrono::steady_clock::now();
+    auto handle = watchdog().arm(20ms, [&fired] { fired = true; });
+
+    while (!fired && std::chrono::steady_clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(fired);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_TRUE(watchdog().disarm(handle));
+}
+
+TEST_F(ExecutionWatchdogTest, DisarmedEntryNeverFires) {
+    std::atomic<bool> fired{false};
+    auto handle = watchdog().arm(30ms, [&fired] { fired = true; });
+    EXPECT_FALSE(watchdog().disarm(handle));
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_FALSE(fired);
+    EXPECT_FALSE(watchdog().disarm(handle));
+}
+
+TEST_F(ExecutionWatchdogTest, CallbacksRunOutsideTheLock) {
+    // A callback that re-arms would deadlock if it ran under the watchdog lock
+    std::atomic<bool> fired{false};
+    std::atomic<ExecutionWatchdog::Handle> rearmed{0};
+    auto handle = watchdog().arm(5ms, [&fired, &rearmed] {
+        rearmed = watchdog().arm(5ms, [&fired] { fired = true; });
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    while (!fired && std::chrono::steady_clock::now() - start < 2s) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_TRUE(fired);
+    EXPECT_TRUE(watchdog().disarm(handle));
+    EXPECT_TRUE(watchdog().disarm(rearmed));
+}
+
+TEST_F(ExecutionWatchdogTest, TimeoutsLongerThanOneWheelTurn) {
+    std::atomic<bool> fired{false};
+    auto timeout = ExecutionWatchdog::kTickResolution * (ExecutionWatchdog::kWheelSlots + 100);
+    auto start = std::chrono::steady_clock::now();
+    auto handle = watchdog().arm(timeout, [&fired] { fired = true; });
+
+    while (!fired && std::chrono::steady_clock::now() - start < timeout + 2s) {
+        std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_TRUE(fired);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
+    watchdog().disarm(handle);
+}
+
+TEST_F(ExecutionWatchdogTest, ManyConcurrentDeadlinesShareOneThread) {
+    waitForIdle();
+    auto before = watchdog().getStats();
+
+    std::atomic<int> fired{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&fired] {
+            std::vector<ExecutionWatchdog::Handle> short_lived;
+            std::vector<ExecutionWatchdog::Handle> expiring;
+            for (int i = 0; i < 500; ++i) {
+                short_lived.push_back(watchdog().arm(1s, [&fired] { ++fired; }));
+                expiring.push_back(watchdog().arm(std::chrono::milliseconds(1 + i % 10), [&fired] { ++fired; }));
+            }
+            for (auto handle : short_lived) {
+                watchdog().disarm(handle);
+            }
+            std::this_thread::sleep_for(50ms);
+            for (auto handle : expiring) {
+                watchdog().disarm(handle);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(fired.load(), 8 * 500);
+    EXPECT_EQ(watchdog().getStats().expired - before.expired, 8u * 500u);
+    EXPECT_EQ(watchdog().getStats().armed, 0u);
+}
+
+class SandboxTimeoutTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<v8::Platform> platform;
+    v8::Isolate* isolate = nullptr;
+
+    static void SetUpTestSuite() {
+        v8::V8::InitializeICUDefaultLocation(".");
+        v8::V8::InitializeExternalStartupData(".");
+        platform = v8_compat::CreateDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    static void TearDownTestSuite() {
+        v8::V8::Dispose();
+        v8::V8::DisposePlatform();
+    }
+
+    void SetUp() override {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        isolate = v8::Isolate::New(create_params);
+    }
+
+    void TearDown() override {
+        SandboxManager::getInstance().removeSandbox("timeout_test");
+        SandboxManager::getInstance().releaseTemplates(isolate);
+        isolate->Dispose();
+    }
+};
+
+std::unique_ptr<v8::Platform> SandboxTimeoutTest::platform;
+
+TEST_F(SandboxTimeoutTest, RunawayScriptIsTerminatedAndIsolateRecovers) {
+    v8_test::V8TestEnvironment env(isolate);
+    SandboxConfig config;
+    config.execution_timeout = 50ms;
+    ASSERT_TRUE(SandboxManager::getInstance().createSandbox(isolate, "timeout_test", config));
+
+    v8::Local<v8::Value> result;
+    ErrorInfo error(ErrorCode::SUCCESS, "");
+    EXPECT_FALSE(SandboxManager::getInstance().executeSandboxed(isolate, "timeout_test", "while (true) {}",
+                                                               result, &error));
+    EXPECT_EQ(error.code, ErrorCode::TIMEOUT_ERROR);
+    EXPECT_FALSE(isolate->IsExecutionTerminating());
+
+    ASSERT_TRUE(SandboxManager::getInstance().executeSandboxed(isolate, "timeout_test", "6 * 7", result));
+    EXPECT_EQ(result->Int32Value(env.context).FromJust(), 42);
+}
+
+TEST_F(SandboxTimeoutTest, ScriptErrorsAreNotReportedAsTimeouts) {
+    v8_test::V8TestEnvironment env(isolate);
+    SandboxConfig config;
+    config.execution_timeout = 1s;
+    ASSERT_TRUE(SandboxManager::getInstance().createSandbox(isolate, "timeout_test", config));
+
+    v8::Local<v8::Value> result;
+    ErrorInfo error(ErrorCode::SUCCESS, "");
+    EXPECT_FALSE(SandboxManager::getInstance().executeSandboxed(isolate, "timeout_test", "undefinedName.x",
+                                                               result, &error));
+    EXPECT_EQ(error.code, ErrorCode::REFERENCE_ERROR);
+
+    error = ErrorInfo(ErrorCode::SUCCESS, "");
+    EXPECT_FALSE(SandboxManager::getInstance().executeSandboxed(isolate, "timeout_test", "let = ;",
+                                                               result, &error));
+    EXPECT_EQ(error.code, ErrorCode::COMPILATION_FAILED);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+// Strip TRACE at compile time in this file so the tests can observe it
+#define V8_LOG_MIN_LEVEL 1
+#include "V8Integration/ErrorHandler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace v8_integration;
+
+namespace {
+    // Logger handlers cannot be removed, so the slow handler is registered
+    // once and switched on only by the tests that need a busy writer
+    std::atomic<bool> slow_handler_enabled{false};
+}
+
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger().enableConsoleLogging(false);
+        logger().setLevel(LogLevel::INFO);
+        log_path_ = "/tmp/v8_async_logger_test_" + std::to_string(::getpid()) + ".log";
+        std::remove(log_path_.c_str());
+        logger().enableFileLogging(log_path_);
+    }
+
+    void TearDown() override {
+        logger().disableAsyncLogging();
+        logger().enableConsoleLogging(true);
+        std::remove(log_path_.c_str());
+    }
+
+    size_t countLines() const {
+        std::ifstream in(log_path_);
+        size_t lines = 0;
+        std::string line;
+        while (std::getline(in, line)) {
+            ++lines;
+        }
+        return lines;
+    }
+
+    static Logger& logger() { return Logger::getInstance(); }
+
+    std::string log_path_;
+};
+
+TEST_F(AsyncLoggerTest, FlushWritesAllRecords) {
+    logger().enableAsyncLogging();
+    EXPECT_TRUE(logger().isAsyncLogging());
+
+    for (int i = 0; i < 500; ++i) {
+        logger().info("record " + std::to_string(i));
+    }
+    logger().flush();
+
+    EXPECT_EQ(countLines(), 500u);
+}
+
+TEST_F(AsyncLoggerTest, ConcurrentProducersLoseNothingWhenBlocking) {
+    Logger::AsyncConfig config;
+    config.buffer_capacity = 64;
+    config.batch_size = 16;
+    config.overflow_policy = Logger::OverflowPolicy::BLOCK;
+    logger().enableAsyncLogging(config);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                logger().info("message");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger().disableAsyncLogging();
+
+    EXPECT_EQ(countLines(), 8000u);
+}
+
+TEST_F(AsyncLoggerTest, CountPolicyReportsDroppedRecords) {
+    Logger::AsyncConfig config;
+    config.buffer_capacity = 2;
+    config.batch_size = 1;
+    config.overflow_policy = Logger::OverflowPolicy::COUNT;
+
+    // A slow handler keeps the writer busy so the tiny buffer overflows
+    static std::once_flag handler_registered;
+    std::call_once(handler_registered, [] {
+        logger().addHandler([](LogLevel, const std::string&) {
+            if (slow_handler_enabled.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    });
+    slow_handler_enabled = true;
+
+    uint64_t before = logger().getDroppedCount();
+    logger().enableAsyncLogging(config);
+    for (int i = 0; i < 200; ++i) {
+        logger().info("burst");
+    }
+    logger().flush();
+    slow_handler_enabled = false;
+
+    uint64_t dropped = logger().getDroppedCount() - before;
+    EXPECT_GT(dropped, 0u);
+
+    logger().disableAsyncLogging();
+    std::ifstream in(log_path_);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(contents.find("log records dropped"), std::string::npos);
+}
+
+TEST_F(AsyncLoggerTest, FatalFlushesSynchronously) {
+    Logger::AsyncConfig config;
+    config.flush_interval = std::chrono::milliseconds(10000);
+    logger().enableAsyncLogging(config);
+
+    logger().info("before fatal");
+    logger().fatal("fatal");
+
+    EXPECT_EQ(countLines(), 2u);
+}
+
+TEST_F(AsyncLoggerTest, DisableFallsBackToSynchronousLogging) {
+    logger().enableAsyncLogging();
+    logger().disableAsyncLogging();
+    EXPECT_FALSE(logger().isAsyncLogging());
+
+    logger().info("sync");
+    EXPECT_EQ(countLines(), 1u);
+}
+
+class LevelFilteringTest : public AsyncLoggerTest {
+protected:
+    std::string readLog() const {
+        std::ifstream in(log_path_);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+};
+
+namespace {
+    int evaluations = 0;
+
+    std::string expensiveMessage() {
+        ++evaluations;
+        return "expensive";
+    }
+}
+
+TEST_F(LevelFilteringTest, FormatStringArgumentsAreFormatted) {
+    V8_LOGF_INFO("loaded {} modules in {}ms", 3, 12);
+
+    std::string contents = readLog();
+    EXPECT_NE(contents.find("loaded 3 modules in 12ms"), std::string::npos);
+    EXPECT_NE(contents.find("[INFO]"), std::string::npos);
+}
+
+TEST_F(LevelFilteringTest, DisabledLevelDoesNotEvaluateArguments) {
+    logger().setLevel(LogLevel::WARN);
+    evaluations = 0;
+
+    V8_LOG_INFO(expensiveMessage());
+    V8_LOGF_DEBUG("value {}", expensiveMessage());
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::INFO));
+
+    V8_LOGF_WARN("value {}", expensiveMessage());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(countLines(), 1u);
+}
+
+TEST_F(LevelFilteringTest, CompileTimeMinimumStripsLowerLevels) {
+    logger().setLevel(LogLevel::TRACE);
+    evaluations = 0;
+
+    V8_LOGF_TRACE("value {}", expensiveMessage());
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_EQ(countLines(), 0u);
+
+    V8_LOGF_DEBUG("value {}", expensiveMessage());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(countLines(), 1u);
+}
@@ -0,0 +1,174 @@
+#include "V8Compat.h"
+#include "../TestUtils.h"
+#include "V8Integration/Security.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+using namespace v8_integration;
+
+class AccountingAllocatorTest : public ::testing::Test {};
+
+TEST_F(AccountingAllocatorTest, TracksLiveBytes) {
+    AccountingArrayBufferAllocator allocator;
+    void* a = allocator.Allocate(1024);
+    void* b = allocator.AllocateUninitialized(4096);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(static_cast<unsigned char*>(a)[1023], 0);
+    EXPECT_EQ(allocator.getAllocated(), 5120u);
+
+    allocator.Free(a, 1024);
+    allocator.Free(b, 4096);
+    EXPECT_EQ(allocator.getAllocated(), 0u);
+}
+
+TEST_F(AccountingAllocatorTest, RefusesAllocationsPastLimit) {
+    AccountingArrayBufferAllocator allocator(8192);
+    void* a = allocator.Allocate(6000);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(allocator.Allocate(4000), nullptr);
+    EXPECT_EQ(allocator.getRejected(), 1u);
+    EXPECT_EQ(allocator.getAllocated(), 6000u);
+
+    allocator.Free(a, 6000);
+    void* b = allocator.Allocate(8192);
+    EXPECT_NE(b, nullptr);
+    allocator.Free(b, 8192);
+}
+
+TEST_F(AccountingAllocatorTest, ConcurrentAllocationsNeverOvershoot) {
+    AccountingArrayBufferAllocator allocator(64 * 1024);
+    std::atomic<size_t> peak{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                void* data = allocator.Allocate(4096);
+                size_t now = allocator.getAllocated();
+                size_t seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                if (data) {
+                    allocator.Free(data, 4096);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(peak.load(), 64u * 1024u);
+    EXPECT_EQ(allocator.getAllocated(), 0u);
+}
+
+class MemoryPolicyTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<v8::Platform> platform;
+    v8::Isolate* isolate = nullptr;
+
+    static void SetUpTestSuite() {
+        v8::V8::InitializeICUDefaultLocation(".");
+        v8::V8::InitializeExternalStartupData(".");
+        platform = v8_compat::CreateDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    static void TearDownTestSuite() {
+        v8::V8::Dispose();
+        v8::V8::DisposePlatform();
+    }
+
+    void TearDown() override {
+        if (isolate) {
+            ResourceLimiter::getInstance().removeMemoryPolicy(isolate);
+            isolate->Dispose();
+        }
+    }
+
+    static bool run(v8::Isolate* isolate, v8::Local<v8::Context> context, const char* code) {
+        v8::TryCatch try_catch(isolate);
+        v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, code).ToLocalChecked();
+        v8::Local<v8::Script> script;
+        return v8::Script::Compile(context, source).ToLocal(&script) && !script->Run(context).IsEmpty();
+    }
+
+    static constexpr const char* kLeak = "const keep = []; while (true) keep.push(new Array(10000).fill(1));";
+};
+
+std::unique_ptr<v8::Platform> MemoryPolicyTest::platform;
+
+TEST_F(MemoryPolicyTest, HeapLimitTerminatesAndIsolateRecovers) {
+    ResourceLimiter::MemoryPolicy policy;
+    policy.heap_limit = 32 * 1024 * 1024;
+    isolate = ResourceLimiter::getInstance().createIsolate(policy);
+    ASSERT_NE(isolate, nullptr);
+
+    v8_test::V8TestEnvironment env(isolate);
+    EXPECT_FALSE(run(isolate, env.context, kLeak));
+    EXPECT_TRUE(ResourceLimiter::getInstance().recoverFromMemoryTermination(isolate));
+    EXPECT_FALSE(ResourceLimiter::getInstance().recoverFromMemoryTermination(isolate));
+
+    auto stats = ResourceLimiter::getInstance().getMemoryStats(isolate);
+    EXPECT_GE(stats.near_limit_events, 1u);
+    EXPECT_EQ(stats.terminations, 1u);
+    EXPECT_TRUE(run(isolate, env.context, "1 + 1"));
+}
+
+TEST_F(MemoryPolicyTest, GrowOnceGrantsOneGracePeriod) {
+    std::vector<ResourceLimiter::MemoryLimitAction> actions;
+    ResourceLimiter::MemoryPolicy policy;
+    policy.heap_limit = 32 * 1024 * 1024;
+    policy.action = ResourceLimiter::MemoryLimitAction::GROW_ONCE;
+    policy.on_limit = [&actions](v8::Isolate*, const ResourceLimiter::MemoryEvent& event) {
+        actions.push_back(event.action_taken);
+    };
+    isolate = ResourceLimiter::getInstance().createIsolate(policy);
+
+    v8_test::V8TestEnvironment env(isolate);
+    EXPECT_FALSE(run(isolate, env.context, kLeak));
+    EXPECT_TRUE(ResourceLimiter::getInstance().recoverFromMemoryTermination(isolate));
+
+    ASSERT_GE(actions.size(), 2u);
+    EXPECT_EQ(actions[0], ResourceLimiter::MemoryLimitAction::GROW_ONCE);
+    EXPECT_EQ(actions[1], ResourceLimiter::MemoryLimitAction::TERMINATE);
+}
+
+TEST_F(MemoryPolicyTest, SnapshotIsWrittenBeforeTerminating) {
+    std::string snapshot_path;
+    ResourceLimiter::MemoryPolicy policy;
+    policy.heap_limit = 32 * 1024 * 1024;
+    policy.action = ResourceLimiter::MemoryLimitAction::SNAPSHOT_AND_TERMINATE;
+    policy.snapshot_directory = "/tmp";
+    policy.on_limit = [&snapshot_path](v8::Isolate*, const ResourceLimiter::MemoryEvent& event) {
+        snapshot_path = event.snapshot_path;
+    };
+    isolate = ResourceLimiter::getInstance().createIsolate(policy);
+
+    v8_test::V8TestEnvironment env(isolate);
+    EXPECT_FALSE(run(isolate, env.context, kLeak));
+    EXPECT_TRUE(ResourceLimiter::getInstance().recoverFromMemoryTermination(isolate));
+
+    ASSERT_FALSE(snapshot_path.empty());
+    EXPECT_EQ(std::remove(snapshot_path.c_str()), 0);
+}
+
+TEST_F(MemoryPolicyTest, ArrayBufferLimitThrowsRangeError) {
+    ResourceLimiter::MemoryPolicy policy;
+    policy.array_buffer_limit = 1024 * 1024;
+    isolate = ResourceLimiter::getInstance().createIsolate(policy);
+
+    v8_test::V8TestEnvironment env(isolate);
+    EXPECT_TRUE(run(isolate, env.context, "globalThis.small = new ArrayBuffer(512 * 1024)"));
+    EXPECT_FALSE(run(isolate, env.context, "new ArrayBuffer(2 * 1024 * 1024)"));
+
+    auto stats = ResourceLimiter::getInstance().getMemoryStats(isolate);
+    EXPECT_GE(stats.array_buffer_used, 512u * 1024u);
+    EXPECT_EQ(stats.array_buffer_rejected, 1u);
+    EXPECT_EQ(stats.terminations, 0u);
+}
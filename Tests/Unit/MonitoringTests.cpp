@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "V8Integration/Monitoring.h"
+#include <chrono>
+#include <thread>
+
+using namespace v8_integration;
+
+class TracingSamplingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // TracingManager is a singleton, so start every test from a clean slate
+        tracing().setSamplingConfig(TracingManager::SamplingConfig{});
+        tracing().clearTraces();
+    }
+
+    void TearDown() override {
+        tracing().setSamplingConfig(TracingManager::SamplingConfig{});
+        tracing().clearTraces();
+    }
+
+    static TracingManager& tracing() { return TracingManager::getInstance(); }
+};
+
+TEST_F(TracingSamplingTest, DefaultConfigKeepsEveryTrace) {
+    std::string trace_id = tracing().startTrace("request");
+    std::string span_id = tracing().startSpan(trace_id, "child");
+    EXPECT_FALSE(span_id.empty());
+    tracing().finishSpan(trace_id, span_id);
+    tracing().finishTrace(trace_id);
+
+    EXPECT_EQ(tracing().getTraceSpans(trace_id).size(), 2u);
+}
+
+TEST_F(TracingSamplingTest, ZeroHeadRateWithoutTailDropsAtStart) {
+    TracingManager::SamplingConfig config;
+    config.head_sample_rate = 0.0;
+    config.keep_error_traces = false;
+    tracing().setSamplingConfig(config);
+
+    auto before = tracing().getSamplingStats();
+    std::string trace_id = tracing().startTrace("request");
+
+    EXPECT_FALSE(trace_id.empty());
+    EXPECT_TRUE(tracing().startSpan(trace_id, "child").empty());
+    EXPECT_TRUE(tracing().getTraceSpans(trace_id).empty());
+    EXPECT_EQ(tracing().getSamplingStats().dropped, before.dropped + 1);
+}
+
+TEST_F(TracingSamplingTest, TailSamplingKeepsErrorTraces) {
+    TracingManager::SamplingConfig config;
+    config.head_sample_rate = 0.0;
+    config.keep_error_traces = true;
+    tracing().setSamplingConfig(config);
+
+    std::string ok_trace = tracing().startTrace("ok");
+    tracing().finishTrace(ok_trace);
+    EXPECT_TRUE(tracing().getTraceSpans(ok_trace).empty());
+
+    std::string bad_trace = tracing().startTrace("bad");
+    std::string span_id = tracing().startSpan(bad_trace, "db");
+    tracing().addTag(bad_trace, span_id, "error", "true");
+    tracing().finishSpan(bad_trace, span_id);
+    tracing().finishTrace(bad_trace);
+    EXPECT_EQ(tracing().getTraceSpans(bad_trace).size(), 2u);
+}
+
+TEST_F(TracingSamplingTest, TailSamplingKeepsSlowTraces) {
+    TracingManager::SamplingConfig config;
+    config.head_sample_rate = 0.0;
+    config.keep_error_traces = false;
+    config.latency_threshold = std::chrono::milliseconds(20);
+    tracing().setSamplingConfig(config);
+
+    std::string fast_trace = tracing().startTrace("fast");
+    tracing().finishTrace(fast_trace);
+    EXPECT_TRUE(tracing().getTraceSpans(fast_trace).empty());
+
+    std::string slow_trace = tracing().startTrace("slow");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    tracing().finishTrace(slow_trace);
+    EXPECT_EQ(tracing().getTraceSpans(slow_trace).size(), 1u);
+}
+
+TEST_F(TracingSamplingTest, PartialHeadRateSamplesProportionally) {
+    TracingManager::SamplingConfig config;
+    config.head_sample_rate = 0.25;
+    config.keep_error_traces = false;
+    tracing().setSamplingConfig(config);
+
+    auto before = tracing().getSamplingStats();
+    for (int i = 0; i < 4000; ++i) {
+        tracing().finishTrace(tracing().startTrace("op"));
+    }
+    auto after = tracing().getSamplingStats();
+
+    uint64_t sampled = after.head_sampled - before.head_sampled;
+    EXPECT_GT(sampled, 800u);
+    EXPECT_LT(sampled, 1200u);
+    EXPECT_EQ(tracing().getTraceCount(), sampled);
+}
+
+TEST_F(TracingSamplingTest, RetentionEvictsFinishedTraces) {
+    TracingManager::SamplingConfig config;
+    config.retention = std::chrono::seconds(1);
+    tracing().setSamplingConfig(config);
+
+    std::string trace_id = tracing().startTrace("request");
+    tracing().finishTrace(trace_id);
+    EXPECT_EQ(tracing().evictExpiredTraces(), 0u);
+    EXPECT_EQ(tracing().getTraceCount(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_EQ(tracing().evictExpiredTraces(), 1u);
+    EXPECT_TRUE(tracing().getTraceSpans(trace_id).empty());
+}
@@ -0,0 +1,208 @@
+#include "V8Compat.h"
+#include "../TestUtils.h"
+#include "V8Integration/Security.h"
+#include "V8Integration/Monitoring.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+using namespace v8_integration;
+using namespace std::chrono_literals;
+
+namespace {
+    // Spins until this thread has used `amount` of CPU time
+    void burnCpu(std::chrono::nanoseconds amount) {
+        auto end = SandboxScheduler::threadCpuTime() + amount;
+        while (SandboxScheduler::threadCpuTime() < end) {}
+    }
+}
+
+class SandboxSchedulerTest : public ::testing::Test {};
+
+TEST_F(SandboxSchedulerTest, ThreadCpuTimeIgnoresSleeping) {
+    auto start = SandboxScheduler::threadCpuTime();
+    std::this_thread::sleep_for(50ms);
+    EXPECT_LT(SandboxScheduler::threadCpuTime() - start, 20ms);
+
+    burnCpu(5ms);
+    EXPECT_GE(SandboxScheduler::threadCpuTime() - start, 5ms);
+}
+
+TEST_F(SandboxSchedulerTest, SharesFollowWeights) {
+    SandboxScheduler scheduler;
+    scheduler.configure("heavy", {3.0, 0ns, 1000ms});
+    scheduler.configure("light", {1.0, 0ns, 1000ms});
+
+    std::vector<std::string> order;
+    for (int i = 0; i < 40; ++i) {
+        scheduler.enqueue("heavy", [&order] { burnCpu(1ms); order.push_back("heavy"); });
+        scheduler.enqueue("light", [&order] { burnCpu(1ms); order.push_back("light"); });
+    }
+
+    EXPECT_EQ(scheduler.runPending(40), 40u);
+    size_t heavy = std::count(order.begin(), order.end(), "heavy");
+    EXPECT_GE(heavy, 27u);
+    EXPECT_LE(heavy, 33u);
+    EXPECT_EQ(scheduler.pendingCount(), 40u);
+}
+
+TEST_F(SandboxSchedulerTest, NoisyTenantIsThrottledOthersKeepRunning) {
+    SandboxScheduler scheduler;
+    scheduler.configure("noisy", {1.0, 6ms, 10000ms});
+    scheduler.configure("quiet", {1.0, 0ns, 1000ms});
+
+    int noisy_runs = 0;
+    int quiet_runs = 0;
+    for (int i = 0; i < 20; ++i) {
+        scheduler.enqueue("noisy", [&noisy_runs] { burnCpu(2ms); ++noisy_runs; });
+        scheduler.enqueue("quiet", [&quiet_runs] { burnCpu(100us); ++quiet_runs; });
+    }
+
+    scheduler.runPending();
+    EXPECT_EQ(quiet_runs, 20);
+    EXPECT_LE(noisy_runs, 4);
+    EXPECT_TRUE(scheduler.throttle("noisy"));
+    EXPECT_FALSE(scheduler.throttle("quiet"));
+
+    auto usage = scheduler.getUsage("noisy");
+    EXPECT_GE(usage.window, 6ms);
+    EXPECT_EQ(usage.queued, static_cast<size_t>(20 - noisy_runs));
+    EXPECT_GE(usage.throttled, 2u);
+}
+
+TEST_F(SandboxSchedulerTest, QuotaRecoversAsWindowSlides) {
+    SandboxScheduler scheduler;
+    scheduler.configure("tenant", {1.0, 2ms, 100ms});
+    scheduler.charge("tenant", 5ms);
+    EXPECT_TRUE(scheduler.throttle("tenant"));
+
+    std::this_thread::sleep_for(150ms);
+    EXPECT_FALSE(scheduler.throttle("tenant"));
+    EXPECT_EQ(scheduler.getUsage("tenant").total, 5ms);
+}
+
+TEST_F(SandboxSchedulerTest, UnknownTenantsAreNotCreated) {
+    SandboxScheduler scheduler;
+    scheduler.configure("tenant", {1.0, 0ns, 1000ms});
+    scheduler.remove("tenant");
+
+    // A late charge or task for a removed sandbox must not resurrect it
+    scheduler.charge("tenant", 5ms);
+    bool ran = false;
+    EXPECT_FALSE(scheduler.enqueue("tenant", [&ran] { ran = true; }));
+    EXPECT_EQ(scheduler.pendingCount(), 0u);
+    EXPECT_EQ(scheduler.runPending(), 0u);
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(scheduler.getUsage("tenant").executions, 0u);
+}
+
+TEST_F(SandboxSchedulerTest, IdleTenantDoesNotBankCredit) {
+    SandboxScheduler scheduler;
+    scheduler.configure("busy", {1.0, 0ns, 1000ms});
+    scheduler.configure("late", {1.0, 0ns, 1000ms});
+    for (int i = 0; i < 10; ++i) {
+        scheduler.enqueue("busy", [] { burnCpu(1ms); });
+    }
+    scheduler.runPending();
+
+    std::vector<std::string> order;
+    for (int i = 0; i < 4; ++i) {
+        scheduler.enqueue("busy", [&order] { burnCpu(1ms); order.push_back("busy"); });
+        scheduler.enqueue("late", [&order] { burnCpu(1ms); order.push_back("late"); });
+    }
+    scheduler.runPending();
+
+    // Without the catch-up the late tenant would run all four first
+    std::vector<std::string> first_four(order.begin(), order.begin() + 4);
+    EXPECT_GE(std::count(first_four.begin(), first_four.end(), "busy"), 1);
+}
+
+TEST_F(SandboxSchedulerTest, PublishesLabelledMetrics) {
+    SandboxScheduler scheduler;
+    scheduler.charge("metrics_a", 3ms);
+    scheduler.charge("metrics_b", 1ms);
+    scheduler.publishMetrics();
+
+    std::map<std::string, double> cpu;
+    for (const auto& metric : MetricsCollector::getInstance().getAllMetrics()) {
+        if (metric.name == "v8_sandbox_cpu_seconds") {
+            cpu[metric.labels.at("sandbox")] = metric.value;
+        }
+    }
+    EXPECT_DOUBLE_EQ(cpu["metrics_a"], 0.003);
+    EXPECT_DOUBLE_EQ(cpu["metrics_b"], 0.001);
+}
+
+class SandboxCpuQuotaTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<v8::Platform> platform;
+    v8::Isolate* isolate = nullptr;
+
+    static void SetUpTestSuite() {
+        v8::V8::InitializeICUDefaultLocation(".");
+        v8::V8::InitializeExternalStartupData(".");
+        platform = v8_compat::CreateDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    static void TearDownTestSuite() {
+        v8::V8::Dispose();
+        v8::V8::DisposePlatform();
+    }
+
+    void SetUp() override {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        isolate = v8::Isolate::New(create_params);
+    }
+
+    void TearDown() override {
+        SandboxManager::getInstance().removeSandbox("noisy");
+        SandboxManager::getInstance().removeSandbox("quiet");
+        SandboxManager::getInstance().releaseTemplates(isolate);
+        isolate->Dispose();
+    }
+};
+
+std::unique_ptr<v8::Platform> SandboxCpuQuotaTest::platform;
+
+TEST_F(SandboxCpuQuotaTest, OverQuotaSandboxIsRefusedAndQueuedRunsWait) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+
+    SandboxConfig noisy;
+    noisy.cpu_quota = 5ms;
+    noisy.cpu_window = 10000ms;
+    ASSERT_TRUE(manager.createSandbox(isolate, "noisy", noisy));
+    ASSERT_TRUE(manager.createSandbox(isolate, "quiet", SandboxConfig{}));
+
+    const char* spin = "let n = 0; const end = Date.now() + 10; while (Date.now() < end) n++; n";
+    v8::Local<v8::Value> result;
+    EXPECT_TRUE(manager.executeSandboxed(isolate, "noisy", spin, result));
+    EXPECT_GE(manager.getCpuUsage("noisy").total, 5ms);
+
+    ErrorInfo error(ErrorCode::SUCCESS, "");
+    EXPECT_FALSE(manager.executeSandboxed(isolate, "noisy", "1", result, &error));
+    EXPECT_EQ(error.code, ErrorCode::CPU_QUOTA_EXCEEDED);
+
+    int completed = 0;
+    manager.enqueueSandboxed(isolate, "noisy", "1", [&completed](bool, v8::Local<v8::Value>, const ErrorInfo&) {
+        ++completed;
+    });
+    manager.enqueueSandboxed(isolate, "quiet", "6 * 7", [&completed, this](bool ok, v8::Local<v8::Value> value,
+                                                                           const ErrorInfo&) {
+        EXPECT_TRUE(ok);
+        EXPECT_EQ(value->Int32Value(isolate->GetCurrentContext()).FromJust(), 42);
+        ++completed;
+    });
+
+    EXPECT_EQ(manager.runQueued(), 1u);
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(manager.getCpuUsage("noisy").queued, 1u);
+}
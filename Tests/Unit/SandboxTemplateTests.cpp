@@ -0,0 +1,190 @@
+#include "V8Compat.h"
+#include "../TestUtils.h"
+#include "V8Integration/Security.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+using namespace v8_integration;
+
+class SandboxTemplateTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<v8::Platform> platform;
+    v8::Isolate* isolate = nullptr;
+
+    static void SetUpTestSuite() {
+        v8::V8::InitializeICUDefaultLocation(".");
+        v8::V8::InitializeExternalStartupData(".");
+        platform = v8_compat::CreateDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    static void TearDownTestSuite() {
+        v8::V8::Dispose();
+        v8::V8::DisposePlatform();
+    }
+
+    void SetUp() override {
+        v8::Isolate::CreateParams create_params;
+        create_params.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        isolate = v8::Isolate::New(create_params);
+    }
+
+    void TearDown() override {
+        for (const auto& name : SandboxManager::getInstance().listSandboxes()) {
+            SandboxManager::getInstance().removeSandbox(name);
+        }
+        SandboxManager::getInstance().releaseTemplates(isolate);
+        isolate->Dispose();
+    }
+
+    std::string evaluate(const std::string& sandbox, const std::string& code) {
+        v8::Local<v8::Value> result;
+        if (!SandboxManager::getInstance().executeSandboxed(isolate, sandbox, code, result)) {
+            return "<error>";
+        }
+        v8::String::Utf8Value text(isolate, result);
+        return *text;
+    }
+};
+
+std::unique_ptr<v8::Platform> SandboxTemplateTest::platform;
+
+TEST_F(SandboxTemplateTest, TemplateAppliesRestrictionsAndAllowedGlobals) {
+    v8_test::V8TestEnvironment env(isolate);
+    SandboxConfig config;
+    config.allowed_globals["tenant"] = "acme";
+    SandboxManager::getInstance().registerTemplate("restricted", config);
+    ASSERT_TRUE(SandboxManager::getInstance().hasTemplate("restricted"));
+
+    ASSERT_TRUE(SandboxManager::getInstance().createSandboxFromTemplate(isolate, "a", "restricted"));
+    EXPECT_EQ(evaluate("a", "typeof eval + ',' + typeof Function + ',' + typeof require"),
+              "undefined,undefined,undefined");
+    EXPECT_EQ(evaluate("a", "tenant"), "acme");
+    EXPECT_EQ(evaluate("a", "[1, 2, 3].map(x => x * 2).join()"), "2,4,6");
+
+    // Code generation from strings stays off even through other paths
+    EXPECT_EQ(evaluate("a", "(function(){}).constructor('return 1')()"), "<error>");
+}
+
+TEST_F(SandboxTemplateTest, SandboxesFromOneTemplateDoNotShareState) {
+    v8_test::V8TestEnvironment env(isolate);
+    SandboxManager::getInstance().registerTemplate("shared", SandboxConfig{});
+
+    ASSERT_TRUE(SandboxManager::getInstance().createSandboxFromTemplate(isolate, "first", "shared"));
+    ASSERT_TRUE(SandboxManager::getInstance().createSandboxFromTemplate(isolate, "second", "shared"));
+    EXPECT_EQ(evaluate("first", "globalThis.counter = 5; counter"), "5");
+    EXPECT_EQ(evaluate("second", "typeof counter"), "undefined");
+}
+
+TEST_F(SandboxTemplateTest, UnknownTemplateFails) {
+    v8_test::V8TestEnvironment env(isolate);
+    EXPECT_FALSE(SandboxManager::getInstance().createSandboxFromTemplate(isolate, "x", "missing"));
+    EXPECT_FALSE(SandboxManager::getInstance().hasSandbox("x"));
+}
+
+TEST_F(SandboxTemplateTest, PlainCreateSandboxKeepsItsBehaviour) {
+    v8_test::V8TestEnvironment env(isolate);
+    SandboxConfig open;
+    open.remove_dangerous_globals = false;
+    open.disable_code_generation = false;
+    ASSERT_TRUE(SandboxManager::getInstance().createSandbox(isolate, "open", open));
+    ASSERT_TRUE(SandboxManager::getInstance().createSandbox(isolate, "closed", SandboxConfig{}));
+
+    EXPECT_EQ(evaluate("open", "eval('20 + 22')"), "42");
+    EXPECT_EQ(evaluate("closed", "typeof eval"), "undefined");
+}
+
+TEST_F(SandboxTemplateTest, RepeatedScriptsAreCompiledOnce) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+    manager.clearScriptCache();
+    ASSERT_TRUE(manager.createSandbox(isolate, "a", SandboxConfig{}));
+    ASSERT_TRUE(manager.createSandbox(isolate, "b", SandboxConfig{}));
+
+    auto before = manager.getScriptCacheStats();
+    const std::string handler = "globalThis.calls = (globalThis.calls || 0) + 1; calls";
+    EXPECT_EQ(evaluate("a", handler), "1");
+    EXPECT_EQ(evaluate("a", handler), "2");
+    EXPECT_EQ(evaluate("b", handler), "1");  // same script, bound to b's own global
+
+    auto after = manager.getScriptCacheStats();
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.hits - before.hits, 2u);
+    EXPECT_EQ(after.entries, 1u);
+}
+
+TEST_F(SandboxTemplateTest, CompileErrorsAreNotCached) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+    manager.clearScriptCache();
+    ASSERT_TRUE(manager.createSandbox(isolate, "a", SandboxConfig{}));
+
+    EXPECT_EQ(evaluate("a", "let = ;"), "<error>");
+    EXPECT_EQ(evaluate("a", "let = ;"), "<error>");
+    EXPECT_EQ(manager.getScriptCacheStats().entries, 0u);
+}
+
+TEST_F(SandboxTemplateTest, TemplatesAndScriptsOutliveTheLastSandbox) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+    manager.clearScriptCache();
+    SandboxConfig config;
+    config.allowed_globals["tenant"] = "acme";
+    ASSERT_TRUE(manager.createSandbox(isolate, "a", config));
+    EXPECT_EQ(evaluate("a", "tenant"), "acme");
+    manager.removeSandbox("a");
+    EXPECT_EQ(manager.getScriptCacheStats().entries, 1u);
+    
+    ASSERT_TRUE(manager.createSandbox(isolate, "b", config));
+    auto before = manager.getScriptCacheStats();
+    EXPECT_EQ(evaluate("b", "tenant"), "acme");
+    EXPECT_EQ(manager.getScriptCacheStats().hits - before.hits, 1u);
+    
+    manager.releaseTemplates(isolate);
+    ASSERT_TRUE(manager.createSandbox(isolate, "c", config));
+    EXPECT_EQ(evaluate("c", "tenant"), "acme");
+    manager.releaseTemplates(isolate);
+    EXPECT_EQ(manager.getScriptCacheStats().entries, 0u);
+}
+
+TEST_F(SandboxTemplateTest, ValidatedScriptIsNotCompiledAgain) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+    auto& validator = CodeValidator::getInstance();
+    manager.clearScriptCache();
+    ASSERT_TRUE(manager.createSandbox(isolate, "a", SandboxConfig{}));
+    
+    const std::string handler = "[1, 2, 3].map(x => x * 2).join()";
+    validator.setValidationMode(CodeValidator::ValidationMode::PARSE);
+    EXPECT_TRUE(validator.validateScript(isolate, env.context, handler));
+    validator.setValidationMode(CodeValidator::ValidationMode::PATTERN);
+    EXPECT_EQ(manager.getScriptCacheStats().entries, 1u);
+    
+    auto before = manager.getScriptCacheStats();
+    EXPECT_EQ(evaluate("a", handler), "2,4,6");
+    auto after = manager.getScriptCacheStats();
+    EXPECT_EQ(after.hits - before.hits, 1u);
+    EXPECT_EQ(after.misses - before.misses, 0u);
+}
+
+TEST_F(SandboxTemplateTest, ScriptCacheStaysWithinBudget) {
+    v8_test::V8TestEnvironment env(isolate);
+    auto& manager = SandboxManager::getInstance();
+    manager.clearScriptCache();
+    auto original = manager.getScriptCacheStats().budget;
+    manager.setScriptCacheBudget(4096);
+    ASSERT_TRUE(manager.createSandbox(isolate, "a", SandboxConfig{}));
+
+    auto before = manager.getScriptCacheStats();
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(evaluate("a", std::to_string(i) + " + 0 /* padding padding padding */"), std::to_string(i));
+    }
+    auto after = manager.getScriptCacheStats();
+    EXPECT_LE(after.bytes, 4096u);
+    EXPECT_GT(after.evictions - before.evictions, 0u);
+
+    manager.setScriptCacheBudget(original);
+}
@@ -0,0 +1,157 @@
+#include "V8Compat.h"
+#include "V8Integration/Security.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <libplatform/libplatform.h>
+#include <v8.h>
+
+using namespace v8_integration;
+using namespace std::chrono_literals;
+
+class TenantIsolatePoolTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<v8::Platform> platform;
+
+    static void SetUpTestSuite() {
+        v8::V8::InitializeICUDefaultLocation(".");
+        v8::V8::InitializeExternalStartupData(".");
+        platform = v8_compat::CreateDefaultPlatform();
+        v8::V8::InitializePlatform(platform.get());
+        v8::V8::Initialize();
+    }
+
+    static void TearDownTestSuite() {
+        TenantIsolatePool::getInstance().shutdown();
+        v8::V8::Dispose();
+        v8::V8::DisposePlatform();
+    }
+
+    void SetUp() override {
+        pool().configure(TenantIsolatePool::Config{});
+    }
+
+    void TearDown() override {
+        for (const char* tenant : {"alpha", "beta", "gamma", "hungry"}) {
+            pool().removeTenant(tenant);
+        }
+    }
+
+    static TenantIsolatePool& pool() { return TenantIsolatePool::getInstance(); }
+
+    static TenantIsolatePool::ExecutionResult run(const std::string& tenant, const std::string& code) {
+        return pool().execute(tenant, code).get();
+    }
+};
+
+std::unique_ptr<v8::Platform> TenantIsolatePoolTest::platform;
+
+TEST_F(TenantIsolatePoolTest, TenantStateLivesInItsOwnIsolate) {
+    pool().registerTenant("alpha", {});
+    pool().registerTenant("beta", {});
+
+    EXPECT_EQ(run("alpha", "globalThis.hits = 1; hits").value, "1");
+    EXPECT_EQ(run("alpha", "++hits").value, "2");
+    EXPECT_EQ(run("beta", "typeof hits").value, "undefined");
+    EXPECT_EQ(run("beta", "({ tenant: 'beta', list: [1, 2] })").value, R"({"tenant":"beta","list":[1,2]})");
+
+    auto stats = pool().getStats();
+    EXPECT_EQ(stats.live, 2u);
+}
+
+TEST_F(TenantIsolatePoolTest, UnknownTenantAndScriptErrorsAreReported) {
+    auto missing = run("nobody", "1");
+    EXPECT_FALSE(missing.ok);
+    EXPECT_EQ(missing.error.code, ErrorCode::EXECUTION_FAILED);
+
+    pool().registerTenant("alpha", {});
+    auto thrown = run("alpha", "throw new RangeError('bad')");
+    EXPECT_FALSE(thrown.ok);
+    EXPECT_EQ(thrown.error.code, ErrorCode::RANGE_ERROR);
+    EXPECT_TRUE(run("alpha", "1").ok);
+}
+
+TEST_F(TenantIsolatePoolTest, LeastRecentlyUsedIdleTenantIsReclaimed) {
+    TenantIsolatePool::Config config;
+    config.max_isolates = 2;
+    pool().configure(config);
+    for (const char* tenant : {"alpha", "beta", "gamma"}) {
+        pool().registerTenant(tenant, {});
+    }
+
+    run("alpha", "globalThis.mark = 'a'");
+    run("beta", "1");
+    run("alpha", "1");  // beta is now the least recently used
+    auto before = pool().getStats();
+    run("gamma", "1");
+
+    auto after = pool().getStats();
+    EXPECT_EQ(after.live, 2u);
+    EXPECT_EQ(after.reclaimed - before.reclaimed, 1u);
+    EXPECT_EQ(run("alpha", "mark").value, "a");
+
+    // beta comes back in a fresh isolate
+    auto created = pool().getStats().created;
+    EXPECT_TRUE(run("beta", "1").ok);
+    EXPECT_EQ(pool().getStats().created, created + 1);
+}
+
+TEST_F(TenantIsolatePoolTest, IdleIsolatesAreParkedAndResume) {
+    TenantIsolatePool::Config config;
+    config.idle_timeout = 20ms;
+    pool().configure(config);
+    pool().registerTenant("alpha", {});
+
+    run("alpha", "globalThis.kept = 42");
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(pool().getStats().parked, 1u);
+
+    EXPECT_EQ(run("alpha", "kept").value, "42");
+    EXPECT_EQ(pool().getStats().parked, 0u);
+}
+
+TEST_F(TenantIsolatePoolTest, NewIdleTimeoutReachesLiveIsolates) {
+    pool().registerTenant("alpha", {});
+    run("alpha", "1");
+
+    TenantIsolatePool::Config config;
+    config.idle_timeout = 20ms;
+    pool().configure(config);
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(pool().getStats().parked, 1u);
+}
+
+TEST_F(TenantIsolatePoolTest, HeapLimitOfOneTenantDoesNotAffectOthers) {
+    TenantIsolatePool::TenantConfig hungry;
+    hungry.memory.heap_limit = 32 * 1024 * 1024;
+    pool().registerTenant("hungry", hungry);
+    pool().registerTenant("alpha", {});
+
+    auto leak = pool().execute("hungry", "const keep = []; while (true) keep.push(new Array(10000).fill(1));");
+    auto calm = pool().execute("alpha", "[1, 2, 3].reduce((a, b) => a + b)");
+
+    EXPECT_EQ(calm.get().value, "6");
+    auto result = leak.get();
+    EXPECT_FALSE(result.ok);
+    EXPECT_EQ(result.error.code, ErrorCode::MEMORY_ERROR);
+    EXPECT_TRUE(run("hungry", "'recovered'").ok);
+}
+
+TEST_F(TenantIsolatePoolTest, ConcurrentCallersAreRoutedPerTenant) {
+    pool().registerTenant("alpha", {});
+    pool().registerTenant("beta", {});
+
+    std::vector<std::future<TenantIsolatePool::ExecutionResult>> results;
+    for (int i = 0; i < 100; ++i) {
+        const char* tenant = i % 2 ? "alpha" : "beta";
+        results.push_back(pool().execute(tenant, "globalThis.n = (globalThis.n || 0) + 1; n"));
+    }
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get().ok);
+    }
+    EXPECT_EQ(run("alpha", "n").value, "50");
+    EXPECT_EQ(run("beta", "n").value, "50");
+}
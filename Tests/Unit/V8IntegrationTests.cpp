@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "V8Integration.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <optional>
+#include <span>
 #include <thread>
 
 using namespace v8integration;
@@ -419,4 +424,491 @@ TEST_F(V8IntegrationTest, MoveSemantics) {
     result = v8_3.Evaluate("testFunc()");
     EXPECT_TRUE(result.success);
     EXPECT_EQ(result.result, "100");
-}
\ No newline at end of file
+}
+namespace {
+    long long sumTo(uint32_t n) {
+        long long total = 0;
+        for (uint32_t i = 1; i <= n; ++i) total += i;
+        return total;
+    }
+
+    double scale(double value, int factor) { return value * factor; }
+
+    std::string greet(const std::string& name) { return "hello " + name; }
+
+    double sumArray(std::span<const double> values) {
+        double total = 0;
+        for (double v : values) total += v;
+        return total;
+    }
+
+    void doubleInPlace(std::span<int32_t> values) {
+        for (auto& v : values) v *= 2;
+    }
+
+    std::vector<float> ramp(uint32_t n) {
+        std::vector<float> values(n);
+        for (uint32_t i = 0; i < n; ++i) values[i] = static_cast<float>(i) * 0.5f;
+        return values;
+    }
+}
+
+// Test 26: Bind converts arguments and results by signature
+TEST_F(V8IntegrationTest, BindTypedFunctions) {
+    v8_->Bind("sumTo", &sumTo);
+    v8_->Bind<&scale>("scale");
+    v8_->Bind<&greet>("greet");
+    
+    EXPECT_EQ(v8_->Evaluate("sumTo(100)").result, "5050");
+    EXPECT_EQ(v8_->Evaluate("scale(1.5, 4)").result, "6");
+    EXPECT_EQ(v8_->Evaluate("greet('v8')").result, "hello v8");
+}
+
+// Test 27: Bind reports bad arguments as JavaScript exceptions
+TEST_F(V8IntegrationTest, BindRejectsBadArguments) {
+    v8_->Bind<&sumTo>("sumTo");
+    
+    auto result = v8_->Evaluate("sumTo()");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("Wrong number of arguments"), std::string::npos);
+    
+    result = v8_->Evaluate("sumTo('ten')");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("TypeError: Argument 1 must be a number"), std::string::npos);
+    
+    result = v8_->Evaluate("sumTo(-1)");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("RangeError: Argument 1 must be non-negative"), std::string::npos);
+    
+    result = v8_->Evaluate("sumTo(2 ** 40)");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("out of range"), std::string::npos);
+}
+
+// Test 28: Typed arrays bind to spans without copying, vectors return typed arrays
+TEST_F(V8IntegrationTest, BindTypedArrays) {
+    v8_->Bind<&sumArray>("sumArray");
+    v8_->Bind<&doubleInPlace>("doubleInPlace");
+    v8_->Bind<&ramp>("ramp");
+    
+    EXPECT_EQ(v8_->Evaluate("sumArray(new Float64Array([1, 2, 3.5]))").result, "6.5");
+    EXPECT_EQ(v8_->Evaluate("sumArray(new Float64Array(new ArrayBuffer(32), 8, 2).fill(2))").result, "4");
+    EXPECT_EQ(v8_->Evaluate("var a = new Int32Array([1, 2, 3]); doubleInPlace(a); a.join()").result, "2,4,6");
+    EXPECT_EQ(v8_->Evaluate("var r = ramp(3); r instanceof Float32Array && r.join()").result, "0,0.5,1");
+    
+    auto result = v8_->Evaluate("sumArray([1, 2])");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("must be a Float64Array"), std::string::npos);
+}
+
+// Test 29: JSObjectBuilder binds functions the same way
+TEST_F(V8IntegrationTest, JSObjectBuilderBind) {
+    V8Scope scope(*v8_);
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(v8_->GetContext());
+    
+    auto math = JSObjectBuilder(isolate)
+        .Bind("sumTo", &sumTo)
+        .Bind<&scale>("scale")
+        .Build();
+    v8_->GetGlobalObject()->Set(v8_->GetContext(), V8Integration::ToV8String(isolate, "m"), math).Check();
+    
+    EXPECT_EQ(v8_->Evaluate("m.sumTo(4) + m.scale(2, 3)").result, "16");
+}
+
+// Test 30: Scalar and typed-array signatures get a Fast API path
+TEST_F(V8IntegrationTest, BindAttachesFastCalls) {
+    EXPECT_TRUE(binding::kHasFastCall<&sumTo>);
+    EXPECT_TRUE(binding::kHasFastCall<&scale>);
+    EXPECT_FALSE(binding::kHasFastCall<&greet>);
+    EXPECT_EQ(binding::FastFunction<&greet>(), nullptr);
+    
+    v8_->Bind<&sumTo>("sumTo");
+    v8_->Bind<&sumArray>("sumArray");
+    
+    // Hot enough to be optimized; results and errors must match the slow path
+    auto result = v8_->Evaluate(
+        "var a = new Float64Array([0.5, 0.5]); var t = 0;"
+        "for (var i = 0; i < 200000; i++) { t += sumTo(i % 4) + sumArray(a); } t");
+    EXPECT_TRUE(result.success) << result.error;
+    EXPECT_EQ(result.result, "700000");
+    
+    result = v8_->Evaluate("sumTo(-1)");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("must be non-negative"), std::string::npos);
+}
+
+// Test 31: ShapedObjectBuilder fills cached layouts by position
+TEST_F(V8IntegrationTest, ShapedObjectBuilder) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Context::Scope context_scope(context);
+    
+    v8::Local<v8::Array> rows = v8::Array::New(isolate, 3);
+    for (int i = 0; i < 3; ++i) {
+        ShapedObjectBuilder row(isolate, {"id", "name", "score"});
+        rows->Set(context, i, row.Build(i, std::string("row") + std::to_string(i), i * 0.5)).Check();
+    }
+    context->Global()->Set(context, V8Integration::ToV8String(isolate, "rows"), rows).Check();
+    EXPECT_EQ(ShapedObjectBuilder::CachedShapeCount(isolate), 1u);
+    
+    auto result = v8_->Evaluate("JSON.stringify(rows[2])");
+    EXPECT_EQ(result.result, "{\"id\":2,\"name\":\"row2\",\"score\":1}");
+    
+    // Partially filled objects still have every property
+    ShapedObjectBuilder point(isolate, {"x", "y"});
+    auto p = point.New();
+    point.Set(p, 1, v8::Integer::New(isolate, 7));
+    context->Global()->Set(context, V8Integration::ToV8String(isolate, "p"), p).Check();
+    EXPECT_EQ(v8_->Evaluate("Object.keys(p).join() + ':' + p.x + ':' + p.y").result, "x,y:undefined:7");
+    EXPECT_EQ(ShapedObjectBuilder::CachedShapeCount(isolate), 2u);
+    
+    EXPECT_THROW(point.Build(1), V8Exception);
+    EXPECT_THROW(point.Set(p, 2, v8::Integer::New(isolate, 0)), V8Exception);
+    
+    // Layouts are Eternals, freed with the isolate's other caches
+    binding::ReleaseIsolate(isolate);
+    EXPECT_EQ(ShapedObjectBuilder::CachedShapeCount(isolate), 0u);
+}
+
+// Test 32: Vectors move into typed arrays and typed arrays are viewed in place
+TEST_F(V8IntegrationTest, ZeroCopyTypedArrays) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Context::Scope context_scope(context);
+    
+    std::vector<double> samples(1 << 20, 0.25);
+    const double* storage = samples.data();
+    auto array = V8Integration::ToTypedArray(isolate, std::move(samples));
+    ASSERT_TRUE(array->IsFloat64Array());
+    EXPECT_EQ(array->Length(), size_t(1) << 20);
+    
+    // Same storage, viewed back from C++
+    auto view = V8Integration::ViewTypedArray<const double>(array);
+#ifndef V8_ENABLE_SANDBOX
+    EXPECT_EQ(view.data(), storage);
+#else
+    (void)storage;
+#endif
+    EXPECT_EQ(view.size(), size_t(1) << 20);
+    
+    context->Global()->Set(context, V8Integration::ToV8String(isolate, "big"), array).Check();
+    EXPECT_EQ(v8_->Evaluate("big[0] = 2; big[0] + big[(1 << 20) - 1]").result, "2.25");
+    EXPECT_EQ(view[0], 2.0);
+    
+    auto ints = V8Integration::ToTypedArray(isolate, std::vector<int32_t>{1, 2, 3});
+    EXPECT_TRUE(ints->IsInt32Array());
+    EXPECT_TRUE(V8Integration::ViewTypedArray<double>(ints).empty());
+    EXPECT_EQ(V8Integration::ViewTypedArray<int32_t>(ints)[2], 3);
+    
+    EXPECT_EQ(V8Integration::ToTypedArray(isolate, std::vector<float>{})->Length(), 0u);
+    
+    // Written in place, so no copy even with the V8 sandbox enabled
+    binding::TypedArrayBuilder<double> builder(isolate, 1024);
+    std::span<double> out = builder.span();
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = i * 0.5;
+    }
+    auto built = builder.Finish();
+    ASSERT_TRUE(built->IsFloat64Array());
+    EXPECT_EQ(V8Integration::ViewTypedArray<const double>(built).data(), out.data());
+    EXPECT_EQ(V8Integration::ViewTypedArray<const double>(built)[1023], 511.5);
+    
+    EXPECT_EQ(binding::TypedArrayBuilder<int32_t>(isolate, 0).Finish()->Length(), 0u);
+}
+
+// Test 33: Large strings cross as external strings and convert back intact
+TEST_F(V8IntegrationTest, ExternalStrings) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Context::Scope context_scope(context);
+    auto global = context->Global();
+    
+    std::string ascii(1 << 20, 'a');
+    auto one_byte = V8Integration::ToV8String(isolate, std::move(ascii));
+    EXPECT_TRUE(one_byte->IsExternalOneByte());
+    EXPECT_EQ(one_byte->Length(), 1 << 20);
+    
+    // "é" and an astral code point, repeated past the threshold
+    std::string text;
+    for (int i = 0; i < 1000; ++i) text += "caf\xC3\xA9 \xF0\x9F\x98\x80 ";
+    std::string expected = text;
+    auto two_byte = V8Integration::ToV8String(isolate, std::move(text));
+    EXPECT_TRUE(two_byte->IsExternalTwoByte());
+    EXPECT_EQ(V8Integration::V8ToString(isolate, two_byte), expected);
+    global->Set(context, V8Integration::ToV8String(isolate, "doc"), two_byte).Check();
+    EXPECT_EQ(v8_->Evaluate("doc.length + ':' + doc.codePointAt(5).toString(16)").result, "8000:1f600");
+    
+    auto shared = std::make_shared<const std::string>(8192, 'x');
+    auto from_shared = V8Integration::ToV8String(isolate, shared);
+    EXPECT_TRUE(from_shared->IsExternalOneByte());
+    EXPECT_EQ(shared.use_count(), 2);
+    
+    // Short strings are still copied
+    EXPECT_FALSE(V8Integration::ToV8String(isolate, std::string("short"))->IsExternal());
+}
+
+// Test 34: V8ToStringView reuses one buffer and handles non-ASCII one-byte strings
+TEST_F(V8IntegrationTest, V8ToStringView) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Context::Scope context_scope(context);
+    
+    auto eval = [&](const char* code) {
+        auto script = v8::Script::Compile(context, V8Integration::ToV8String(isolate, code)).ToLocalChecked();
+        return script->Run(context).ToLocalChecked();
+    };
+    
+    EXPECT_EQ(V8Integration::V8ToStringView(isolate, eval("'x'.repeat(100)")), std::string(100, 'x'));
+    const char* first = V8Integration::V8ToStringView(isolate, eval("'y'.repeat(50)")).data();
+    EXPECT_EQ(V8Integration::V8ToStringView(isolate, eval("'z'.repeat(60)")).data(), first);
+    
+    // Latin-1 one-byte string must come back as UTF-8
+    EXPECT_EQ(V8Integration::V8ToStringView(isolate, eval("'caf\\u00e9'")), "caf\xC3\xA9");
+    EXPECT_EQ(V8Integration::V8ToString(isolate, eval("[1, 2]")), "1,2");
+    EXPECT_EQ(V8Integration::V8ToString(isolate, eval("undefined")), "undefined");
+    EXPECT_EQ(V8Integration::V8ToString(isolate, eval("Symbol('s')")), "");
+}
+
+namespace {
+    struct LineItem {
+        std::string sku;
+        int32_t quantity = 0;
+    };
+    
+    struct Order {
+        std::string id;
+        double total = 0;
+        std::vector<LineItem> items;
+        std::optional<std::string> note;
+    };
+}
+
+V8_STRUCT(LineItem, sku, quantity)
+V8_STRUCT(Order, id, total, items, note)
+
+namespace {
+    Order applyDiscount(Order order) {
+        order.total *= 0.9;
+        order.note = "discounted";
+        return order;
+    }
+}
+
+// Test 35: Structs marshal to and from objects without JSON
+TEST_F(V8IntegrationTest, StructMarshalling) {
+    v8_->Bind<&applyDiscount>("applyDiscount");
+    
+    auto result = v8_->Evaluate(
+        "JSON.stringify(applyDiscount({ id: 'A1', total: 100, items: [{ sku: 'x', quantity: 2 }] }))");
+    EXPECT_TRUE(result.success) << result.error;
+    EXPECT_EQ(result.result,
+              "{\"id\":\"A1\",\"total\":90,\"items\":[{\"sku\":\"x\",\"quantity\":2}],\"note\":\"discounted\"}");
+    
+    result = v8_->Evaluate("applyDiscount({ id: 'A2', items: [{ sku: 'y', quantity: 'two' }] })");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("Argument 1: items[0].quantity must be a number"), std::string::npos)
+        << result.error;
+    
+    result = v8_->Evaluate("applyDiscount({ id: 'A3', items: [{ sku: 'y' }, 7] })");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("Argument 1: items[1] must be an object"), std::string::npos) << result.error;
+    
+    result = v8_->Evaluate("applyDiscount(42)");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("Argument 1 must be an object"), std::string::npos) << result.error;
+    
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(v8_->GetContext());
+    
+    Order order{"B7", 12.5, {{"a", 1}, {"b", 3}}, std::nullopt};
+    v8::Local<v8::Value> object = binding::ToV8(isolate, order);
+    Order decoded;
+    ASSERT_TRUE(binding::FromV8(isolate, object, decoded));
+    EXPECT_EQ(decoded.id, "B7");
+    EXPECT_EQ(decoded.items.size(), 2u);
+    EXPECT_EQ(decoded.items[1].quantity, 3);
+    EXPECT_FALSE(decoded.note.has_value());
+}
+
+namespace {
+    double sumVector(std::vector<double> values) {
+        double total = 0;
+        for (double value : values) total += value;
+        return total;
+    }
+    
+    uint32_t countItems(std::vector<LineItem> items) {
+        return static_cast<uint32_t>(items.size());
+    }
+}
+
+// Test 35b: Arrays that grow while they are being read convert at their
+// original length
+TEST_F(V8IntegrationTest, ArraysGrowingDuringConversion) {
+    v8_->Bind<&sumVector>("sumVector");
+    v8_->Bind<&countItems>("countItems");
+    
+    auto result = v8_->Evaluate(
+        "const grown = [0, 2, 3];\n"
+        "Object.defineProperty(grown, 0, { get() { for (let i = 0; i < 1000; i++) grown.push(1); return 1; } });\n"
+        "sumVector(grown) + ':' + grown.length");
+    EXPECT_TRUE(result.success) << result.error;
+    EXPECT_EQ(result.result, "6:1003");
+    
+    result = v8_->Evaluate(
+        "const items = [{ sku: 'a' }, { sku: 'b' }];\n"
+        "Object.defineProperty(items, 1, { get() { for (let i = 0; i < 1000; i++) items.push({}); return {}; } });\n"
+        "countItems(items)");
+    EXPECT_TRUE(result.success) << result.error;
+    EXPECT_EQ(result.result, "2");
+}
+
+// Test 36: Interned names are created once per isolate and shared by both APIs
+TEST_F(V8IntegrationTest, InternedStrings) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Context::Scope context_scope(context);
+    
+    std::string name = "totalCount";
+    v8::Local<v8::String> first = binding::Intern(isolate, name);
+    EXPECT_TRUE(first->StrictEquals(binding::Intern(isolate, std::string_view(name))));
+    EXPECT_TRUE(first->StrictEquals(binding::Intern<"totalCount">(isolate)));
+    EXPECT_EQ(V8Integration::V8ToString(isolate, binding::Intern<"totalCount">(isolate)), "totalCount");
+    
+    // Names set through the builder are the same property JS reads back
+    JSObjectBuilder builder(isolate);
+    context->Global()->Set(context, binding::Intern<"stats">(isolate),
+                           builder.AddProperty(name, 3).AddProperty("label", std::string("x")).Build()).Check();
+    EXPECT_EQ(v8_->Evaluate("stats.totalCount + stats.label").result, "3x");
+}
+
+namespace {
+    struct InitCount {
+        int value = 0;
+    };
+}
+
+// Test 36b: Per-isolate caches follow the isolate's identity, not its address
+TEST_F(V8IntegrationTest, PerIsolateIgnoresReusedAddresses) {
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    
+    static int inits = 0;
+    auto init = [](v8::Isolate*, InitCount& count) { count.value = ++inits; };
+    EXPECT_EQ(binding::PerIsolate<InitCount>::Get(isolate, init).value, 1);
+    EXPECT_EQ(binding::PerIsolate<InitCount>::Get(isolate, init).value, 1);
+    
+    // An isolate allocated where a disposed one lived starts with an empty
+    // slot; it must get fresh entries even without ReleaseIsolate
+    isolate->SetData(V8_BINDING_ISOLATE_SLOT, nullptr);
+    EXPECT_EQ(binding::PerIsolate<InitCount>::Get(isolate, init).value, 2);
+    EXPECT_EQ(V8Integration::V8ToString(isolate, binding::Intern<"fresh">(isolate)), "fresh");
+}
+
+namespace {
+    void argCount(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        args.GetReturnValue().Set(args.Length());
+    }
+}
+
+#define TEST_MATH_FUNCTIONS(X) X(sumTo, sumTo) X(scale, scale) X(greet, greet)
+#define TEST_GLOBAL_FUNCTIONS(X) X(argCount, argCount)
+V8_MODULE(kTestMathModule, "testMath", "1.0.0", TEST_MATH_FUNCTIONS)
+V8_MODULE(kTestGlobals, nullptr, "1.0.0", TEST_GLOBAL_FUNCTIONS)
+
+// Test 37: Modules install namespace objects (or globals) on first use
+TEST_F(V8IntegrationTest, ModulesInstallLazily) {
+    static constexpr const binding::Module* kModules[] = {&kTestMathModule, &kTestGlobals};
+    static_assert(kTestMathModule.functions.size() == 3);
+    v8_->InstallModules(kModules);
+    
+    EXPECT_EQ(v8_->Evaluate("testMath.sumTo(100) + testMath.scale(1.5, 4)").result, "5056");
+    EXPECT_EQ(v8_->Evaluate("testMath === testMath && Object.keys(testMath).join()").result, "sumTo,scale,greet");
+    EXPECT_EQ(v8_->Evaluate("testMath.version = '2'; testMath.version").result, "1.0.0");
+    EXPECT_EQ(v8_->Evaluate("argCount(1, 2, 3)").result, "3");
+    
+    auto result = v8_->Evaluate("testMath.sumTo(-1)");
+    EXPECT_FALSE(result.success);
+    EXPECT_NE(result.error.find("must be non-negative"), std::string::npos);
+    
+    // Each context gets its own namespace object from the one cached template
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8_->GetContext();
+    v8::Local<v8::Context> other = v8::Context::New(isolate);
+    binding::InstallModules(isolate, other, kModules);
+    
+    v8::Local<v8::Value> mine = context->Global()->Get(context, binding::Intern<"testMath">(isolate)).ToLocalChecked();
+    v8::Local<v8::Value> theirs = other->Global()->Get(other, binding::Intern<"testMath">(isolate)).ToLocalChecked();
+    EXPECT_TRUE(theirs->IsObject());
+    EXPECT_FALSE(mine->StrictEquals(theirs));
+    EXPECT_TRUE(binding::ModuleTemplate(isolate, kTestMathModule) == binding::ModuleTemplate(isolate, kTestMathModule));
+}
+
+// Test 38: Installing dozens of modules into a fresh context takes microseconds
+TEST_F(V8IntegrationTest, ModuleInstallCost) {
+    constexpr size_t kModuleCount = 48;
+    constexpr int kContexts = 200;
+    // Static: the per-isolate caches are keyed by Module address, so these
+    // must outlive the isolate like V8_MODULE definitions do
+    static std::vector<std::string> names;
+    static std::vector<binding::Module> modules;
+    static std::vector<const binding::Module*> pointers;
+    if (modules.empty()) {
+        names.reserve(kModuleCount);
+        modules.reserve(kModuleCount);
+        for (size_t i = 0; i < kModuleCount; ++i) {
+            names.push_back("module" + std::to_string(i));
+            modules.push_back({names.back().c_str(), "1.0.0", kTestMathModuleFunctions});
+            pointers.push_back(&modules.back());
+        }
+    }
+    
+    v8::Isolate* isolate = v8_->GetIsolate();
+    v8::Isolate::Scope isolate_scope(isolate);
+    std::chrono::nanoseconds install{0};
+    std::chrono::nanoseconds firstUse{0};
+    for (int round = 0; round < kContexts; ++round) {
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        v8::Context::Scope context_scope(context);
+        
+        auto start = std::chrono::steady_clock::now();
+        binding::InstallModules(isolate, context, pointers);
+        auto installed = std::chrono::steady_clock::now();
+        v8::Local<v8::Value> value =
+            context->Global()->Get(context, binding::Intern(isolate, names.back())).ToLocalChecked();
+        firstUse += std::chrono::steady_clock::now() - installed;
+        install += installed - start;
+        ASSERT_TRUE(value->IsObject());
+        
+        if (round == 0) {
+            v8::Local<v8::Script> script = v8::Script::Compile(context,
+                V8Integration::ToV8String(isolate, "module47.sumTo(3) + module0.scale(2, 2)")).ToLocalChecked();
+            EXPECT_EQ(script->Run(context).ToLocalChecked()->NumberValue(context).FromJust(), 10);
+        }
+    }
+    
+    double installMicros = std::chrono::duration<double, std::micro>(install).count() / kContexts;
+    double firstUseMicros = std::chrono::duration<double, std::micro>(firstUse).count() / kContexts;
+    std::printf("Installing %zu modules: %.1f us per context; first use of one: %.1f us\n", kModuleCount,
+                installMicros, firstUseMicros);
+    EXPECT_LT(installMicros, 1000);
+}